@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "SpriteSheet.h"
 #include <algorithm>
 
 #ifdef min
@@ -28,11 +29,9 @@ private:
 	float elapsedTime_ = 0.0f;		// 現在フレームの経過時間
 	bool isLooping_ = true;
 
-	// 描画用ソース矩形（計算結果）
-	int srcX_ = 0;
-	int srcY_ = 0;
-	int srcW_ = 0;
-	int srcH_ = 0;
+	// フレーム矩形表（同じ画像・分割の Animation やパーティクルと共有）
+	const SpriteSheet* sheet_ = nullptr;
+	const SpriteFrameRect* frame_ = nullptr;  // 現在フレームの矩形（sheet_ の中を指す）
 
 public:
 	// コンストラクタ
@@ -47,6 +46,7 @@ public:
 		, isLooping_(isLoop) {
 
 		isPlaying_ = true;
+		ResolveSheet();
 		// 初期フレーム設定
 		UpdateSourceRect();
 	}
@@ -64,7 +64,9 @@ public:
 		, isLooping_(other.isLooping_)
 		, currentFrame_(other.currentFrame_)
 		, isPlaying_(other.isPlaying_)
+		, sheet_(other.sheet_)
 	{
+		UpdateSourceRect();
 	}
 
 	// アニメーション制御
@@ -116,17 +118,9 @@ public:
 		}
 	}
 
-	// ソース矩形計算
+	// ソース矩形の更新（計算済みの表から現在フレームの矩形を引くだけ）
 	void UpdateSourceRect() {
-		// 現在フレームの行と列を計算
-		int row = currentFrame_ / framesPerRow_;
-		int col = currentFrame_ % framesPerRow_;
-
-		// ソース矩形を設定
-		srcX_ = col * frameWidth_;
-		srcY_ = row * frameHeight_;
-		srcW_ = frameWidth_;
-		srcH_ = frameHeight_;
+		frame_ = &sheet_->GetFrame(currentFrame_);
 	}
 
 	// 特定フレームに移動
@@ -140,10 +134,12 @@ public:
 
 	// Getter
 	int GetGraphHandle() const { return grHandle_; }
-	int GetSrcX() const { return srcX_; }
-	int GetSrcY() const { return srcY_; }
-	int GetSrcW() const { return srcW_; }
-	int GetSrcH() const { return srcH_; }
+	int GetSrcX() const { return frame_->x; }
+	int GetSrcY() const { return frame_->y; }
+	int GetSrcW() const { return frame_->w; }
+	int GetSrcH() const { return frame_->h; }
+	const SpriteFrameRect& GetFrameRect() const { return *frame_; }
+	const SpriteSheet* GetSpriteSheet() const { return sheet_; }
 	int GetCurrentFrame() const { return currentFrame_; }
 	int GetTotalFrames() const { return totalFrames_; }
 	int GetFrameWidth() const { return frameWidth_; }
@@ -165,10 +161,14 @@ public:
 	void SetTotalFrames(int total) {
 		if (total > 0) {
 			totalFrames_ = total;
+			if (totalFrames_ > sheet_->GetFrameCount()) {
+				// 行が足りなくなったらシートを引き直す
+				ResolveSheet();
+			}
 			if (currentFrame_ >= totalFrames_) {
 				currentFrame_ = totalFrames_ - 1;
-				UpdateSourceRect();
 			}
+			UpdateSourceRect();
 		}
 	}
 
@@ -176,4 +176,11 @@ public:
 	void PrintDebugInfo() const {
 		// デバッグ出力（必要に応じて実装）
 	}
+
+private:
+	// 1行 framesPerRow_ 個、総フレーム数が収まる行数のシートを取得
+	void ResolveSheet() {
+		const int rows = (totalFrames_ + framesPerRow_ - 1) / framesPerRow_;
+		sheet_ = SpriteSheet::GetWithFrameSize(grHandle_, frameWidth_, frameHeight_, framesPerRow_, rows);
+	}
 };
\ No newline at end of file
@@ -1,6 +1,5 @@
 ﻿#include "Camera2D.h"
 #include "Affine2D.h"
-#include <random>
 #include <algorithm>
 #include <cmath>
 #include <Novice.h>
@@ -145,12 +144,8 @@ void Camera2D::UpdateShakeEffect(float deltaTime) {
 	if (!shakeEffect_.isActive) return;
 
 	// ランダムなオフセットを生成
-	static std::random_device rd;
-	static std::mt19937 gen(rd());
-	std::uniform_real_distribution<float> dist(-shakeEffect_.intensity, shakeEffect_.intensity);
-
-	shakeEffect_.offset.x = dist(gen);
-	shakeEffect_.offset.y = dist(gen);
+	shakeEffect_.offset.x = shakeRandom_.RandomFloat(-shakeEffect_.intensity, shakeEffect_.intensity);
+	shakeEffect_.offset.y = shakeRandom_.RandomFloat(-shakeEffect_.intensity, shakeEffect_.intensity);
 
 	// 時間制限のあるシェイクの場合
 	if (!shakeEffect_.continuous) {
@@ -241,6 +236,27 @@ void Camera2D::ApplyBounds() {
 
 // ========== 行列計算 ==========
 // ========== 行列計算 ==========
+void Camera2D::GetViewRect(Vector2& outMin, Vector2& outMax) const {
+	Vector2 center = position_;
+	if (shakeEffect_.isActive) {
+		center.x += shakeEffect_.offset.x;
+		center.y += shakeEffect_.offset.y;
+	}
+
+	// カメラのアフィン変換はズーム倍なので、映る範囲は size * zoom
+	float halfWidth = size_.x * 0.5f * zoom_;
+	float halfHeight = size_.y * 0.5f * zoom_;
+
+	// 回転しているときは外接矩形に広げる
+	float c = std::fabs(std::cos(rotation_));
+	float s = std::fabs(std::sin(rotation_));
+	float extentX = halfWidth * c + halfHeight * s;
+	float extentY = halfWidth * s + halfHeight * c;
+
+	outMin = { center.x - extentX, center.y - extentY };
+	outMax = { center.x + extentX, center.y + extentY };
+}
+
 void Camera2D::UpdateMatrices() {
 	// シェイクオフセットを適用した位置
 	Vector2 finalPosition = position_;
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "Vector2.h"
+#include "FastRandom.h"
 #include "Matrix3x3.h"
 #include "WindowSize.h"
 #include <functional>
@@ -60,6 +61,10 @@ public:
 	// === 行列取得 ===
 	Matrix3x3 GetVpVpMatrix() const;
 
+	// === 描画範囲取得 ===
+	// 画面に映るワールド座標の範囲（シェイク・回転込みの外接矩形）
+	void GetViewRect(Vector2& outMin, Vector2& outMax) const;
+
 	// === Y軸反転取得 ===
 	bool IsInvertY() const { return invertY_; }
 
@@ -123,6 +128,7 @@ private:
 	MoveEffect moveEffect_;
 	ZoomEffect zoomEffect_;
 	ShakeEffect shakeEffect_;
+	FastRandom shakeRandom_{ FastRandom::MakeUniqueSeed() };  // インスタンスごと・起動ごとに違う揺れにする
 	FollowSettings follow_;
 	Bounds bounds_;
 
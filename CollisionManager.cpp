@@ -1,4 +1,5 @@
 ﻿#include "CollisionManager.h"
+#include "ParticleCollisionWorld.h"
 #include <Novice.h>
 #include <cmath>
 
@@ -273,6 +274,34 @@ bool CollisionManager::ShouldCheckCollision(CollisionLayer layerA, CollisionLaye
 	return false;
 }
 
+// ========================================
+// パーティクル用の地形
+// ========================================
+
+void CollisionManager::ExportStaticColliders(ParticleCollisionWorld& world, CollisionLayer layer) const {
+	for (const auto& collider : colliders_) {
+		if (!collider->isActive || collider->layer != layer) continue;
+
+		switch (collider->shape) {
+		case CollisionShape::Circle:
+			world.AddCircle(collider->position, collider->circle.radius);
+			break;
+		case CollisionShape::Rectangle:
+			world.AddRect(collider->position, collider->rect.width, collider->rect.height, collider->rect.angle);
+			break;
+		case CollisionShape::Line: {
+			const Vector2& start = collider->line.start;
+			const Vector2& end = collider->line.end;
+			const float dx = end.x - start.x;
+			const float dy = end.y - start.y;
+			const Vector2 center = { (start.x + end.x) * 0.5f, (start.y + end.y) * 0.5f };
+			world.AddRect(center, std::sqrt(dx * dx + dy * dy), collider->line.thickness, std::atan2(dy, dx));
+			break;
+		}
+		}
+	}
+}
+
 // ========================================
 // デバッグ描画
 // ========================================
@@ -7,6 +7,8 @@
 #include <memory>
 #include <functional>
 
+class ParticleCollisionWorld;
+
 // ========================================
 // 衝突判定の種類
 // ========================================
@@ -158,6 +160,19 @@ public:
 		onPlayerTouchBoss_ = callback;
 	}
 
+	// ========================================
+	// パーティクル用の地形
+	// ========================================
+
+	/// <summary>
+	/// 指定レイヤーの有効なコライダーを、パーティクルが当たる地形として world に追加する
+	/// （円 → 円、矩形 → 回転矩形、ライン → 太さを幅にした回転矩形）
+	/// 地形は動かない前提なので、ステージの読み込み後に1回呼ぶ。
+	/// CollisionManager は今のプロジェクト（vcxproj）に入っておらず、まだどこからも呼ばれない。
+	/// 今のゲームで粒に地形を渡せるのは ParticleCollisionWorld の SetTileMap / AddCircle / AddRect を直接呼ぶ経路だけ
+	/// </summary>
+	void ExportStaticColliders(ParticleCollisionWorld& world, CollisionLayer layer = CollisionLayer::Neutral) const;
+
 	// ========================================
 	// デバッグ描画
 	// ========================================
@@ -345,9 +345,7 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 			ImGui::Text("Rain:");
 			ImGui::SameLine(150);
 
-			bool rainActive = particleManager->continuousEmitters_.find(ParticleType::Rain) !=
-				particleManager->continuousEmitters_.end() &&
-				particleManager->continuousEmitters_[ParticleType::Rain].isActive;
+			bool rainActive = particleManager->IsContinuousEmitActive(ParticleType::Rain);
 
 			if (ImGui::Button(rainActive ? "Stop##Rain" : "Start##Rain", ImVec2(80, 0))) {
 				if (rainActive) {
@@ -365,9 +363,8 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 				ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "ACTIVE");
 
 				// ★デバッグ情報：エミッター状態
-				auto& emitter = particleManager->continuousEmitters_[ParticleType::Rain];
 				ImGui::SameLine();
-				ImGui::Text("Timer: %.2f", emitter.timer);
+				ImGui::Text("Timer: %.2f", particleManager->emitters_.GetTimer(particleManager->typeEmitters_[ParticleType::Rain]));
 			}
 			else {
 				ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "INACTIVE");
@@ -379,9 +376,7 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 			ImGui::Text("Snow:");
 			ImGui::SameLine(150);
 
-			bool snowActive = particleManager->continuousEmitters_.find(ParticleType::Snow) !=
-				particleManager->continuousEmitters_.end() &&
-				particleManager->continuousEmitters_[ParticleType::Snow].isActive;
+			bool snowActive = particleManager->IsContinuousEmitActive(ParticleType::Snow);
 
 			if (ImGui::Button(snowActive ? "Stop##Snow" : "Start##Snow", ImVec2(80, 0))) {
 				if (snowActive) {
@@ -399,9 +394,8 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 				ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "ACTIVE");
 
 				// ★デバッグ情報：エミッター状態
-				auto& emitter = particleManager->continuousEmitters_[ParticleType::Snow];
 				ImGui::SameLine();
-				ImGui::Text("Timer: %.2f", emitter.timer);
+				ImGui::Text("Timer: %.2f", particleManager->emitters_.GetTimer(particleManager->typeEmitters_[ParticleType::Snow]));
 			}
 			else {
 				ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "INACTIVE");
@@ -413,9 +407,7 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 			ImGui::Text("Orb:");
 			ImGui::SameLine(150);
 
-			bool orbActive = particleManager->continuousEmitters_.find(ParticleType::Orb) !=
-				particleManager->continuousEmitters_.end() &&
-				particleManager->continuousEmitters_[ParticleType::Orb].isActive;
+			bool orbActive = particleManager->IsContinuousEmitActive(ParticleType::Orb);
 
 			if (ImGui::Button(orbActive ? "Stop##Orb" : "Start##Orb", ImVec2(80, 0))) {
 				if (orbActive) {
@@ -433,9 +425,8 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 				ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "ACTIVE");
 
 				// ★デバッグ情報：エミッター状態
-				auto& emitter = particleManager->continuousEmitters_[ParticleType::Orb];
 				ImGui::SameLine();
-				ImGui::Text("Timer: %.2f", emitter.timer);
+				ImGui::Text("Timer: %.2f", particleManager->emitters_.GetTimer(particleManager->typeEmitters_[ParticleType::Orb]));
 			}
 			else {
 				ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "INACTIVE");
@@ -461,23 +452,22 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 	// ★追加：エミッターデバッグ情報
 	// ========================================
 	if (ImGui::CollapsingHeader("Emitter Status")) {
-		ImGui::Text("Active Emitters: %zu", particleManager->continuousEmitters_.size());
-
-		for (const auto& [type, emitter] : particleManager->continuousEmitters_) {
-			if (emitter.isActive) {
-				const char* typeName = "Unknown";
-				switch (type) {
-				case ParticleType::Rain: typeName = "Rain"; break;
-				case ParticleType::Snow: typeName = "Snow"; break;
-				case ParticleType::Orb: typeName = "Orb"; break;
-				default: break;
-				}
-
-				ImGui::BulletText("%s: Timer=%.2f, FollowTarget=%s",
-					typeName,
-					emitter.timer,
-					emitter.followTarget ? "SET" : "NULL");
-			}
+		const ParticleEmitterPool& emitters = particleManager->emitters_;
+		ImGui::Text("Active Emitters: %d", emitters.GetCount());
+
+		// 数千個になりうるので先頭の一部だけ表示
+		const int kMaxListed = 32;
+		for (int i = 0; i < emitters.GetCount() && i < kMaxListed; ++i) {
+			const ParticleEmitterPool::Emitter& emitter = emitters.At(i);
+			const EmitterHandle handle = emitters.HandleAt(i);
+			ImGui::BulletText("#%u.%u %s: Timer=%.2f, FollowTarget=%s",
+				handle.index, handle.generation,
+				ParticleManager::ParticleTypeToString(emitter.type),
+				emitters.TimerAt(i),
+				emitter.followTarget ? "SET" : "NULL");
+		}
+		if (emitters.GetCount() > kMaxListed) {
+			ImGui::Text("... and %d more", emitters.GetCount() - kMaxListed);
 		}
 	}
 
@@ -488,20 +478,116 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 	// ========================================
 	if (ImGui::CollapsingHeader("Active Particles", ImGuiTreeNodeFlags_DefaultOpen)) {
 		// パーティクルタイプごとにカウント
-		std::map<ParticleType, int> particleCounts;
+		ParticleTypeTable<int> particleCounts;
 		int totalActive = 0;
 
-		for (const auto& p : particleManager->particles_) {
-			if (p.IsAlive()) {
-				particleCounts[p.GetType()]++;
-				totalActive++;
-			}
+		const ParticleStorage& storage = particleManager->particles_;
+		for (int i = 0; i < storage.GetCount(); ++i) {
+			particleCounts[storage.type[i]]++;
+			totalActive++;
 		}
 
 		ImGui::Text("Total Active: %d / %d", totalActive, particleManager->kMaxParticles);
 		ImGui::ProgressBar(static_cast<float>(totalActive) / particleManager->kMaxParticles,
 			ImVec2(-1, 0), "");
 
+		// プールの統計と満杯時の方針
+		const ParticlePoolStats& stats = particleManager->GetPoolStats();
+		ImGui::Text("Peak: %d  Evicted: %u  Dropped: %u", stats.peakCount, stats.evicted, stats.dropped);
+		ImGui::Text("Trails: %d  Trail Quads: %d", particleManager->GetActiveTrailCount(), particleManager->GetLastTrailQuadCount());
+
+		const char* policyNames[] = { "Drop New", "Evict Oldest", "Evict Lowest Priority" };
+		int policy = static_cast<int>(particleManager->GetPoolPolicy());
+		if (ImGui::Combo("Full Pool Policy", &policy, policyNames, IM_ARRAYSIZE(policyNames))) {
+			particleManager->SetPoolPolicy(static_cast<ParticlePoolPolicy>(policy));
+		}
+		if (ImGui::Button("Reset Pool Stats")) {
+			particleManager->ResetPoolStats();
+		}
+
+		// カメラ範囲カリング（直前の Draw の結果）
+		bool culling = particleManager->IsCullingEnabled();
+		if (ImGui::Checkbox("Camera Culling", &culling)) {
+			particleManager->SetCullingEnabled(culling);
+		}
+		ImGui::Text("Drawn: %d  Culled: %d (type bounds: %d)",
+			particleManager->GetDrawnParticleCount(), particleManager->GetCulledParticleCount(),
+			particleManager->drawList_.GetTypeRejectedCount());
+
+		// 更新に使うワーカースレッド数（0 ならメインスレッドのみ）
+		int workerThreads = particleManager->GetWorkerThreadCount();
+		if (ImGui::SliderInt("Worker Threads", &workerThreads, 0, JobSystem::GetHardwareThreadCount() - 1)) {
+			particleManager->SetWorkerThreadCount(workerThreads);
+		}
+
+		// 固定ステップ（Hz）と、1フレームに進める最大ステップ数
+		int stepHz = static_cast<int>(1.0f / particleManager->GetFixedStep() + 0.5f);
+		if (ImGui::SliderInt("Fixed Step (Hz)", &stepHz, 30, 240)) {
+			particleManager->SetFixedStep(1.0f / static_cast<float>(stepHz));
+		}
+		int maxSubSteps = particleManager->GetMaxSubSteps();
+		if (ImGui::SliderInt("Max Sub Steps", &maxSubSteps, 1, 16)) {
+			particleManager->SetMaxSubSteps(maxSubSteps);
+		}
+		ImGui::Text("Sub Steps: %d  Skipped: %u",
+			particleManager->GetLastSubStepCount(), particleManager->GetSkippedStepCount());
+
+		// 負荷に応じた発生量の調整
+		ParticleBudgetGovernor& governor = particleManager->GetBudgetGovernor();
+		ParticleBudgetGovernor::Settings& budget = governor.GetSettings();
+		ImGui::Checkbox("Budget Governor", &budget.enabled);
+		ImGui::SameLine();
+		if (ImGui::Button("Reset##Governor")) {
+			governor.Reset();
+		}
+		const char* budgetSourceNames[] = { "Particle Update + Draw", "Frame Time" };
+		int budgetSource = static_cast<int>(budget.source);
+		if (ImGui::Combo("Budget Source", &budgetSource, budgetSourceNames, IM_ARRAYSIZE(budgetSourceNames))) {
+			budget.source = static_cast<ParticleBudgetSource>(budgetSource);
+		}
+		if (budget.source == ParticleBudgetSource::FrameTime) {
+			ImGui::SliderFloat("Frame Budget (ms)", &budget.frameBudgetMs, 4.0f, 50.0f, "%.1f");
+		}
+		else {
+			ImGui::SliderFloat("Particle Budget (ms)", &budget.particleBudgetMs, 0.1f, 10.0f, "%.2f");
+		}
+		ImGui::SliderFloat("Min Scale", &budget.minScale, 0.0f, 1.0f, "%.2f");
+		ImGui::SliderInt("Governed Priority <=", &budget.maxGovernedPriority, 0, ParticleBudgetGovernor::kExemptPriority - 1);
+		ImGui::Text("Update %.3f ms  Draw %.3f ms  Smoothed %.3f / %.2f ms",
+			particleManager->GetLastUpdateMs(), particleManager->GetLastDrawMs(),
+			governor.GetSmoothedMs(), governor.GetBudgetMs());
+		ImGui::TextColored(governor.IsThrottling() ? ImVec4(1.0f, 0.6f, 0.0f, 1.0f) : ImVec4(0.0f, 1.0f, 0.0f, 1.0f),
+			"Scale %.2f %s  Over Budget: %u frames", governor.GetScale(),
+			governor.IsThrottling() ? "(throttling)" : "", governor.GetOverBudgetFrames());
+
+		// 粒が当たる地形
+		const ParticleCollisionWorld& world = particleManager->GetCollisionWorld();
+		ImGui::Text("World: %d shapes, grid %d x %d (%.0f px)%s",
+			world.GetShapeCount(), world.GetGridWidth(), world.GetGridHeight(), world.GetCellSize(),
+			world.HasTileMap() ? " + tile map" : "");
+
+		// 風の流れ場（雨・雪・オーブ・煙）
+		const ParticleFlowField& flowField = particleManager->GetFlowField();
+		ImGui::Text("Flow Field: %d x %d cells (%.0f px)",
+			flowField.GetWidth(), flowField.GetHeight(), flowField.GetCellSize());
+		Vector2 flowScroll = particleManager->GetFlowScrollSpeed();
+		if (ImGui::DragFloat2("Flow Scroll", &flowScroll.x, 1.0f, -500.0f, 500.0f)) {
+			particleManager->SetFlowScrollSpeed(flowScroll);
+		}
+		static int flowSeed = 0;
+		ImGui::InputInt("Flow Seed", &flowSeed);
+		ImGui::SameLine();
+		if (ImGui::Button("Rebuild Curl Noise")) {
+			particleManager->BuildCurlNoiseFlowField(static_cast<uint64_t>(flowSeed));
+		}
+		if (ImGui::Button("Load flow_field.json")) {
+			particleManager->LoadFlowFieldFromJson("Resources/Data/flow_field.json");
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Save flow_field.json")) {
+			flowField.SaveToFile("Resources/Data/flow_field.json");
+		}
+
 		ImGui::Separator();
 
 		// タイプ別の詳細
@@ -512,8 +598,9 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 			"Rain", "Snow", "Orb", "Charge",
 			"Glow", "Shockwave", "Sparkle", "Slash", "SmokeCloud"
 		};
+		static_assert(IM_ARRAYSIZE(typeNames) == kParticleTypeCount, "typeNames must list every ParticleType");
 
-		for (int i = 0; i < 14; ++i) {
+		for (int i = 0; i < kParticleTypeCount; ++i) {
 			ParticleType type = static_cast<ParticleType>(i);
 			int count = particleCounts[type];
 
@@ -544,7 +631,7 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 			"Glow", "Shockwave", "Sparkle", "Slash", "SmokeCloud"
 		};
 
-		ImGui::Combo("Particle Type", &selectedType, typeNames, 14);
+		ImGui::Combo("Particle Type", &selectedType, typeNames, IM_ARRAYSIZE(typeNames));
 
 		ParticleType type = static_cast<ParticleType>(selectedType);
 		ParticleParam* param = particleManager->GetParam(type);
@@ -556,9 +643,10 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 			// 基本設定
 			// ========================================
 			if (ImGui::TreeNode("Basic Settings")) {
+				ImGui::Text("Texture: %s (%d)", param->texturePath.c_str(), param->textureHandle);
 				ImGui::SliderInt("Count", &param->count, 1, 100);
-				ImGui::SliderInt("Life Min", &param->lifeMin, 1, 600);
-				ImGui::SliderInt("Life Max", &param->lifeMax, 1, 600);
+				ImGui::SliderFloat("Life Min (sec)", &param->lifeMin, 0.02f, 10.0f);
+				ImGui::SliderFloat("Life Max (sec)", &param->lifeMax, 0.02f, 10.0f);
 				if (param->lifeMin > param->lifeMax) {
 					param->lifeMax = param->lifeMin;
 				}
@@ -574,8 +662,11 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 				if (param->sizeMin > param->sizeMax) {
 					param->sizeMax = param->sizeMin;
 				}
-				ImGui::SliderFloat("Scale Start", &param->scaleStart, 0.0f, 5.0f);
-				ImGui::SliderFloat("Scale End", &param->scaleEnd, 0.0f, 5.0f);
+				bool scaleChanged = ImGui::SliderFloat("Scale Start", &param->scaleStart, 0.0f, 5.0f);
+				scaleChanged |= ImGui::SliderFloat("Scale End", &param->scaleEnd, 0.0f, 5.0f);
+				if (scaleChanged) {
+					particleManager->BakeLifetimeCurves(type);
+				}
 				ImGui::TreePop();
 			}
 
@@ -657,6 +748,7 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 						(static_cast<unsigned int>(startColor[1] * 255.0f) << 16) |
 						(static_cast<unsigned int>(startColor[2] * 255.0f) << 8) |
 						static_cast<unsigned int>(startColor[3] * 255.0f);
+					particleManager->BakeLifetimeCurves(type);
 				}
 
 				// Color End
@@ -674,6 +766,7 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 						(static_cast<unsigned int>(endColor[1] * 255.0f) << 16) |
 						(static_cast<unsigned int>(endColor[2] * 255.0f) << 8) |
 						static_cast<unsigned int>(endColor[3] * 255.0f);
+					particleManager->BakeLifetimeCurves(type);
 				}
 
 				ImGui::TreePop();
@@ -708,6 +801,40 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 					ImGui::EndTooltip();
 				}
 
+				ImGui::SliderInt("Pool Priority", &param->priority, 0, 3);
+
+				ImGui::Checkbox("Coarse Type Bounds", &param->useCoarseBounds);
+				if (param->useCoarseBounds) {
+					ImGui::SliderFloat("Bounds Margin", &param->coarseBoundsMargin, 0.0f, 512.0f);
+				}
+				ImGui::SameLine();
+				ImGui::TextDisabled("(?)");
+				if (ImGui::IsItemHovered()) {
+					ImGui::SetTooltip("Skip every particle of this type when their combined bounds are off screen");
+				}
+
+				// 地形（円・矩形・タイルマップ）との当たり判定
+				ImGui::Checkbox("Collide With World", &param->collideWithWorld);
+				if (param->collideWithWorld) {
+					ImGui::Indent();
+					ImGui::Checkbox("Kill On World Hit", &param->killOnWorldHit);
+					if (!param->killOnWorldHit) {
+						ImGui::SliderFloat("Bounce Damping##World", &param->bounceDamping, 0.0f, 1.0f);
+					}
+					ImGui::Unindent();
+				}
+
+				// 地面・地形に当たった位置から別の種類を発生させる（雨のしぶきなど）
+				if (GetParticleTypeTraits(type).ground != GroundResponse::None || param->collideWithWorld) {
+					ImGui::Checkbox("Emit On Ground Hit", &param->useGroundHitEmit);
+					if (param->useGroundHitEmit) {
+						int hitType = static_cast<int>(param->groundHitEmitType);
+						if (ImGui::Combo("Ground Hit Type", &hitType, typeNames, IM_ARRAYSIZE(typeNames))) {
+							param->groundHitEmitType = static_cast<ParticleType>(hitType);
+						}
+					}
+				}
+
 				ImGui::TreePop();
 			}
 
@@ -745,9 +872,9 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 			}
 
 			// ========================================
-			// Homing（追従）設定
+			// Homing（追従）設定（Homing の性質を持つ種類だけ。それ以外は useHoming が効かない）
 			// ========================================
-			if (ImGui::TreeNode("Homing Settings")) {
+			if (GetParticleTypeTraits(type).homing && ImGui::TreeNode("Homing Settings")) {
 				ImGui::Checkbox("Use Homing", &param->useHoming);
 
 				if (param->useHoming) {
@@ -762,7 +889,8 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 			// ========================================
 			// 環境パーティクル専用設定
 			// ========================================
-			if (type == ParticleType::Rain || type == ParticleType::Snow || type == ParticleType::Orb) {
+			// （雨・雪・オーブ・煙。いずれも流れ場の風を受ける種類）
+			if (GetParticleTypeTraits(type).wind) {
 				if (ImGui::TreeNode("Environment Specific Settings")) {
 					if (type == ParticleType::Rain) {
 						ImGui::SliderFloat("Bounce Damping", &param->bounceDamping, 0.0f, 1.0f);
@@ -773,12 +901,12 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 						}
 					}
 
-					if (type == ParticleType::Snow) {
+					if (GetParticleTypeTraits(type).wind) {
 						ImGui::SliderFloat("Wind Strength", &param->windStrength, 0.0f, 100.0f);
 						ImGui::SameLine();
 						ImGui::TextDisabled("(?)");
 						if (ImGui::IsItemHovered()) {
-							ImGui::SetTooltip("Horizontal wind swaying effect");
+							ImGui::SetTooltip("Drift speed along the flow field (world units/sec at the strongest point)");
 						}
 					}
 
@@ -829,6 +957,14 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 				// 再度現在のパラメータを取得
 				param = particleManager->GetParam(type);
 			}
+
+			// JSON を外から書き換えたら、粒を消さずに設定だけ読み直す
+			bool hotReload = particleManager->IsHotReloadEnabled();
+			if (ImGui::Checkbox("Hot Reload JSON", &hotReload)) {
+				particleManager->SetHotReloadEnabled(hotReload);
+			}
+			ImGui::SameLine();
+			ImGui::Text("(reloaded %d times)", particleManager->GetHotReloadCount());
 		}
 	}
 
@@ -855,6 +991,210 @@ void DebugWindow::DrawParticleDebugWindow(ParticleManager* particleManager, Play
 		}
 	}
 
+	// ========================================
+	// ベンチマーク
+	// ========================================
+	if (ImGui::CollapsingHeader("Benchmark")) {
+		if (ImGui::Button("Run Update Benchmark (2k/16k/64k)", ImVec2(250, 0))) {
+			particleBenchResults_ = ParticleBenchmark::RunUpdateBenchmark();
+			ParticleBenchmark::PrintResults(particleBenchResults_);
+		}
+
+		for (const auto& r : particleBenchResults_) {
+			ImGui::Text("%6d: AoS %.3f  Scalar %.3f  SSE %.3f  AVX2 %.3f ms",
+				r.particleCount, r.aosMs, r.scalarMs, r.sseMs, r.avxMs);
+			ImGui::SameLine();
+			ImGui::TextColored(r.matchesReference ? ImVec4(0, 1, 0, 1) : ImVec4(1, 0, 0, 1),
+				r.matchesReference ? "[match]" : "[MISMATCH]");
+		}
+
+		ImGui::Separator();
+
+		if (ImGui::Button("Run Draw Prep Benchmark", ImVec2(250, 0))) {
+			// 読み込み済みのパーティクル用テクスチャを使う
+			std::vector<int> textureHandles;
+			for (const auto& param : particleManager->params_) {
+				if (param.textureHandle >= 0) {
+					textureHandles.push_back(param.textureHandle);
+				}
+			}
+			particleDrawBenchResults_ = ParticleBenchmark::RunDrawPrepBenchmark(textureHandles);
+			ParticleBenchmark::PrintDrawResults(particleDrawBenchResults_);
+		}
+
+		for (const auto& r : particleDrawBenchResults_) {
+			ImGui::Text("%6d: Legacy %.3f  Binned %.3f ms  (%d bins)",
+				r.particleCount, r.legacyMs, r.binnedMs, r.binCount);
+		}
+
+		ImGui::Separator();
+
+		if (ImGui::Button("Run Thread Scaling Benchmark (64k)", ImVec2(250, 0))) {
+			particleThreadBenchResults_ = ParticleBenchmark::RunThreadScalingBenchmark();
+			ParticleBenchmark::PrintThreadResults(particleThreadBenchResults_);
+		}
+
+		for (const auto& r : particleThreadBenchResults_) {
+			ImGui::Text("%2d threads: %.3f ms  x%.2f", r.workerCount + 1, r.stepMs, r.speedup);
+			ImGui::SameLine();
+			ImGui::TextColored(r.matchesSerial ? ImVec4(0, 1, 0, 1) : ImVec4(1, 0, 0, 1),
+				r.matchesSerial ? "[match]" : "[MISMATCH]");
+		}
+
+		ImGui::Separator();
+
+		// 計測中は粒が消える
+		if (ImGui::Button("Run Emit Batch Benchmark (Explosion)", ImVec2(250, 0))) {
+			particleEmitBenchResults_ = ParticleBenchmark::RunEmitBenchmark(*particleManager, ParticleType::Explosion);
+			ParticleBenchmark::PrintEmitResults(particleEmitBenchResults_);
+		}
+
+		for (const auto& r : particleEmitBenchResults_) {
+			ImGui::Text("%5d pts: PerCall %.4f  Batch %.4f  Queued %.4f ms",
+				r.pointCount, r.perCallMs, r.batchMs, r.queuedMs);
+			ImGui::SameLine();
+			ImGui::TextColored(r.matchesPerCall ? ImVec4(0, 1, 0, 1) : ImVec4(1, 0, 0, 1),
+				r.matchesPerCall ? "[match]" : "[MISMATCH]");
+		}
+
+		ImGui::Separator();
+
+		if (ImGui::Button("Run Wind Benchmark (10k Snow)", ImVec2(250, 0))) {
+			particleWindBenchResult_ = ParticleBenchmark::RunWindBenchmark();
+			ParticleBenchmark::PrintWindResult(particleWindBenchResult_);
+		}
+
+		if (particleWindBenchResult_.particleCount > 0) {
+			ImGui::Text("Build %.3f ms  Sine %.4f  FlowField %.4f ms/step",
+				particleWindBenchResult_.buildMs, particleWindBenchResult_.legacySineMs,
+				particleWindBenchResult_.flowFieldMs);
+		}
+
+		ImGui::Separator();
+
+		if (ImGui::Button("Run World Collision Benchmark (16k)", ImVec2(250, 0))) {
+			particleWorldBenchResults_ = ParticleBenchmark::RunWorldCollisionBenchmark();
+			ParticleBenchmark::PrintWorldResults(particleWorldBenchResults_);
+		}
+
+		for (const auto& r : particleWorldBenchResults_) {
+			ImGui::Text("%5d colliders: Grid %.4f  Brute %.4f ms", r.colliderCount, r.gridMs, r.bruteMs);
+			ImGui::SameLine();
+			ImGui::TextColored(r.matchesBrute ? ImVec4(0, 1, 0, 1) : ImVec4(1, 0, 0, 1),
+				r.matchesBrute ? "[match]" : "[MISMATCH]");
+		}
+
+		ImGui::Separator();
+
+		if (ImGui::Button("Run Trail Benchmark", ImVec2(250, 0))) {
+			particleTrailBenchResults_ = ParticleBenchmark::RunTrailBenchmark();
+			ParticleBenchmark::PrintTrailResults(particleTrailBenchResults_);
+		}
+
+		for (const auto& r : particleTrailBenchResults_) {
+			ImGui::Text("%s: Particles %.1f (peak %d) -> Ribbon %.1f (peak %d) quads/trail",
+				r.name.c_str(), r.particleQuads, r.particlePeakQuads, r.ribbonQuads, r.ribbonPeakQuads);
+		}
+
+		ImGui::Separator();
+
+		// プレイ中の操作を記録して、再生ベンチマーク用のファイルに書き出す
+		if (!particleManager->IsRecording()) {
+			if (ImGui::Button("Start Particle Recording", ImVec2(250, 0))) {
+				particleManager->StartRecording();
+			}
+		}
+		else {
+			if (ImGui::Button("Stop Recording & Save", ImVec2(250, 0))) {
+				particleManager->StopRecording();
+				particleManager->SaveRecording(kParticleRecordingPath);
+			}
+			ImGui::SameLine();
+			ImGui::Text("%u frames  %d events", particleManager->GetRecordedLog().header.frameCount,
+				static_cast<int>(particleManager->GetRecordedLog().events.size()));
+		}
+
+		// 計測中は粒が消える
+		if (ImGui::Button("Run Replay Benchmark", ImVec2(250, 0))) {
+			particleReplayBenchResults_ = ParticleBenchmark::RunReplayBenchmark(*particleManager);
+			ParticleBenchmark::PrintReplayResults(particleReplayBenchResults_);
+		}
+
+		for (const auto& r : particleReplayBenchResults_) {
+			ImGui::Text("%s: Update %.3f / %.3f  DrawPrep %.3f / %.3f ms  Peak %d  Evicted %u",
+				r.name.c_str(), r.updateP50Ms, r.updateP99Ms, r.drawPrepP50Ms, r.drawPrepP99Ms, r.peakLive, r.evicted);
+			ImGui::SameLine();
+			ImGui::TextColored(r.reproducible ? ImVec4(0, 1, 0, 1) : ImVec4(1, 0, 0, 1),
+				r.reproducible ? "[match]" : "[MISMATCH]");
+		}
+	}
+
+	// ========================================
+	// スクラップのベンチマーク（ゲーム中のスクラップには触らない）
+	// ========================================
+	if (ImGui::CollapsingHeader("Scrap Benchmark")) {
+		if (ImGui::Button("Run Spawn Burst Benchmark", ImVec2(250, 0))) {
+			scrapSpawnBenchResults_ = ScrapBenchmark::RunSpawnBurstBenchmark();
+			ScrapBenchmark::PrintSpawnBurstResults(scrapSpawnBenchResults_);
+		}
+
+		for (const auto& r : scrapSpawnBenchResults_) {
+			ImGui::Text("%4d: Legacy %.3f / Flyweight %.3f us  %d -> %d bytes  LoadTexture %d -> %d",
+				r.burstCount, r.legacyUsPerSpawn, r.flyweightUsPerSpawn,
+				r.legacyBytesPerScrap, r.flyweightBytesPerScrap, r.legacyTextureLoads, r.flyweightTextureLoads);
+		}
+
+		if (ImGui::Button("Run Collision Benchmark (10..2000)", ImVec2(250, 0))) {
+			scrapCollisionBenchResults_ = ScrapBenchmark::RunCollisionBenchmark();
+			ScrapBenchmark::PrintCollisionResults(scrapCollisionBenchResults_);
+		}
+
+		for (const auto& r : scrapCollisionBenchResults_) {
+			ImGui::Text("%5d: AllPairs %.3f / Grid %.3f ms  overlap %.1f / %.1f px",
+				r.heldCount, r.allPairsMs, r.gridMs, r.allPairsOverlap, r.gridOverlap);
+		}
+
+		// 状態ごとの数が全走査と一致するか
+		if (ImGui::Button("Run State Set Check", ImVec2(250, 0))) {
+			scrapStateSetCheck_ = ScrapBenchmark::RunStateSetCheck();
+			ScrapBenchmark::PrintCheckResult("State Set", scrapStateSetCheck_);
+		}
+		if (scrapStateSetCheck_.frames > 0) {
+			ImGui::TextColored(scrapStateSetCheck_.mismatches == 0 ? ImVec4(0, 1, 0, 1) : ImVec4(1, 0, 0, 1),
+				"State Set: %d frames  %d mismatches", scrapStateSetCheck_.frames, scrapStateSetCheck_.mismatches);
+		}
+
+		// グリッドで探した吸引対象が全走査と一致するか
+		if (ImGui::Button("Run Suction Check", ImVec2(250, 0))) {
+			scrapSuctionCheck_ = ScrapBenchmark::RunSuctionCheck();
+			ScrapBenchmark::PrintCheckResult("Suction", scrapSuctionCheck_);
+		}
+		if (scrapSuctionCheck_.frames > 0) {
+			ImGui::TextColored(scrapSuctionCheck_.mismatches == 0 ? ImVec4(0, 1, 0, 1) : ImVec4(1, 0, 0, 1),
+				"Suction: %d frames  %d mismatches", scrapSuctionCheck_.frames, scrapSuctionCheck_.mismatches);
+		}
+
+		if (ImGui::Button("Run Placement Benchmark (50..2000)", ImVec2(250, 0))) {
+			scrapPlacementBenchResults_ = ScrapBenchmark::RunPlacementBenchmark();
+			ScrapBenchmark::PrintPlacementResults(scrapPlacementBenchResults_);
+		}
+
+		for (const auto& r : scrapPlacementBenchResults_) {
+			ImGui::Text("%5d: Legacy %.3f / Placer %.3f ms  overlaps %d / %d",
+				r.spawnCount, r.legacyMs, r.placerMs, r.legacyOverlaps, r.placerOverlaps);
+		}
+
+		if (ImGui::Button("Run Arena Benchmark (Sleep off/on)", ImVec2(250, 0))) {
+			scrapArenaBenchResults_ = ScrapBenchmark::RunArenaBenchmark();
+			ScrapBenchmark::PrintArenaResults(scrapArenaBenchResults_);
+		}
+
+		for (const auto& r : scrapArenaBenchResults_) {
+			ImGui::Text("Sleep %-3s: Update %.4f ms  active %d (sleeping %d / awake %d)",
+				r.sleepEnabled ? "on" : "off", r.updateMs, r.activeCount, r.sleepingCount, r.awakeCount);
+		}
+	}
+
 	ImGui::End();
 #endif
 }
\ No newline at end of file
@@ -1,4 +1,7 @@
 ﻿#pragma once
+#include <vector>
+#include "ParticleBenchmark.h"
+#include "ScrapBenchmark.h"
 
 // 前方宣言
 class Camera2D;
@@ -51,5 +54,26 @@ private:
 	bool showActiveParticles_ = true;
 	bool showParticleParams_ = false;
 
+	// パーティクル更新・描画準備ベンチマークの結果
+	std::vector<ParticleBenchmark::Result> particleBenchResults_;
+	std::vector<ParticleBenchmark::DrawResult> particleDrawBenchResults_;
+	std::vector<ParticleBenchmark::ThreadResult> particleThreadBenchResults_;
+	std::vector<ParticleBenchmark::EmitResult> particleEmitBenchResults_;
+	ParticleBenchmark::WindResult particleWindBenchResult_;
+	std::vector<ParticleBenchmark::WorldResult> particleWorldBenchResults_;
+	std::vector<ParticleBenchmark::TrailResult> particleTrailBenchResults_;
+	std::vector<ParticleBenchmark::ReplayResult> particleReplayBenchResults_;
+
+	// スクラップのベンチマークの結果
+	std::vector<ScrapBenchmark::SpawnBurstResult> scrapSpawnBenchResults_;
+	std::vector<ScrapBenchmark::CollisionResult> scrapCollisionBenchResults_;
+	ScrapBenchmark::CheckResult scrapStateSetCheck_;
+	ScrapBenchmark::CheckResult scrapSuctionCheck_;
+	std::vector<ScrapBenchmark::PlacementResult> scrapPlacementBenchResults_;
+	std::vector<ScrapBenchmark::ArenaResult> scrapArenaBenchResults_;
+
+	// 記録したパーティクル操作の保存先
+	static constexpr const char* kParticleRecordingPath = "Resources/data/replays/session.prep";
+
 
 };
\ No newline at end of file
@@ -289,10 +289,11 @@ unsigned int DrawComponent2D::GetFinalColor() const {
 
 void DrawComponent2D::GetSourceRect(int& srcX, int& srcY, int& srcW, int& srcH) const {
 	if (animation_) {
-		srcX = animation_->GetSrcX();
-		srcY = animation_->GetSrcY();
-		srcW = animation_->GetSrcW();
-		srcH = animation_->GetSrcH();
+		const SpriteFrameRect& frame = animation_->GetFrameRect();
+		srcX = frame.x;
+		srcY = frame.y;
+		srcW = frame.w;
+		srcH = frame.h;
 	}
 	else {
 		srcX = 0;
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "Vector2.h"
+#include "FastRandom.h"
 #include <functional>
 
 // ========== RGBA色管理 ==========
@@ -156,6 +157,7 @@ public:
 
 private:
 	ShakeEffect shakeEffect_;
+	FastRandom shakeRandom_{ FastRandom::MakeUniqueSeed() };  // インスタンスごと・起動ごとに違う揺れにする
 	RotationEffect rotationEffect_;
 	FadeEffect fadeEffect_;
 	FlashEffect flashEffect_;
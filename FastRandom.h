@@ -0,0 +1,163 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+/// <summary>
+/// 小さな状態（16バイト）の高速な擬似乱数（xoshiro128**）
+/// シードが同じなら、どの環境でもビット単位で同じ列を返す
+/// （std の分布クラスは実装ごとに結果が違うので、範囲変換もここで行う）。
+/// エミッターごと・用途ごとに1つずつ持ち、DeriveSeed で独立したシードを作る。
+/// std::shuffle などに渡せるよう UniformRandomBitGenerator の形も満たす。
+/// </summary>
+class FastRandom {
+public:
+	using result_type = uint32_t;
+
+	// 既定のシード（固定なので起動ごとに同じ列になる）
+	static constexpr uint64_t kDefaultSeed = 0x9E3779B97F4A7C15ull;
+
+	FastRandom() { Seed(kDefaultSeed); }
+	explicit FastRandom(uint64_t seed) { Seed(seed); }
+
+	/// <summary>
+	/// シードを設定する（splitmix64 で 128bit の状態に広げる）
+	/// </summary>
+	void Seed(uint64_t seed) {
+		uint64_t x = seed;
+		const uint64_t a = SplitMix64(x);
+		const uint64_t b = SplitMix64(x);
+		state_[0] = static_cast<uint32_t>(a);
+		state_[1] = static_cast<uint32_t>(a >> 32);
+		state_[2] = static_cast<uint32_t>(b);
+		state_[3] = static_cast<uint32_t>(b >> 32);
+		// 全て0の状態は周期1になるので避ける
+		if ((state_[0] | state_[1] | state_[2] | state_[3]) == 0) {
+			state_[0] = 1;
+		}
+	}
+
+	/// <summary>
+	/// 親のシードと番号から、別の列になるシードを作る（エミッターごとのシード用）
+	/// </summary>
+	static uint64_t DeriveSeed(uint64_t baseSeed, uint64_t streamId) {
+		uint64_t x = baseSeed ^ (streamId * 0xD1B54A32D192ED03ull);
+		return SplitMix64(x);
+	}
+
+	/// <summary>
+	/// 起動ごと・呼ぶごとに違うシードを作る（画面揺れなど、再現しなくてよい用途のインスタンス用）
+	/// 起動時に1度だけ random_device から取った値と、呼んだ回数の通し番号から DeriveSeed で作る
+	/// </summary>
+	static uint64_t MakeUniqueSeed() {
+		static const uint64_t baseSeed = [] {
+			std::random_device device;
+			return (static_cast<uint64_t>(device()) << 32) | device();
+		}();
+		static std::atomic<uint64_t> instanceCount = 0;
+		return DeriveSeed(baseSeed, instanceCount.fetch_add(1, std::memory_order_relaxed));
+	}
+
+	// 32bit の乱数
+	uint32_t NextU32() {
+		const uint32_t result = RotL(state_[1] * 5, 7) * 9;
+		const uint32_t t = state_[1] << 9;
+
+		state_[2] ^= state_[0];
+		state_[3] ^= state_[1];
+		state_[1] ^= state_[2];
+		state_[0] ^= state_[3];
+
+		state_[2] ^= t;
+		state_[3] = RotL(state_[3], 11);
+
+		return result;
+	}
+
+	// [0, 1) の一様乱数（上位24bit を使うので float で正確に表せる）
+	float NextFloat01() {
+		return ToUnitFloat(NextU32());
+	}
+
+	/// <summary>
+	/// [min, max) の一様乱数（min >= max なら min）
+	/// </summary>
+	float RandomFloat(float min, float max) {
+		if (min >= max) return min;
+		return min + (max - min) * NextFloat01();
+	}
+
+	/// <summary>
+	/// [min, max] の整数（min >= max なら min）
+	/// </summary>
+	int RandomInt(int min, int max) {
+		if (min >= max) return min;
+		const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+		// 乗算で範囲に縮める（偏りは 2^-32 程度で、演出用途には十分）
+		return min + static_cast<int>((static_cast<uint64_t>(NextU32()) * range) >> 32);
+	}
+
+	/// <summary>
+	/// [0, 1) の乱数を count 個まとめて書き出す
+	/// NextFloat01 を count 回呼んだのと同じ列になる（状態更新は逐次、変換はまとめて行う）
+	/// </summary>
+	void FillUnit(float* out, int count) {
+		uint32_t bits[64];
+		for (int base = 0; base < count; base += 64) {
+			const int n = (count - base < 64) ? count - base : 64;
+			// 1. 状態を進めて整数だけ書き出す（依存があるのはここだけ）
+			for (int i = 0; i < n; ++i) {
+				bits[i] = NextU32();
+			}
+			// 2. float への変換（依存が無いのでコンパイラがベクトル化できる）
+			for (int i = 0; i < n; ++i) {
+				out[base + i] = ToUnitFloat(bits[i]);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Fisher-Yates シャッフル（std::shuffle と違い、どの環境でも同じ並びになる）
+	/// </summary>
+	template <typename RandomIt>
+	void Shuffle(RandomIt first, RandomIt last) {
+		const int count = static_cast<int>(last - first);
+		for (int i = count - 1; i > 0; --i) {
+			const int j = RandomInt(0, i);
+			using std::swap;
+			swap(first[i], first[j]);
+		}
+	}
+
+	// std の分布クラスの代わり（a, b を覚えておいて範囲に変換するだけ）
+	struct FloatDistribution {
+		float a;
+		float b;
+		FloatDistribution(float min, float max) : a(min), b(max) {}
+		float operator()(FastRandom& random) const { return random.RandomFloat(a, b); }
+	};
+
+	// UniformRandomBitGenerator
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return 0xFFFFFFFFu; }
+	result_type operator()() { return NextU32(); }
+
+private:
+	static uint32_t RotL(uint32_t x, int k) {
+		return (x << k) | (x >> (32 - k));
+	}
+
+	static float ToUnitFloat(uint32_t bits) {
+		return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+	}
+
+	static uint64_t SplitMix64(uint64_t& x) {
+		uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	uint32_t state_[4];
+};
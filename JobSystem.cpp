@@ -0,0 +1,168 @@
+﻿#include "JobSystem.h"
+#include <algorithm>
+
+#ifdef min
+#undef min
+#endif
+
+#ifdef max
+#undef max
+#endif
+
+JobSystem::JobSystem(int workerCount) {
+	StartWorkers(workerCount < 0 ? GetHardwareThreadCount() - 1 : workerCount);
+}
+
+JobSystem::~JobSystem() {
+	StopWorkers();
+}
+
+int JobSystem::GetHardwareThreadCount() {
+	unsigned int count = std::thread::hardware_concurrency();
+	return count > 0 ? static_cast<int>(count) : 1;
+}
+
+int JobSystem::GetDefaultWorkerCount(int maxWorkers) {
+	return std::clamp(GetHardwareThreadCount() - 1, 0, std::max(0, maxWorkers));
+}
+
+void JobSystem::SetWorkerCount(int workerCount) {
+	if (workerCount < 0) {
+		workerCount = GetHardwareThreadCount() - 1;
+	}
+	if (workerCount == GetWorkerCount()) return;
+
+	StopWorkers();
+	StartWorkers(workerCount);
+}
+
+void JobSystem::StartWorkers(int workerCount) {
+	workerCount = std::max(0, workerCount);
+
+	queues_.clear();
+	for (int i = 0; i < workerCount + 1; ++i) {
+		queues_.push_back(std::make_unique<WorkQueue>());
+	}
+
+	stop_ = false;
+	for (int i = 0; i < workerCount; ++i) {
+		workers_.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+	}
+}
+
+void JobSystem::StopWorkers() {
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex_);
+		stop_ = true;
+	}
+	wakeCv_.notify_all();
+
+	for (auto& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+}
+
+void JobSystem::ParallelFor(int itemCount, int chunkSize, const ChunkFunc& func) {
+	if (itemCount <= 0) return;
+	chunkSize = std::max(1, chunkSize);
+	const int chunkCount = (itemCount + chunkSize - 1) / chunkSize;
+
+	// ワーカーが居ない・1チャンクしか無いときはその場で処理
+	if (workers_.empty() || chunkCount == 1) {
+		for (int c = 0; c < chunkCount; ++c) {
+			const int begin = c * chunkSize;
+			func(c, begin, std::min(begin + chunkSize, itemCount));
+		}
+		return;
+	}
+
+	// ジョブ内容を先に書いてからチャンクを積む（キューのロックで他スレッドに見える）
+	func_ = &func;
+	itemCount_ = itemCount;
+	chunkSize_ = chunkSize;
+	remaining_.store(chunkCount);
+
+	// 連続したチャンクを各キューにまとめて配る（キャッシュの局所性のため）
+	const int queueCount = static_cast<int>(queues_.size());
+	for (int q = 0; q < queueCount; ++q) {
+		const int first = chunkCount * q / queueCount;
+		const int last = chunkCount * (q + 1) / queueCount;
+		std::lock_guard<std::mutex> lock(queues_[q]->mutex);
+		for (int c = first; c < last; ++c) {
+			queues_[q]->chunks.push_back(c);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex_);
+		generation_++;
+	}
+	wakeCv_.notify_all();
+
+	// 呼び出し元も参加する
+	RunChunks(0);
+
+	std::unique_lock<std::mutex> lock(doneMutex_);
+	doneCv_.wait(lock, [this]() { return remaining_.load() == 0; });
+	func_ = nullptr;
+}
+
+void JobSystem::WorkerMain(int queueIndex) {
+	unsigned int seenGeneration = 0;
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex_);
+		seenGeneration = generation_;
+	}
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(wakeMutex_);
+			wakeCv_.wait(lock, [&]() { return stop_ || generation_ != seenGeneration; });
+			if (stop_) return;
+			seenGeneration = generation_;
+		}
+		RunChunks(queueIndex);
+	}
+}
+
+void JobSystem::RunChunks(int queueIndex) {
+	int chunk = 0;
+	while (PopLocal(queueIndex, chunk) || Steal(queueIndex, chunk)) {
+		const int begin = chunk * chunkSize_;
+		const int end = std::min(begin + chunkSize_, itemCount_);
+		(*func_)(chunk, begin, end);
+
+		if (remaining_.fetch_sub(1) == 1) {
+			// 最後のチャンク：待っている呼び出し元を起こす
+			std::lock_guard<std::mutex> lock(doneMutex_);
+			doneCv_.notify_all();
+		}
+	}
+}
+
+bool JobSystem::PopLocal(int queueIndex, int& chunk) {
+	WorkQueue& queue = *queues_[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.chunks.empty()) return false;
+
+	// 自分のキューは前から（配られた順に）処理する
+	chunk = queue.chunks.front();
+	queue.chunks.pop_front();
+	return true;
+}
+
+bool JobSystem::Steal(int queueIndex, int& chunk) {
+	const int queueCount = static_cast<int>(queues_.size());
+	for (int offset = 1; offset < queueCount; ++offset) {
+		WorkQueue& victim = *queues_[(queueIndex + offset) % queueCount];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (victim.chunks.empty()) continue;
+
+		// 盗むときは後ろから取り、持ち主の処理とぶつかりにくくする
+		chunk = victim.chunks.back();
+		victim.chunks.pop_back();
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,80 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// 小さなワーカースレッドプール（std::thread のみ、外部依存なし）
+/// ParallelFor で範囲を固定サイズのチャンクに分け、各スレッドのキューに配る。
+/// 自分のキューが空になったスレッドは他のキューから盗む（ワークスティーリング）ので、
+/// 重いチャンクが偏っても負荷が均される。呼び出し元のスレッドも処理に参加する。
+/// </summary>
+class JobSystem {
+public:
+	// チャンク処理関数（チャンク番号, [begin, end)）
+	using ChunkFunc = std::function<void(int chunkIndex, int begin, int end)>;
+
+	/// <summary>
+	/// </summary>
+	/// <param name="workerCount">呼び出し元以外のスレッド数（負なら論理コア数 - 1）</param>
+	explicit JobSystem(int workerCount = -1);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// <summary>
+	/// ワーカー数を変更する（ParallelFor 実行中に呼ばないこと）
+	/// </summary>
+	void SetWorkerCount(int workerCount);
+	int GetWorkerCount() const { return static_cast<int>(workers_.size()); }
+
+	/// <summary>
+	/// [0, itemCount) を chunkSize ごとに分けて並列に処理し、全チャンクの完了を待つ
+	/// チャンク番号はスレッド数に関係なく範囲だけで決まる
+	/// </summary>
+	void ParallelFor(int itemCount, int chunkSize, const ChunkFunc& func);
+
+	// 使用可能な論理コア数（取得できなければ 1）
+	static int GetHardwareThreadCount();
+	// 論理コア数 - 1（呼び出し元の分）を maxWorkers で頭打ちにしたワーカー数（1コアなら 0 = 呼び出し元だけで処理）
+	static int GetDefaultWorkerCount(int maxWorkers);
+
+private:
+	struct WorkQueue {
+		std::mutex mutex;
+		std::deque<int> chunks;
+	};
+
+	void StartWorkers(int workerCount);
+	void StopWorkers();
+	void WorkerMain(int queueIndex);
+
+	// queueIndex のスレッドとして、残りのチャンクが無くなるまで処理する
+	void RunChunks(int queueIndex);
+	bool PopLocal(int queueIndex, int& chunk);
+	bool Steal(int queueIndex, int& chunk);
+
+	std::vector<std::thread> workers_;
+	std::vector<std::unique_ptr<WorkQueue>> queues_;  // [0] は呼び出し元
+
+	// 実行中のジョブ
+	const ChunkFunc* func_ = nullptr;
+	int itemCount_ = 0;
+	int chunkSize_ = 1;
+	std::atomic<int> remaining_{ 0 };
+
+	// ワーカーの起床・完了通知
+	std::mutex wakeMutex_;
+	std::condition_variable wakeCv_;
+	unsigned int generation_ = 0;
+	bool stop_ = false;
+
+	std::mutex doneMutex_;
+	std::condition_variable doneCv_;
+};
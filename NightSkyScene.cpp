@@ -1,13 +1,8 @@
 ﻿#include "NightSkyScene.h"
 #include <Novice.h>
-#include <cstdlib>
+#include "Affine2D.h"
 #include <cmath>
 
-// 乱数ユーティリティ
-static float RandomRange(float min, float max) {
-	return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
-}
-
 NightSkyScene::NightSkyScene() {
 	Initialize();
 }
@@ -15,14 +10,27 @@ NightSkyScene::NightSkyScene() {
 void NightSkyScene::Initialize() {
 	camera_ = Camera2D({ 640.0f, 360.0f }, { 1280.0f, 720.0f });
 
+	// 毎回同じ星空になるよう、乱数は固定シードから始める
+	random_.Seed(FastRandom::kDefaultSeed);
+
 	// 画像読み込み
 	starTextureHandle_ = Novice::LoadTexture("./Resources/images/effect/particle_white.png");
-	// パーティクルも同じ画像でOK（あるいは別のキラキラ画像があれば変えてください）
-	particleTextureHandle_ = starTextureHandle_;
-
-	// パーティクル描画用の「はんこ」を用意
-	particleDrawer_ = std::make_unique<DrawComponent2D>(particleTextureHandle_);
-	particleDrawer_->SetAnchorPoint({ 0.5f, 0.5f }); // 中心基準
+	// 尾も同じ画像でOK（あるいは別のキラキラ画像があれば変えてください）
+	trailTextureHandle_ = starTextureHandle_;
+
+	// 流れ星の尾（先頭は本体の色、末尾に向かってシアンに変わりながら細く・透明に）
+	int texWidth = 0;
+	int texHeight = 0;
+	Novice::GetTextureSize(trailTextureHandle_, &texWidth, &texHeight);
+	trailSettings_.textureHandle = trailTextureHandle_;
+	trailSettings_.blendMode = kBlendModeAdd;
+	trailSettings_.maxPoints = 48;
+	trailSettings_.pointLifetime = 0.5f;        // 旧キラキラの寿命（0.33 〜 0.67 秒）の中ほど
+	trailSettings_.minSegmentLength = 12.0f;
+	trailSettings_.widthStart = static_cast<float>(texHeight) * 0.06f;
+	trailSettings_.widthEnd = 0.0f;
+	trailSettings_.colorStart = 0xFFFFDDFF;
+	trailSettings_.colorEnd = 0x00FFFF00;
 
 	// 星を生成
 	SpawnStars(400);
@@ -34,21 +42,21 @@ void NightSkyScene::SpawnStars(int count) {
 
 	for (int i = 0; i < count; ++i) {
 		Star star;
-		float posX = RandomRange(-200.0f, 1480.0f);
-		float posY = RandomRange(-200.0f, 920.0f);
+		float posX = random_.RandomFloat(-200.0f, 1480.0f);
+		float posY = random_.RandomFloat(-200.0f, 920.0f);
 		star.originalPosition = { posX, posY };
-		star.originalScale = RandomRange(0.0f, 0.06f);
+		star.originalScale = random_.RandomFloat(0.0f, 0.06f);
 
 		star.drawComp = std::make_unique<DrawComponent2D>(starTextureHandle_);
 		star.drawComp->SetPosition(star.originalPosition);
 
 		// 色のバリエーション
-		int type = rand() % 10;
+		int type = random_.RandomInt(0, 9);
 		if (type < 6) star.drawComp->SetBaseColor(0xFFFFFFFF); // 白
 		else if (type < 8) star.drawComp->SetBaseColor(0xAADDFFFF); // 青白
 		else star.drawComp->SetBaseColor(0xFFFFAA00); // 金色
 
-		star.originalScale = RandomRange(0.04f, 0.08f);
+		star.originalScale = random_.RandomFloat(0.04f, 0.08f);
 		star.drawComp->SetScale(star.originalScale, star.originalScale);
 
 		bool isLarge = star.originalScale >= 0.05f;
@@ -70,39 +78,22 @@ void NightSkyScene::SpawnShootingStar() {
 	ss.drawComp = std::make_unique<DrawComponent2D>(starTextureHandle_);
 
 	// 画面外（右上や左上）からスタート
-	float startX = RandomRange(0.0f, 1280.0f);
+	float startX = random_.RandomFloat(0.0f, 1280.0f);
 	ss.position = { startX, -50.0f }; // 画面上部から
 
 	// 斜め下に落ちる速度
-	float speed = RandomRange(600.0f, 1000.0f); // かなり速く
-	float angle = RandomRange(45.0f, 135.0f) * (3.14159f / 180.0f); // 下方向への角度
+	float speed = random_.RandomFloat(600.0f, 1000.0f); // かなり速く
+	float angle = random_.RandomFloat(45.0f, 135.0f) * (3.14159f / 180.0f); // 下方向への角度
 	ss.velocity = { cosf(angle) * speed, sinf(angle) * speed };
 
 	ss.isActive = true;
 	ss.drawComp->SetScale(0.01f, 0.01f); // 本体は少し大きめ
 	ss.drawComp->SetBaseColor(0xFFFFDDFF); // 少し黄色がかった白
 
-	shootingStars_.push_back(std::move(ss));
-}
+	ss.trail.Reset(trailSettings_);
+	ss.trail.Push(ss.position);
 
-void NightSkyScene::AddTrail(const Vector2& pos) {
-	TrailParticle tp;
-	tp.position = pos;
-
-	// 拡散するような動きを入れると綺麗
-	tp.velocity = { RandomRange(-20.0f, 20.0f), RandomRange(-20.0f, 20.0f) };
-
-	tp.scale = RandomRange(0.03f, 0.06f);
-	tp.life = 1.0f;
-	tp.decayRate = RandomRange(1.5f, 3.0f); // 消える速さ
-
-	// ランダムカラー（シアン、ピンク、白）
-	int colType = rand() % 3;
-	if (colType == 0) tp.color = 0x00FFFFFF; // Cyan
-	else if (colType == 1) tp.color = 0xFF55FFFF; // Pink
-	else tp.color = 0xFFFFFFFF; // White
-
-	trails_.push_back(tp);
+	shootingStars_.push_back(std::move(ss));
 }
 
 void NightSkyScene::Update(float deltaTime, const char* keys, const char* preKeys) {
@@ -122,7 +113,7 @@ void NightSkyScene::Update(float deltaTime, const char* keys, const char* preKey
 	shootingStarTimer_ -= deltaTime;
 	if (shootingStarTimer_ <= 0.0f) {
 		SpawnShootingStar();
-		shootingStarTimer_ = RandomRange(1.0f, 3.0f); // 1〜3秒に1回発生
+		shootingStarTimer_ = random_.RandomFloat(1.0f, 3.0f); // 1〜3秒に1回発生
 	}
 
 	// デバッグ：Spaceキーで強制発生
@@ -133,44 +124,31 @@ void NightSkyScene::Update(float deltaTime, const char* keys, const char* preKey
 	// 3. 流れ星の更新
 	auto itSS = shootingStars_.begin();
 	while (itSS != shootingStars_.end()) {
-		// 移動
-		itSS->position.x += itSS->velocity.x * deltaTime;
-		itSS->position.y += itSS->velocity.y * deltaTime;
-		itSS->drawComp->SetPosition(itSS->position); // コンポーネントに反映
-		itSS->drawComp->Update(deltaTime); // 回転などを更新
-
-		// 軌跡（パーティクル）の発生
-		// フレームレートに依存せず一定間隔で出す
-		itSS->spawnTimer -= deltaTime;
-		if (itSS->spawnTimer <= 0.0f) {
-			// 一度に複数個出すとリッチになる
-			for (int i = 0; i < 3; ++i) AddTrail(itSS->position);
-			itSS->spawnTimer = 0.016f; // かなり高頻度
+		if (itSS->isActive) {
+			// 移動
+			itSS->position.x += itSS->velocity.x * deltaTime;
+			itSS->position.y += itSS->velocity.y * deltaTime;
+			itSS->drawComp->SetPosition(itSS->position); // コンポーネントに反映
+			itSS->drawComp->Update(deltaTime); // 回転などを更新
+
+			// 尾の先頭を本体の位置に合わせる（一定距離ごとに点が打たれる）
+			itSS->trail.Push(itSS->position);
+
+			// 画面外判定（本体は止め、尾は消えきるまで残す）
+			if (itSS->position.y > 800.0f || itSS->position.x < -200.0f || itSS->position.x > 1480.0f) {
+				itSS->isActive = false;
+			}
 		}
 
-		// 画面外判定
-		if (itSS->position.y > 800.0f || itSS->position.x < -200.0f || itSS->position.x > 1480.0f) {
+		itSS->trail.Update(deltaTime);
+
+		if (!itSS->isActive && itSS->trail.IsEmpty()) {
 			itSS = shootingStars_.erase(itSS);
 		}
 		else {
 			++itSS;
 		}
 	}
-
-	// 4. トレイルパーティクルの更新
-	auto itTrail = trails_.begin();
-	while (itTrail != trails_.end()) {
-		itTrail->position.x += itTrail->velocity.x * deltaTime;
-		itTrail->position.y += itTrail->velocity.y * deltaTime;
-		itTrail->life -= itTrail->decayRate * deltaTime;
-
-		if (itTrail->life <= 0.0f) {
-			itTrail = trails_.erase(itTrail);
-		}
-		else {
-			++itTrail;
-		}
-	}
 }
 
 // ---------------------------------------------------------
@@ -263,6 +241,8 @@ void NightSkyScene::DrawWorldElements(bool isLensEffect) {
 	// B. 流れ星本体
 	// ===================================
 	for (auto& ss : shootingStars_) {
+		if (!ss.isActive) continue; // 画面外に出て尾だけ残っている
+
 		Vector2 originalPos = ss.position;
 		Vector2 drawPos = originalPos;
 		float baseScale = 0.02f; // 初期設定値
@@ -302,44 +282,28 @@ void NightSkyScene::DrawWorldElements(bool isLensEffect) {
 	}
 
 	// ===================================
-	// C. 軌跡パーティクル
+	// C. 流れ星の尾（1本につき 点の数 - 1 枚の DrawQuad）
 	// ===================================
-	for (auto& trail : trails_) {
-		Vector2 drawPos = trail.position;
-		float drawScale = trail.scale * trail.life; // 寿命で小さくなる
-
+	Matrix3x3 trailMatrix = camera_.GetVpVpMatrix();
+	ParticleTrailMask mask;
+	mask.center = lensPosition_;
+	if (isLensEffect) {
+		// レンズ中心を基準に拡大してから描く。拡大後にレンズ内に収まる区間（元の距離が半径 / 倍率以内）だけ
+		AffineMatrix2D toLens = AffineMatrix2D::MakeTranslateMatrix({ -lensPosition_.x, -lensPosition_.y });
+		AffineMatrix2D magnify = AffineMatrix2D::MakeScaleMatrix({ lensMagnification_, lensMagnification_ });
+		AffineMatrix2D fromLens = AffineMatrix2D::MakeTranslateMatrix(lensPosition_);
+		Matrix3x3 lensMatrix = Matrix3x3::Multiply(Matrix3x3::Multiply(toLens, magnify), fromLens);
+		trailMatrix = Matrix3x3::Multiply(lensMatrix, trailMatrix);
+		mask.radius = lensRadius_ / lensMagnification_;
+		mask.keepInside = true;
+	}
+	else {
 		// 通常描画パスでレンズ内除外
-		if (!isLensEffect) {
-			float dx0 = trail.position.x - lensPosition_.x;
-			float dy0 = trail.position.y - lensPosition_.y;
-			if (dx0 * dx0 + dy0 * dy0 < r2) continue;
-		}
-
-		if (isLensEffect) {
-			float dx = trail.position.x - lensPosition_.x;
-			float dy = trail.position.y - lensPosition_.y;
-			float distSq = dx * dx + dy * dy;
-
-			if (distSq > r2) continue;
-
-			drawPos.x = lensPosition_.x + dx * lensMagnification_;
-			drawPos.y = lensPosition_.y + dy * lensMagnification_;
-			drawScale *= lensMagnification_;
-
-			float dxZoom = drawPos.x - lensPosition_.x;
-			float dyZoom = drawPos.y - lensPosition_.y;
-			if (dxZoom * dxZoom + dyZoom * dyZoom > r2) continue;
-		}
-
-		particleDrawer_->SetPosition(drawPos);
-		particleDrawer_->SetScale(drawScale, drawScale);
-
-		// アルファ値を寿命に合わせる（だんだん透明に）
-		unsigned int color = trail.color;
-		unsigned int alpha = (unsigned int)(255.0f * trail.life);
-		color = (color & 0xFFFFFF00) | alpha;
-		particleDrawer_->SetBaseColor(color);
+		mask.radius = lensRadius_;
+		mask.keepInside = false;
+	}
 
-		particleDrawer_->Draw(camera_);
+	for (auto& ss : shootingStars_) {
+		ss.trail.Draw(trailMatrix, &mask);
 	}
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "GameSceneBase.h"
 #include "Camera2D.h"
 #include "DrawComponent2D.h"
+#include "FastRandom.h"
+#include "ParticleTrail.h"
 #include <vector>
 #include <memory>
 #include <list> // 追加・削除が多いのでlistを使います
@@ -28,23 +30,14 @@ private:
 		float originalScale;
 	};
 
-	// 2. 流れ星本体
+	// 2. 流れ星本体と尾
+	// 尾は小さな粒を撒かず、1本の軌跡（リボン）として描く
 	struct ShootingStar {
 		std::unique_ptr<DrawComponent2D> drawComp;
 		Vector2 position;
 		Vector2 velocity;
-		bool isActive = false;
-		float spawnTimer = 0.0f; // 次にパーティクルを出すまでの時間
-	};
-
-	// 3. 軌跡のキラキラ（大量に出るので軽量化）
-	struct TrailParticle {
-		Vector2 position;
-		Vector2 velocity;
-		float scale;
-		float life;      // 残り寿命 (1.0 -> 0.0)
-		float decayRate; // 減衰速度
-		unsigned int color;
+		bool isActive = false;   // 画面外に出たら false（尾が消えきるまでは残す）
+		ParticleTrail trail;
 	};
 
 	// --- メンバ変数 ---
@@ -52,19 +45,19 @@ private:
 
 	// リソース
 	int starTextureHandle_ = -1;
-	int particleTextureHandle_ = -1; // キラキラ用
+	int trailTextureHandle_ = -1; // 流れ星の尾用
 
 	// オブジェクト管理
 	std::vector<Star> stars_;
 	std::list<ShootingStar> shootingStars_;
-	std::list<TrailParticle> trails_;
-
-	// 【最適化】パーティクル描画用（1つのインスタンスを使い回す）
-	std::unique_ptr<DrawComponent2D> particleDrawer_;
+	ParticleTrailSettings trailSettings_;
 
 	// 流れ星の発生管理
 	float shootingStarTimer_ = 0.0f;
 
+	// 星の配置・流れ星・尾の乱数
+	FastRandom random_;
+
 	// 望遠鏡（レンズ）の設定
 	Vector2 lensPosition_ = { 0.0f, 0.0f };
 	float lensRadius_ = 150.0f;
@@ -74,7 +67,6 @@ private:
 	// --- 内部ヘルパー関数 ---
 	void SpawnStars(int count);
 	void SpawnShootingStar();
-	void AddTrail(const Vector2& pos);
 
 	// レンズ描画の共通処理（テンプレート的に使えるように関数化）
 	void DrawWorldElements(bool isLensEffect);
@@ -1,4 +1,5 @@
 ﻿#include "Particle.h"
+#include "ParticleTypeTraits.h"
 #include <cmath>
 #include <algorithm>
 
@@ -10,7 +11,7 @@ void Particle::Initialize(
 	const Vector2& pos,
 	const Vector2& vel,
 	const Vector2& acc,
-	int life,
+	float life,
 	int texHandle,
 	float scaleStart,
 	float scaleEnd,
@@ -68,14 +69,14 @@ void Particle::Update(float deltaTime) {
 	if (!isAlive_) return;
 
 	// 1. 寿命を減算
-	lifeTimer_--;
-	if (lifeTimer_ <= 0) {
+	lifeTimer_ -= deltaTime;
+	if (lifeTimer_ <= 0.0f) {
 		isAlive_ = false;
 		return;
 	}
 
 	// 2. 進行度を計算（0.0 ～ 1.0）
-	float t = 1.0f - (static_cast<float>(lifeTimer_) / static_cast<float>(maxLife_));
+	float t = 1.0f - (lifeTimer_ / maxLife_);
 	t = std::clamp(t, 0.0f, 1.0f);
 
 	// 3. 線形補間でスケールと色を更新
@@ -158,7 +159,7 @@ void Particle::CheckGroundCollision(float groundY) {
 			position_.y = groundY;  // 地面の位置に補正
 
 			// 寿命を大幅に減らす（すぐ消える）
-			lifeTimer_ = std::min(lifeTimer_, 10);
+			lifeTimer_ = std::min(lifeTimer_, kGroundBounceLifeSeconds);
 		}
 		// 雪の場合：地面に着いたら消える
 		else if (type_ == ParticleType::Snow) {
@@ -12,7 +12,7 @@ public:
 		const Vector2& pos,
 		const Vector2& vel,
 		const Vector2& acc,
-		int life,
+		float life,  // 寿命（秒）
 		int texHandle,
 		float scaleStart,
 		float scaleEnd,
@@ -76,8 +76,8 @@ private:
 	unsigned int colorEnd_ = 0xFFFFFFFF;
 	unsigned int currentColor_ = 0xFFFFFFFF;
 
-	int lifeTimer_ = 0;
-	int maxLife_ = 0;
+	float lifeTimer_ = 0.0f;  // 残り寿命（秒）
+	float maxLife_ = 0.0f;
 	bool isAlive_ = false;
 
 	int textureHandle_ = -1;
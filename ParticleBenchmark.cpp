@@ -0,0 +1,826 @@
+﻿#include "ParticleBenchmark.h"
+#include "Particle.h"
+#include "ParticleStorage.h"
+#include "ParticleDrawList.h"
+#include "ParticleFlowField.h"
+#include "ParticleCollisionWorld.h"
+#include "ParticleTypeTraits.h"
+#include "JobSystem.h"
+#include "ParticleManager.h"
+#include "ParticleTrail.h"
+#include "ParticleReplay.h"
+#include "Affine2D.h"
+#include "Novice.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+namespace {
+
+	// ベンチマーク用の初期状態を作る（固定シードなので毎回同じ）
+	std::vector<ParticleSpawnDesc> MakeSpawnDescs(int count) {
+		std::mt19937 engine(12345);
+		std::uniform_real_distribution<float> pos(-640.0f, 640.0f);
+		std::uniform_real_distribution<float> vel(-300.0f, 300.0f);
+		std::uniform_real_distribution<float> rot(-0.1f, 0.1f);
+		std::uniform_int_distribution<int> life(30, 240);
+
+		std::vector<ParticleSpawnDesc> descs(count);
+		for (auto& d : descs) {
+			d.position = { pos(engine), pos(engine) };
+			d.velocity = { vel(engine), vel(engine) };
+			d.acceleration = { 0.0f, -800.0f };
+			d.life = static_cast<float>(life(engine)) / 60.0f;  // 0.5 〜 4 秒
+			d.textureHandle = 0;
+			d.scaleStart = 1.0f;
+			d.scaleEnd = 0.2f;
+			d.colorStart = 0xFFFFFFFF;
+			d.colorEnd = 0xFF800000;
+			d.rotationSpeed = rot(engine);
+			d.drawSize = 16.0f;
+		}
+		return descs;
+	}
+
+	// 挙動の混ぜ方（Physics が大半、一部 Stationary / Ghost）
+	ParticleBehavior BehaviorFor(int index) {
+		if (index % 16 == 7) return ParticleBehavior::Stationary;
+		if (index % 16 == 11) return ParticleBehavior::Ghost;
+		return ParticleBehavior::Physics;
+	}
+
+	bool SameBits(float a, float b) {
+		return std::memcmp(&a, &b, sizeof(float)) == 0;
+	}
+
+	template <typename Func>
+	double MeasureMs(int frames, Func&& func) {
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int f = 0; f < frames; ++f) {
+			func();
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+	}
+
+	void SpawnAll(ParticleStorage& storage, const std::vector<ParticleSpawnDesc>& descs) {
+		storage.Resize(static_cast<int>(descs.size()));
+		for (int i = 0; i < static_cast<int>(descs.size()); ++i) {
+			int index = storage.Spawn(ParticleType::Debris, descs[i]);
+			storage.SetBehavior(index, BehaviorFor(i));
+		}
+	}
+
+	// 1レベル分の計測（計測後の状態を reference と比較）
+	double RunStorage(const std::vector<ParticleSpawnDesc>& descs, int frames, float dt,
+		ParticleSimdLevel level, const std::vector<Particle>& reference, bool& matches) {
+		ParticleStorage storage;
+		SpawnAll(storage, descs);
+		double ms = MeasureMs(frames, [&]() { storage.Update(dt, level); });
+
+		// 消滅した粒は詰められているので、生成順の通し番号で基準と突き合わせる
+		int referenceAlive = 0;
+		for (const Particle& p : reference) {
+			referenceAlive += p.IsAlive() ? 1 : 0;
+		}
+		if (referenceAlive != storage.GetCount()) {
+			matches = false;
+		}
+
+		for (int i = 0; i < storage.GetCount() && matches; ++i) {
+			const Particle& p = reference[storage.spawnSerial[i]];
+			if (!p.IsAlive() ||
+				!SameBits(p.GetPosition().x, storage.posX[i]) ||
+				!SameBits(p.GetPosition().y, storage.posY[i]) ||
+				!SameBits(p.GetRotation(), storage.rotation[i]) ||
+				!SameBits(p.GetCurrentScale(), storage.currentScale[i]) ||
+				p.GetCurrentColor() != storage.currentColor[i]) {
+				matches = false;
+			}
+		}
+		return ms;
+	}
+
+	// 並列更新の1回分の結果（ワーカー数ごとに比較する）
+	struct StepSnapshot {
+		std::vector<float> posX, posY, currentScale;
+		std::vector<unsigned int> currentColor;
+		std::vector<uint32_t> spawnSerial;
+		std::vector<ParticleGroundHit> hits;
+	};
+
+	// 旧 ParticleManager::Draw の準備部分（DrawQuad の代わりに quads に積む）
+	void LegacyDrawPrep(const ParticleStorage& storage, const Matrix3x3& vpMatrix,
+		std::vector<ParticleDrawList::Quad>& quads) {
+		quads.clear();
+		for (int t = 0; t < kParticleTypeCount; ++t) {
+			const ParticleType type = static_cast<ParticleType>(t);
+			for (int i = 0; i < storage.GetCapacity(); ++i) {
+				if (i >= storage.GetCount() || storage.type[i] != type) continue;
+
+				Vector2 screenPos = Matrix3x3::Transform({ storage.posX[i], storage.posY[i] }, vpMatrix);
+
+				int texWidth, texHeight;
+				Novice::GetTextureSize(storage.textureHandle[i], &texWidth, &texHeight);
+
+				float baseSize = storage.drawSize[i];
+				if (baseSize <= 0.0f) {
+					baseSize = static_cast<float>(texWidth);
+				}
+				float drawSize = baseSize * storage.currentScale[i];
+				float offsetX = screenPos.x - drawSize * 0.5f;
+				float offsetY = screenPos.y - drawSize * 0.5f;
+
+				quads.push_back({
+					static_cast<int>(offsetX), static_cast<int>(offsetY),
+					static_cast<int>(offsetX + drawSize), static_cast<int>(offsetY + drawSize),
+					0, 0, texWidth, texHeight, storage.currentColor[i] });
+			}
+		}
+	}
+}
+
+std::vector<ParticleBenchmark::Result> ParticleBenchmark::RunUpdateBenchmark(int frames) {
+	const int kCounts[] = { 2 * 1024, 16 * 1024, 64 * 1024 };
+	const float dt = 1.0f / 60.0f;
+
+	std::vector<Result> results;
+	for (int count : kCounts) {
+		Result result;
+		result.particleCount = count;
+
+		std::vector<ParticleSpawnDesc> descs = MakeSpawnDescs(count);
+
+		// 旧 AoS 版（基準）
+		std::vector<Particle> reference(count);
+		for (int i = 0; i < count; ++i) {
+			const ParticleSpawnDesc& d = descs[i];
+			reference[i].SetType(ParticleType::Debris);
+			reference[i].Initialize(d.position, d.velocity, d.acceleration, d.life,
+				d.textureHandle, d.scaleStart, d.scaleEnd, d.colorStart, d.colorEnd,
+				d.rotation, d.rotationSpeed, d.blendMode, d.drawSize);
+			reference[i].SetBehavior(BehaviorFor(i));
+		}
+		result.aosMs = MeasureMs(frames, [&]() {
+			for (auto& p : reference) {
+				p.Update(dt);
+			}
+		});
+
+		// SoA 版（各命令セット）
+		bool matches = true;
+		result.scalarMs = RunStorage(descs, frames, dt, ParticleSimdLevel::Scalar, reference, matches);
+
+		ParticleSimdLevel best = ParticleStorage::GetBestSimdLevel();
+		if (best == ParticleSimdLevel::SSE || best == ParticleSimdLevel::AVX2) {
+			result.sseMs = RunStorage(descs, frames, dt, ParticleSimdLevel::SSE, reference, matches);
+		}
+		if (best == ParticleSimdLevel::AVX2) {
+			result.avxMs = RunStorage(descs, frames, dt, ParticleSimdLevel::AVX2, reference, matches);
+		}
+		result.matchesReference = matches;
+
+		results.push_back(result);
+	}
+	return results;
+}
+
+void ParticleBenchmark::PrintResults(const std::vector<Result>& results) {
+	Novice::ConsolePrintf("=== Particle Update Benchmark (ms/frame) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("%6d: AoS %.3f / Scalar %.3f / SSE %.3f / AVX2 %.3f  [%s]\n",
+			r.particleCount, r.aosMs, r.scalarMs, r.sseMs, r.avxMs,
+			r.matchesReference ? "match" : "MISMATCH");
+	}
+}
+
+std::vector<ParticleBenchmark::DrawResult> ParticleBenchmark::RunDrawPrepBenchmark(
+	const std::vector<int>& textureHandles, int frames) {
+	const int kCounts[] = { 512, 2048, 16 * 1024 };
+	const int kLegacyCapacity = 2048;  // 旧プールのスロット数
+	const BlendMode kBlendModes[] = { kBlendModeNormal, kBlendModeAdd };
+
+	std::vector<DrawResult> results;
+	if (textureHandles.empty()) return results;
+
+	// Y 軸反転 + 画面中央へ平行移動（Camera2D の既定に近い行列）
+	Matrix3x3 vpMatrix = Matrix3x3::Identity();
+	vpMatrix.m[1][1] = -1.0f;
+	vpMatrix.m[2][0] = 640.0f;
+	vpMatrix.m[2][1] = 360.0f;
+
+	for (int count : kCounts) {
+		std::vector<ParticleSpawnDesc> descs = MakeSpawnDescs(count);
+
+		ParticleStorage storage;
+		storage.Resize(count > kLegacyCapacity ? count : kLegacyCapacity);
+		for (int i = 0; i < count; ++i) {
+			const int t = i % kParticleTypeCount;
+			descs[i].textureHandle = textureHandles[t % textureHandles.size()];
+			descs[i].blendMode = kBlendModes[t % 2];
+			storage.Spawn(static_cast<ParticleType>(t), descs[i]);
+		}
+
+		DrawResult result;
+		result.particleCount = count;
+
+		std::vector<ParticleDrawList::Quad> legacyQuads;
+		legacyQuads.reserve(count);
+		result.legacyMs = MeasureMs(frames, [&]() { LegacyDrawPrep(storage, vpMatrix, legacyQuads); });
+
+		ParticleDrawList drawList;
+		result.binnedMs = MeasureMs(frames, [&]() { drawList.Build(storage, vpMatrix); });
+		result.binCount = static_cast<int>(drawList.GetBins().size());
+
+		results.push_back(result);
+	}
+	return results;
+}
+
+void ParticleBenchmark::PrintDrawResults(const std::vector<DrawResult>& results) {
+	Novice::ConsolePrintf("=== Particle Draw Prep Benchmark (ms/frame) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("%6d: Legacy %.3f / Binned %.3f  (%d bins)\n",
+			r.particleCount, r.legacyMs, r.binnedMs, r.binCount);
+	}
+}
+
+std::vector<ParticleBenchmark::ThreadResult> ParticleBenchmark::RunThreadScalingBenchmark(int particleCount, int frames) {
+	const float dt = 1.0f / 60.0f;
+	const int kChunkSize = 512;
+
+	// 地面判定と風も通るように雨・雪を混ぜる
+	std::vector<ParticleSpawnDesc> descs = MakeSpawnDescs(particleCount);
+	float windStrength[kParticleTypeCount] = {};
+	windStrength[static_cast<int>(ParticleType::Rain)] = 20.0f;
+	windStrength[static_cast<int>(ParticleType::Snow)] = 30.0f;
+	ParticleFlowField flowField;
+	flowField.BuildCurlNoise(64, 64, 32.0f, 4, 2, 12345);
+
+	ParticleStepContext context;
+	context.deltaTime = dt;
+	context.groundY = -360.0f;
+	context.windStrengthByType = windStrength;
+	context.flowField = &flowField;
+	context.simdLevel = ParticleStorage::GetBestSimdLevel();
+
+	std::vector<ThreadResult> results;
+	StepSnapshot serial;
+	const int maxWorkers = JobSystem::GetHardwareThreadCount() - 1;
+
+	for (int workers = 0; workers <= maxWorkers; ++workers) {
+		JobSystem jobs(workers);
+
+		ParticleStorage storage;
+		storage.Resize(particleCount);
+		for (int i = 0; i < particleCount; ++i) {
+			const ParticleType type = (i % 4 == 0) ? ParticleType::Rain
+				: (i % 4 == 1) ? ParticleType::Snow : ParticleType::Debris;
+			int index = storage.Spawn(type, descs[i]);
+			storage.SetBehavior(index, BehaviorFor(i));
+		}
+
+		std::vector<std::vector<ParticleGroundHit>> hitQueues;
+		std::vector<ParticleGroundHit> hits;
+
+		ThreadResult result;
+		result.workerCount = workers;
+		result.stepMs = MeasureMs(frames, [&]() {
+			const int count = storage.GetCount();
+			const int chunkCount = (count + kChunkSize - 1) / kChunkSize;
+			if (static_cast<int>(hitQueues.size()) < chunkCount) {
+				hitQueues.resize(chunkCount);
+			}
+
+			jobs.ParallelFor(count, kChunkSize, [&](int chunkIndex, int begin, int end) {
+				hitQueues[chunkIndex].clear();
+				storage.StepRange(begin, end, context, &hitQueues[chunkIndex]);
+			});
+			storage.RemoveDead();
+
+			// マネージャーと同じくチャンク順にまとめる
+			for (int c = 0; c < chunkCount; ++c) {
+				hits.insert(hits.end(), hitQueues[c].begin(), hitQueues[c].end());
+				hitQueues[c].clear();
+			}
+		});
+
+		StepSnapshot snapshot;
+		snapshot.posX = storage.posX;
+		snapshot.posY = storage.posY;
+		snapshot.currentScale = storage.currentScale;
+		snapshot.currentColor = storage.currentColor;
+		snapshot.spawnSerial = storage.spawnSerial;
+		snapshot.posX.resize(storage.GetCount());
+		snapshot.posY.resize(storage.GetCount());
+		snapshot.currentScale.resize(storage.GetCount());
+		snapshot.currentColor.resize(storage.GetCount());
+		snapshot.spawnSerial.resize(storage.GetCount());
+		snapshot.hits = std::move(hits);
+
+		if (workers == 0) {
+			serial = std::move(snapshot);
+			result.matchesSerial = true;
+		}
+		else {
+			bool matches = snapshot.posX.size() == serial.posX.size() &&
+				snapshot.hits.size() == serial.hits.size() &&
+				snapshot.currentColor == serial.currentColor &&
+				snapshot.spawnSerial == serial.spawnSerial;
+			for (size_t i = 0; matches && i < snapshot.posX.size(); ++i) {
+				matches = SameBits(snapshot.posX[i], serial.posX[i]) &&
+					SameBits(snapshot.posY[i], serial.posY[i]) &&
+					SameBits(snapshot.currentScale[i], serial.currentScale[i]);
+			}
+			for (size_t i = 0; matches && i < snapshot.hits.size(); ++i) {
+				matches = snapshot.hits[i].type == serial.hits[i].type &&
+					SameBits(snapshot.hits[i].position.x, serial.hits[i].position.x) &&
+					SameBits(snapshot.hits[i].position.y, serial.hits[i].position.y);
+			}
+			result.matchesSerial = matches;
+		}
+
+		results.push_back(result);
+	}
+
+	const double serialMs = results.empty() ? 0.0 : results.front().stepMs;
+	for (auto& r : results) {
+		r.speedup = r.stepMs > 0.0 ? serialMs / r.stepMs : 0.0;
+	}
+	return results;
+}
+
+void ParticleBenchmark::PrintThreadResults(const std::vector<ThreadResult>& results) {
+	Novice::ConsolePrintf("=== Particle Thread Scaling (ms/frame) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("%2d threads: %.3f ms  x%.2f  [%s]\n",
+			r.workerCount + 1, r.stepMs, r.speedup, r.matchesSerial ? "match" : "MISMATCH");
+	}
+}
+
+namespace {
+
+	// 比較に使う粒の状態（通し番号は生成のたびに進むので比べない）
+	struct EmitSnapshot {
+		std::vector<float> posX, posY, velX, velY, rotationSpeed, drawSize;
+		std::vector<float> lifeTimer;
+		std::vector<ParticleBehavior> behavior;
+
+		static EmitSnapshot Take(const ParticleStorage& storage) {
+			const int n = storage.GetCount();
+			EmitSnapshot s;
+			s.posX.assign(storage.posX.begin(), storage.posX.begin() + n);
+			s.posY.assign(storage.posY.begin(), storage.posY.begin() + n);
+			s.velX.assign(storage.velX.begin(), storage.velX.begin() + n);
+			s.velY.assign(storage.velY.begin(), storage.velY.begin() + n);
+			s.rotationSpeed.assign(storage.rotationSpeed.begin(), storage.rotationSpeed.begin() + n);
+			s.drawSize.assign(storage.drawSize.begin(), storage.drawSize.begin() + n);
+			s.lifeTimer.assign(storage.lifeTimer.begin(), storage.lifeTimer.begin() + n);
+			s.behavior.assign(storage.behavior.begin(), storage.behavior.begin() + n);
+			return s;
+		}
+
+		bool Matches(const EmitSnapshot& other) const {
+			if (posX.size() != other.posX.size() || lifeTimer != other.lifeTimer || behavior != other.behavior) {
+				return false;
+			}
+			for (size_t i = 0; i < posX.size(); ++i) {
+				if (!SameBits(posX[i], other.posX[i]) || !SameBits(posY[i], other.posY[i]) ||
+					!SameBits(velX[i], other.velX[i]) || !SameBits(velY[i], other.velY[i]) ||
+					!SameBits(rotationSpeed[i], other.rotationSpeed[i]) || !SameBits(drawSize[i], other.drawSize[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+}
+
+std::vector<ParticleBenchmark::EmitResult> ParticleBenchmark::RunEmitBenchmark(ParticleManager& manager, ParticleType type, int frames) {
+	std::vector<EmitResult> results;
+	const ParticleParam* param = manager.GetParam(type);
+	if (param == nullptr || param->count <= 0 || param->textureHandle < 0) {
+		Novice::ConsolePrintf("ParticleBenchmark::RunEmitBenchmark - type cannot emit\n");
+		return results;
+	}
+
+	const uint64_t seed = manager.GetRandomSeed();
+	const int pointCounts[] = { 16, 64, 256, 1024 };
+
+	for (int pointCount : pointCounts) {
+		// 上書きが起きると比較の意味が変わるので、プールに収まる数だけ
+		if (pointCount * param->count > manager.particles_.GetCapacity()) break;
+
+		// ボス撃破時のように、画面内に散らばった地点（固定の並び）
+		std::vector<Vector2> points(pointCount);
+		for (int i = 0; i < pointCount; ++i) {
+			points[i] = { 40.0f + static_cast<float>((i * 37) % 1200), 40.0f + static_cast<float>((i * 53) % 640) };
+		}
+
+		EmitResult result;
+		result.pointCount = pointCount;
+		result.particleCount = pointCount * param->count;
+
+		result.perCallMs = MeasureMs(frames, [&]() {
+			manager.Clear();
+			for (const Vector2& p : points) {
+				manager.Emit(type, p);
+			}
+		});
+		result.batchMs = MeasureMs(frames, [&]() {
+			manager.Clear();
+			manager.EmitBatch(type, points);
+		});
+		result.queuedMs = MeasureMs(frames, [&]() {
+			manager.Clear();
+			for (const Vector2& p : points) {
+				manager.QueueEmit(type, p);
+			}
+			manager.FlushEmitQueue();
+		});
+
+		// 同じシードから3通りで発生させて比べる
+		manager.SetRandomSeed(seed);
+		manager.Clear();
+		for (const Vector2& p : points) {
+			manager.Emit(type, p);
+		}
+		const EmitSnapshot perCall = EmitSnapshot::Take(manager.particles_);
+
+		manager.SetRandomSeed(seed);
+		manager.Clear();
+		manager.EmitBatch(type, points);
+		const EmitSnapshot batch = EmitSnapshot::Take(manager.particles_);
+
+		manager.SetRandomSeed(seed);
+		manager.Clear();
+		for (const Vector2& p : points) {
+			manager.QueueEmit(type, p);
+		}
+		manager.FlushEmitQueue();
+		const EmitSnapshot queued = EmitSnapshot::Take(manager.particles_);
+
+		result.matchesPerCall = perCall.Matches(batch) && perCall.Matches(queued);
+		results.push_back(result);
+	}
+
+	manager.Clear();
+	manager.SetRandomSeed(seed);
+	return results;
+}
+
+void ParticleBenchmark::PrintEmitResults(const std::vector<EmitResult>& results) {
+	Novice::ConsolePrintf("=== Particle Emit (ms/frame) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("%5d points (%5d particles): PerCall %.4f  Batch %.4f  Queued %.4f  [%s]\n",
+			r.pointCount, r.particleCount, r.perCallMs, r.batchMs, r.queuedMs,
+			r.matchesPerCall ? "match" : "MISMATCH");
+	}
+}
+
+ParticleBenchmark::WindResult ParticleBenchmark::RunWindBenchmark(int particleCount, int frames) {
+	const float dt = 1.0f / 60.0f;
+
+	WindResult result;
+	result.particleCount = particleCount;
+
+	ParticleFlowField flowField;
+	result.buildMs = MeasureMs(1, [&]() {
+		flowField.BuildCurlNoise(64, 64, 32.0f, 4, 2, 12345);
+	});
+
+	// 画面全体に散らばった雪
+	std::vector<ParticleSpawnDesc> descs = MakeSpawnDescs(particleCount);
+	ParticleStorage storage;
+	storage.Resize(particleCount);
+	for (int i = 0; i < particleCount; ++i) {
+		descs[i].life = 1000.0f;  // 計測中に消えないように
+		storage.Spawn(ParticleType::Snow, descs[i]);
+	}
+
+	float windStrength[kParticleTypeCount] = {};
+	windStrength[static_cast<int>(ParticleType::Snow)] = 30.0f;
+
+	// 旧版：sinf の横揺れ（風向きは位置の高さだけで決まり、縦には流れない）
+	result.legacySineMs = MeasureMs(frames, [&]() {
+		for (int i = 0; i < storage.GetCount(); ++i) {
+			storage.posX[i] += sinf(storage.posY[i] * 0.01f) * windStrength[static_cast<int>(ParticleType::Snow)] * dt;
+		}
+	});
+
+	Vector2 offset = { 0.0f, 0.0f };
+	result.flowFieldMs = MeasureMs(frames, [&]() {
+		offset.x += 40.0f * dt;
+		storage.ApplyWind(0, storage.GetCount(), dt, windStrength, &flowField, offset);
+	});
+	return result;
+}
+
+void ParticleBenchmark::PrintWindResult(const WindResult& result) {
+	Novice::ConsolePrintf("=== Particle Wind (%d snowflakes) ===\n", result.particleCount);
+	Novice::ConsolePrintf("Field build %.3f ms (once)  LegacySine %.4f  FlowField %.4f ms/step\n",
+		result.buildMs, result.legacySineMs, result.flowFieldMs);
+}
+
+std::vector<ParticleBenchmark::WorldResult> ParticleBenchmark::RunWorldCollisionBenchmark(int particleCount, int frames) {
+	const int kColliderCounts[] = { 64, 256, 1024 };
+
+	// 雨が 2560 x 1440 のステージに散らばった状態（全部が地形と判定する）
+	std::vector<ParticleSpawnDesc> descs = MakeSpawnDescs(particleCount);
+	for (int i = 0; i < particleCount; ++i) {
+		descs[i].position.x *= 2.0f;
+		descs[i].position.y *= 1.125f;
+		descs[i].life = 1000.0f;
+	}
+	ParticleWorldResponse responses[kParticleTypeCount] = {};
+	responses[static_cast<int>(ParticleType::Rain)].collide = true;
+
+	auto makeStorage = [&](ParticleStorage& storage) {
+		storage.Resize(particleCount);
+		for (int i = 0; i < particleCount; ++i) {
+			storage.Spawn(ParticleType::Rain, descs[i]);
+		}
+	};
+
+	std::vector<WorldResult> results;
+	for (int colliderCount : kColliderCounts) {
+		// 足場（矩形）と岩（円）を半々、固定の並びで置く
+		ParticleCollisionWorld world;
+		std::mt19937 engine(777);
+		std::uniform_real_distribution<float> px(-1280.0f, 1280.0f);
+		std::uniform_real_distribution<float> py(-720.0f, 720.0f);
+		std::uniform_real_distribution<float> size(16.0f, 96.0f);
+		std::uniform_real_distribution<float> angle(-0.5f, 0.5f);
+		for (int c = 0; c < colliderCount; ++c) {
+			if (c % 2 == 0) {
+				world.AddRect({ px(engine), py(engine) }, size(engine) * 2.0f, size(engine) * 0.5f, angle(engine));
+			}
+			else {
+				world.AddCircle({ px(engine), py(engine) }, size(engine) * 0.5f);
+			}
+		}
+
+		WorldResult result;
+		result.colliderCount = colliderCount;
+
+		ParticleStorage gridStorage;
+		makeStorage(gridStorage);
+		world.Build();
+		result.gridMs = MeasureMs(frames, [&]() {
+			gridStorage.ApplyWorldCollision(0, gridStorage.GetCount(), world, responses, nullptr);
+		});
+
+		ParticleStorage bruteStorage;
+		makeStorage(bruteStorage);
+		world.Build(1.0e9f);
+		result.bruteMs = MeasureMs(frames, [&]() {
+			bruteStorage.ApplyWorldCollision(0, bruteStorage.GetCount(), world, responses, nullptr);
+		});
+
+		// どちらも登録順に調べるので、結果はビット単位で同じになる
+		bool matches = gridStorage.GetCount() == bruteStorage.GetCount();
+		for (int i = 0; i < gridStorage.GetCount() && matches; ++i) {
+			matches = SameBits(gridStorage.posX[i], bruteStorage.posX[i]) &&
+				SameBits(gridStorage.posY[i], bruteStorage.posY[i]) &&
+				SameBits(gridStorage.velX[i], bruteStorage.velX[i]) &&
+				SameBits(gridStorage.velY[i], bruteStorage.velY[i]);
+		}
+		result.matchesBrute = matches;
+		results.push_back(result);
+	}
+	return results;
+}
+
+void ParticleBenchmark::PrintWorldResults(const std::vector<WorldResult>& results) {
+	Novice::ConsolePrintf("=== Particle World Collision (ms/step) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("%5d colliders: Grid %.4f  Brute %.4f  [%s]\n",
+			r.colliderCount, r.gridMs, r.bruteMs, r.matchesBrute ? "match" : "MISMATCH");
+	}
+}
+
+namespace {
+
+	// 軌跡の比較に使う動きと、旧方式の粒の撒き方
+	struct TrailScenario {
+		const char* name;
+		float speedMin, speedMax;      // 先頭の速さ（ワールド長/秒）
+		float moveTime;                // 先頭が動いている時間（秒）
+		float emitInterval;            // 旧方式：粒を撒く間隔（秒）
+		int emitCount;                 // 旧方式：1回に撒く粒の数
+		float lifeMin, lifeMax;        // 旧方式：粒の寿命（秒）
+		float spread;                  // 旧方式：粒の速さのばらつき
+		ParticleTrailSettings ribbon;  // 新方式の設定
+	};
+
+	struct LegacyTrailParticle {
+		Vector2 position;
+		Vector2 velocity;
+		float life;
+		float decayRate;
+	};
+
+	ParticleBenchmark::TrailResult RunTrailScenario(const TrailScenario& scenario, int trailCount) {
+		const float dt = 1.0f / 60.0f;
+		const Matrix3x3 vpMatrix = Matrix3x3::Identity();
+
+		std::mt19937 engine(2024);
+		std::uniform_real_distribution<float> speed(scenario.speedMin, scenario.speedMax);
+		std::uniform_real_distribution<float> angle(0.785f, 2.356f);  // 斜め下（45 〜 135 度）
+		std::uniform_real_distribution<float> startX(0.0f, 1280.0f);
+		std::uniform_real_distribution<float> spread(-scenario.spread, scenario.spread);
+		std::uniform_real_distribution<float> life(scenario.lifeMin, scenario.lifeMax);
+
+		std::vector<Vector2> heads(trailCount);
+		std::vector<Vector2> velocities(trailCount);
+		for (int t = 0; t < trailCount; ++t) {
+			heads[t] = { startX(engine), -50.0f };
+			const float a = angle(engine);
+			const float v = speed(engine);
+			velocities[t] = { std::cos(a) * v, std::sin(a) * v };
+		}
+
+		std::vector<std::vector<LegacyTrailParticle>> particles(trailCount);
+		std::vector<float> emitTimers(trailCount, 0.0f);
+		std::vector<ParticleTrail> ribbons(trailCount);
+		for (auto& ribbon : ribbons) {
+			ribbon.Reset(scenario.ribbon);
+		}
+
+		ParticleBenchmark::TrailResult result;
+		result.name = scenario.name;
+
+		long long particleQuadSum = 0;
+		long long ribbonQuadSum = 0;
+		int particleVisibleFrames = 0;
+		int ribbonVisibleFrames = 0;
+		double particleMs = 0.0;
+		double ribbonMs = 0.0;
+		int frames = 0;
+		volatile int sink = 0;  // 描画準備が最適化で消えないように
+
+		const int maxFrames = static_cast<int>((scenario.moveTime + scenario.lifeMax + scenario.ribbon.pointLifetime) / dt) + 2;
+		for (int f = 0; f < maxFrames; ++f) {
+			const bool moving = static_cast<float>(f) * dt < scenario.moveTime;
+			for (int t = 0; t < trailCount && moving; ++t) {
+				heads[t].x += velocities[t].x * dt;
+				heads[t].y += velocities[t].y * dt;
+			}
+
+			// 旧方式：一定間隔で粒を撒き、1粒ずつ動かして DrawComponent2D と同じ行列で四隅を変換する
+			int particleQuads = 0;
+			particleMs += MeasureMs(1, [&]() {
+				particleQuads = 0;
+				for (int t = 0; t < trailCount; ++t) {
+					std::vector<LegacyTrailParticle>& list = particles[t];
+					if (moving) {
+						emitTimers[t] -= dt;
+						if (emitTimers[t] <= 0.0f) {
+							for (int i = 0; i < scenario.emitCount; ++i) {
+								list.push_back({ heads[t], { spread(engine), spread(engine) }, 1.0f, 1.0f / life(engine) });
+							}
+							emitTimers[t] = scenario.emitInterval;
+						}
+					}
+
+					size_t alive = 0;
+					for (size_t i = 0; i < list.size(); ++i) {
+						LegacyTrailParticle p = list[i];
+						p.position.x += p.velocity.x * dt;
+						p.position.y += p.velocity.y * dt;
+						p.life -= p.decayRate * dt;
+						if (p.life <= 0.0f) continue;
+						list[alive++] = p;
+
+						const Matrix3x3 world = AffineMatrix2D::MakeAffine({ p.life, p.life }, 0.0f, p.position);
+						const Matrix3x3 m = Matrix3x3::Multiply(world, vpMatrix);
+						const Vector2 corner = Matrix3x3::Transform({ 8.0f, 8.0f }, m);
+						sink = sink + static_cast<int>(corner.x);
+					}
+					list.resize(alive);
+					particleQuads += static_cast<int>(alive);
+					result.particlePeakQuads = std::max(result.particlePeakQuads, static_cast<int>(alive));
+				}
+			});
+
+			// 新方式：先頭を Push して、帯の頂点を作る
+			int ribbonQuads = 0;
+			ribbonMs += MeasureMs(1, [&]() {
+				ribbonQuads = 0;
+				for (int t = 0; t < trailCount; ++t) {
+					if (moving) {
+						ribbons[t].Push(heads[t]);
+					}
+					ribbons[t].Update(dt);
+					const int quads = ribbons[t].Build(vpMatrix);
+					ribbonQuads += quads;
+					result.ribbonPeakQuads = std::max(result.ribbonPeakQuads, quads);
+				}
+			});
+
+			if (particleQuads > 0) {
+				particleQuadSum += particleQuads;
+				++particleVisibleFrames;
+			}
+			if (ribbonQuads > 0) {
+				ribbonQuadSum += ribbonQuads;
+				++ribbonVisibleFrames;
+			}
+			++frames;
+			if (!moving && particleQuads == 0 && ribbonQuads == 0) break;
+		}
+
+		if (particleVisibleFrames > 0) {
+			result.particleQuads = static_cast<double>(particleQuadSum) / (static_cast<double>(particleVisibleFrames) * trailCount);
+		}
+		if (ribbonVisibleFrames > 0) {
+			result.ribbonQuads = static_cast<double>(ribbonQuadSum) / (static_cast<double>(ribbonVisibleFrames) * trailCount);
+		}
+		result.particleMs = particleMs / frames;
+		result.ribbonMs = ribbonMs / frames;
+		return result;
+	}
+}
+
+std::vector<ParticleBenchmark::TrailResult> ParticleBenchmark::RunTrailBenchmark(int trailCount) {
+	trailCount = std::max(1, trailCount);
+
+	// 旧 NightSkyScene の流れ星：600 〜 1000 px/s で約1秒、16ms ごとに3粒（寿命 0.33 〜 0.67 秒）
+	TrailScenario shootingStar = { "Shooting star", 600.0f, 1000.0f, 1.0f, 0.016f, 3, 0.33f, 0.67f, 20.0f, {} };
+	shootingStar.ribbon.textureHandle = 0;
+	shootingStar.ribbon.maxPoints = 48;
+	shootingStar.ribbon.pointLifetime = 0.5f;
+	shootingStar.ribbon.minSegmentLength = 12.0f;
+	shootingStar.ribbon.widthStart = 4.0f;
+	shootingStar.ribbon.colorStart = 0xFFFFDDFF;
+	shootingStar.ribbon.colorEnd = 0x00FFFF00;
+
+	// 旧 EmitDashGhost：0.3 秒のダッシュ中に毎フレーム1粒（寿命 0.33 秒）
+	TrailScenario dash = { "Dash ghost", 900.0f, 900.0f, 0.3f, 1.0f / 60.0f, 1, 0.33f, 0.33f, 0.0f, {} };
+	dash.ribbon.textureHandle = 0;
+	dash.ribbon.blendMode = kBlendModeNormal;
+	dash.ribbon.pointLifetime = 0.33f;
+	dash.ribbon.minSegmentLength = 24.0f;
+	dash.ribbon.widthStart = 64.0f;
+	dash.ribbon.widthEnd = 51.2f;
+	dash.ribbon.colorStart = 0x8888FFFF;
+	dash.ribbon.colorEnd = 0x8888FF00;
+
+	return { RunTrailScenario(shootingStar, trailCount), RunTrailScenario(dash, trailCount) };
+}
+
+void ParticleBenchmark::PrintTrailResults(const std::vector<TrailResult>& results) {
+	Novice::ConsolePrintf("=== Particle Trail (DrawQuad per visual trail) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("%-14s Particles %6.1f (peak %4d)  Ribbon %6.1f (peak %4d)  %.4f -> %.4f ms/frame\n",
+			r.name.c_str(), r.particleQuads, r.particlePeakQuads, r.ribbonQuads, r.ribbonPeakQuads, r.particleMs, r.ribbonMs);
+	}
+}
+
+// ========================================
+// 記録の再生
+// ========================================
+
+std::vector<ParticleBenchmark::ReplayResult> ParticleBenchmark::RunReplayBenchmark(ParticleManager& manager) {
+	std::vector<ReplayResult> results;
+
+	for (const std::string& path : ParticleReplay::GetStandardLogPaths()) {
+		ParticleReplayLog log;
+		if (!log.Load(path)) {
+			Novice::ConsolePrintf("ParticleBenchmark::RunReplayBenchmark - failed to load %s\n", path.c_str());
+			continue;
+		}
+
+		const std::string name = std::filesystem::path(path).filename().string();
+		const ParticleReplay::Result first = ParticleReplay::Run(manager, log, name);
+
+		// 2回目は時間を計測に使わず、同じ記録から同じ状態になるかだけ確かめる
+		const ParticleReplay::Result second = ParticleReplay::Run(manager, log, name);
+
+		ReplayResult result;
+		result.name = first.name;
+		result.frames = first.frames;
+		result.updateP50Ms = first.updateP50Ms;
+		result.updateP99Ms = first.updateP99Ms;
+		result.drawPrepP50Ms = first.drawPrepP50Ms;
+		result.drawPrepP99Ms = first.drawPrepP99Ms;
+		result.peakLive = first.peakLive;
+		result.evicted = first.evicted;
+		result.dropped = first.dropped;
+		result.reproducible = first.stateHash == second.stateHash;
+		results.push_back(result);
+	}
+
+	return results;
+}
+
+void ParticleBenchmark::PrintReplayResults(const std::vector<ReplayResult>& results) {
+	Novice::ConsolePrintf("=== Particle Replay (ms/frame, p50 / p99) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("%-22s %5d frames  Update %.4f / %.4f  DrawPrep %.4f / %.4f  Peak %5d  Evicted %u  Dropped %u  [%s]\n",
+			r.name.c_str(), r.frames, r.updateP50Ms, r.updateP99Ms, r.drawPrepP50Ms, r.drawPrepP99Ms,
+			r.peakLive, r.evicted, r.dropped, r.reproducible ? "Reproducible" : "MISMATCH");
+	}
+}
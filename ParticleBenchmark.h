@@ -0,0 +1,160 @@
+﻿#pragma once
+#include "ParticleEnum.h"
+#include <vector>
+#include <string>
+
+class ParticleManager;
+
+/// <summary>
+/// パーティクル更新のベンチマーク
+/// 旧 AoS 版（Particle）と SoA 版（ParticleStorage）を同じ初期状態から回し、
+/// 1フレームあたりの更新時間と結果の一致を確認する。
+/// デバッグウィンドウのボタンから実行する想定（描画は行わない）
+/// </summary>
+class ParticleBenchmark {
+public:
+	struct Result {
+		int particleCount = 0;
+		double aosMs = 0.0;      // 旧 Particle::Update（1フレーム平均）
+		double scalarMs = 0.0;   // SoA スカラー
+		double sseMs = 0.0;      // SoA SSE（非対応ビルドでは 0）
+		double avxMs = 0.0;      // SoA AVX2（非対応ビルドでは 0）
+		bool matchesReference = false;  // 全粒の状態が AoS 版と一致したか
+	};
+
+	/// <summary>
+	/// 2k / 16k / 64k 粒で計測する
+	/// </summary>
+	/// <param name="frames">計測フレーム数</param>
+	static std::vector<Result> RunUpdateBenchmark(int frames = 120);
+
+	/// <summary>
+	/// 結果をコンソールに出力する
+	/// </summary>
+	static void PrintResults(const std::vector<Result>& results);
+
+	struct DrawResult {
+		int particleCount = 0;
+		double legacyMs = 0.0;   // 旧 Draw（タイプ × 全スロットの二重ループ、粒ごとに GetTextureSize）
+		double binnedMs = 0.0;   // ParticleDrawList::Build
+		int binCount = 0;        // SetBlendMode / テクスチャでまとめたビン数
+	};
+
+	/// <summary>
+	/// 描画準備（DrawQuad の直前まで）の時間を旧方式と比較する
+	/// </summary>
+	/// <param name="textureHandles">タイプごとに使うテクスチャ（読み込み済みのもの）</param>
+	/// <param name="frames">計測フレーム数</param>
+	static std::vector<DrawResult> RunDrawPrepBenchmark(const std::vector<int>& textureHandles, int frames = 120);
+
+	static void PrintDrawResults(const std::vector<DrawResult>& results);
+
+	struct ThreadResult {
+		int workerCount = 0;     // 呼び出し元以外のスレッド数（合計スレッド数は +1）
+		double stepMs = 0.0;     // StepRange（並列）+ RemoveDead（1フレーム平均）
+		double speedup = 0.0;    // ワーカー0 との比
+		bool matchesSerial = false;  // 粒の状態と地面ヒットの順序がワーカー0 と一致したか
+	};
+
+	/// <summary>
+	/// ParticleManager と同じ流れ（チャンク並列の StepRange → RemoveDead）で、
+	/// ワーカー数 0 〜 論理コア数 - 1 の更新時間を計測する
+	/// </summary>
+	/// <param name="particleCount">粒の数</param>
+	/// <param name="frames">計測フレーム数</param>
+	static std::vector<ThreadResult> RunThreadScalingBenchmark(int particleCount = 64 * 1024, int frames = 120);
+
+	static void PrintThreadResults(const std::vector<ThreadResult>& results);
+
+	struct EmitResult {
+		int pointCount = 0;      // 1フレームに発生させる地点数
+		int particleCount = 0;   // 生成される粒の数（地点数 × count）
+		double perCallMs = 0.0;  // 地点ごとに Emit
+		double batchMs = 0.0;    // EmitBatch 1回
+		double queuedMs = 0.0;   // QueueEmit を地点数ぶん + FlushEmitQueue
+		bool matchesPerCall = false;  // 同じシードで EmitBatch / 予約の結果が Emit と一致したか
+	};
+
+	/// <summary>
+	/// 地点ごとの Emit と EmitBatch / 予約発生の時間を比較する（16 / 64 / 256 / 1024 地点）
+	/// 計測のため manager の粒は消える（シードは元に戻す）
+	/// プールに収まらない地点数は計測しない
+	/// </summary>
+	/// <param name="type">発生させる種類</param>
+	/// <param name="frames">計測フレーム数</param>
+	static std::vector<EmitResult> RunEmitBenchmark(ParticleManager& manager, ParticleType type, int frames = 200);
+
+	static void PrintEmitResults(const std::vector<EmitResult>& results);
+
+	struct WindResult {
+		int particleCount = 0;
+		double buildMs = 0.0;      // カールノイズの流れ場を作る時間（起動時に1回）
+		double legacySineMs = 0.0; // 旧 sinf の横揺れ（1ステップ平均）
+		double flowFieldMs = 0.0;  // ParticleStorage::ApplyWind（流れ場の双線形補間、1ステップ平均）
+	};
+
+	/// <summary>
+	/// 雪 particleCount 粒に流れ場の風を当てる時間を計測する（10k 粒を 60fps で回せるかの確認用）
+	/// </summary>
+	static WindResult RunWindBenchmark(int particleCount = 10000, int frames = 240);
+
+	static void PrintWindResult(const WindResult& result);
+
+	struct WorldResult {
+		int colliderCount = 0;   // 円と矩形の合計
+		double gridMs = 0.0;     // 一様グリッドで引く（1ステップ平均）
+		double bruteMs = 0.0;    // 全形状を総当たり（グリッド1セル）
+		bool matchesBrute = false;  // 押し戻し後の位置・速度が総当たりと一致したか
+	};
+
+	/// <summary>
+	/// 地形との当たり判定の時間を、形状の数を変えて（64 / 256 / 1024）総当たりと比較する
+	/// </summary>
+	/// <param name="particleCount">粒の数</param>
+	/// <param name="frames">計測フレーム数</param>
+	static std::vector<WorldResult> RunWorldCollisionBenchmark(int particleCount = 16 * 1024, int frames = 60);
+
+	static void PrintWorldResults(const std::vector<WorldResult>& results);
+
+	struct TrailResult {
+		std::string name;              // 計測した見た目（流れ星の尾 / ダッシュ残像）
+		double particleQuads = 0.0;    // 旧方式（粒を撒く）の1本あたりの DrawQuad 枚数（見えている間の1フレーム平均）
+		int particlePeakQuads = 0;     // 同・最大
+		double ribbonQuads = 0.0;      // ParticleTrail の1本あたりの枚数（同上）
+		int ribbonPeakQuads = 0;
+		double particleMs = 0.0;       // 旧方式の更新 + 描画準備（全本数ぶん、1フレーム平均）
+		double ribbonMs = 0.0;         // ParticleTrail の Update + Build（同上）
+	};
+
+	/// <summary>
+	/// 流れ星の尾（旧 NightSkyScene：16ms ごとに3粒）とダッシュ残像（旧 EmitDashGhost：呼ぶたびに1粒）を、
+	/// 粒を撒く方式と軌跡（リボン）で同じ動きをさせ、1本の見た目に使う DrawQuad の枚数を比べる
+	/// （描画は行わない。枚数は描画準備の結果から数える）
+	/// </summary>
+	/// <param name="trailCount">同時に動かす本数</param>
+	static std::vector<TrailResult> RunTrailBenchmark(int trailCount = 32);
+
+	static void PrintTrailResults(const std::vector<TrailResult>& results);
+
+	struct ReplayResult {
+		std::string name;              // 記録のファイル名
+		int frames = 0;
+		double updateP50Ms = 0.0;      // ParticleManager::Update（1フレームの中央値）
+		double updateP99Ms = 0.0;
+		double drawPrepP50Ms = 0.0;    // ParticleManager::PrepareDraw（DrawQuad の直前まで）
+		double drawPrepP99Ms = 0.0;
+		int peakLive = 0;              // 最大同時生存数
+		unsigned int evicted = 0;      // 満杯で上書きされた粒の数
+		unsigned int dropped = 0;      // 満杯で生成できなかった粒の数
+		bool reproducible = false;     // 2回再生して最後の粒の状態が一致したか
+	};
+
+	/// <summary>
+	/// 同梱の記録（ParticleReplay::GetStandardLogPaths）を再生して、更新と描画準備の時間を計測する
+	/// 計測のため manager の粒・エミッターは消える（シード・固定ステップ・プールの方針・地面の高さは元に戻す）
+	/// 読めなかった記録は飛ばす
+	/// </summary>
+	static std::vector<ReplayResult> RunReplayBenchmark(ParticleManager& manager);
+
+	static void PrintReplayResults(const std::vector<ReplayResult>& results);
+};
@@ -0,0 +1,54 @@
+﻿#include "ParticleBudgetGovernor.h"
+#include <algorithm>
+
+#ifdef min
+#undef min
+#endif
+
+#ifdef max
+#undef max
+#endif
+
+float ParticleBudgetGovernor::GetBudgetMs() const {
+	return settings_.source == ParticleBudgetSource::FrameTime ? settings_.frameBudgetMs : settings_.particleBudgetMs;
+}
+
+void ParticleBudgetGovernor::Evaluate(float measuredMs, float deltaTime) {
+	lastMeasuredMs_ = std::max(0.0f, measuredMs);
+
+	// 1フレームだけの跳ねで絞らないよう指数移動平均で均す
+	if (!hasSample_) {
+		smoothedMs_ = lastMeasuredMs_;
+		hasSample_ = true;
+	}
+	else {
+		const float alpha = std::clamp(settings_.smoothing, 0.01f, 1.0f);
+		smoothedMs_ += (lastMeasuredMs_ - smoothedMs_) * alpha;
+	}
+
+	if (!settings_.enabled) {
+		scale_ = 1.0f;
+		return;
+	}
+
+	const float budget = std::max(0.01f, GetBudgetMs());
+	const float minScale = std::clamp(settings_.minScale, 0.0f, 1.0f);
+
+	if (smoothedMs_ > budget) {
+		// 超えた割合だけ下げる（2倍重ければ半分に）。すぐに効かせるため下げるのは一気に
+		++overBudgetFrames_;
+		scale_ = std::max(minScale, scale_ * (budget / smoothedMs_));
+	}
+	else if (smoothedMs_ < budget * settings_.recoverThreshold) {
+		// 戻すのはゆっくり（戻した途端にまた超える、の繰り返しを避ける）
+		scale_ = std::min(1.0f, scale_ + settings_.recoverPerSecond * std::max(0.0f, deltaTime));
+	}
+}
+
+void ParticleBudgetGovernor::Reset() {
+	scale_ = 1.0f;
+	smoothedMs_ = 0.0f;
+	lastMeasuredMs_ = 0.0f;
+	hasSample_ = false;
+	overBudgetFrames_ = 0;
+}
@@ -0,0 +1,71 @@
+﻿#pragma once
+
+/// <summary>
+/// 何を予算と比べるか
+/// </summary>
+enum class ParticleBudgetSource {
+	ParticleCost,  // ParticleManager が自分で測った Update + Draw の時間
+	FrameTime      // メインループから ReportFrameTime で渡されたフレーム時間
+};
+
+/// <summary>
+/// パーティクルの負荷に合わせて、装飾系の発生量を自動で絞る
+/// 毎フレーム測った時間（ミリ秒）を Evaluate に渡すと、平滑化した値が予算を超えている間は
+/// 発生量の倍率 scale を下げ、予算に余裕ができたら少しずつ 1 に戻す。
+/// 絞るのは優先度（ParticleParam::priority）が maxGovernedPriority 以下の種類だけで、
+/// kExemptPriority 以上（爆発・ヒットなどゲームプレイに関わる種類）は常に対象外
+/// </summary>
+class ParticleBudgetGovernor {
+public:
+	// この優先度以上の種類は絞らない
+	static constexpr int kExemptPriority = 2;
+
+	struct Settings {
+		bool enabled = true;
+		ParticleBudgetSource source = ParticleBudgetSource::ParticleCost;
+		float particleBudgetMs = 2.0f;     // ParticleCost のときの予算
+		float frameBudgetMs = 16.6f;       // FrameTime のときの予算
+		float minScale = 0.25f;            // 絞りきったときの倍率
+		float recoverPerSecond = 0.5f;     // 余裕があるとき 1 秒で戻す倍率
+		float recoverThreshold = 0.8f;     // 予算のこの割合を下回ったら戻し始める
+		float smoothing = 0.1f;            // 測定値の指数移動平均の係数（大きいほど敏感）
+		int maxGovernedPriority = 0;       // この優先度以下の種類を絞る（kExemptPriority 未満）
+	};
+
+	/// <summary>
+	/// 1フレーム分の測定値で倍率を更新する
+	/// </summary>
+	/// <param name="measuredMs">今フレームの時間（source に対応するもの）</param>
+	/// <param name="deltaTime">経過時間（秒、戻す速さに使う）</param>
+	void Evaluate(float measuredMs, float deltaTime);
+
+	// 倍率を 1 に戻し、平滑化もやり直す
+	void Reset();
+
+	/// <summary>
+	/// この優先度の種類を絞るか
+	/// </summary>
+	bool IsGoverned(int priority) const {
+		return settings_.enabled && priority <= settings_.maxGovernedPriority && priority < kExemptPriority;
+	}
+
+	// 絞っている最中か（倍率が 1 未満）
+	bool IsThrottling() const { return settings_.enabled && scale_ < 1.0f; }
+
+	Settings& GetSettings() { return settings_; }
+	const Settings& GetSettings() const { return settings_; }
+	float GetBudgetMs() const;
+
+	float GetScale() const { return settings_.enabled ? scale_ : 1.0f; }
+	float GetSmoothedMs() const { return smoothedMs_; }
+	float GetLastMeasuredMs() const { return lastMeasuredMs_; }
+	unsigned int GetOverBudgetFrames() const { return overBudgetFrames_; }  // 予算を超えたフレーム数（累計）
+
+private:
+	Settings settings_;
+	float scale_ = 1.0f;
+	float smoothedMs_ = 0.0f;
+	float lastMeasuredMs_ = 0.0f;
+	bool hasSample_ = false;
+	unsigned int overBudgetFrames_ = 0;
+};
@@ -0,0 +1,267 @@
+﻿#include "ParticleCollisionWorld.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef min
+#undef min
+#endif
+
+#ifdef max
+#undef max
+#endif
+
+// ========================================
+// 形状の登録
+// ========================================
+
+void ParticleCollisionWorld::AddCircle(const Vector2& center, float radius) {
+	Shape shape;
+	shape.isCircle = true;
+	shape.centerX = center.x;
+	shape.centerY = center.y;
+	shape.radius = std::max(0.0f, radius);
+	shape.minX = center.x - shape.radius;
+	shape.minY = center.y - shape.radius;
+	shape.maxX = center.x + shape.radius;
+	shape.maxY = center.y + shape.radius;
+	shapes_.push_back(shape);
+	dirty_ = true;
+}
+
+void ParticleCollisionWorld::AddRect(const Vector2& center, float width, float height, float angle) {
+	Shape shape;
+	shape.isCircle = false;
+	shape.centerX = center.x;
+	shape.centerY = center.y;
+	shape.halfWidth = std::max(0.0f, width * 0.5f);
+	shape.halfHeight = std::max(0.0f, height * 0.5f);
+	shape.cosAngle = std::cos(angle);
+	shape.sinAngle = std::sin(angle);
+
+	// 回転後の外接矩形
+	const float extentX = std::fabs(shape.cosAngle) * shape.halfWidth + std::fabs(shape.sinAngle) * shape.halfHeight;
+	const float extentY = std::fabs(shape.sinAngle) * shape.halfWidth + std::fabs(shape.cosAngle) * shape.halfHeight;
+	shape.minX = center.x - extentX;
+	shape.minY = center.y - extentY;
+	shape.maxX = center.x + extentX;
+	shape.maxY = center.y + extentY;
+	shapes_.push_back(shape);
+	dirty_ = true;
+}
+
+void ParticleCollisionWorld::SetTileMap(const Vector2& origin, float tileSize, int columns, int rows, const std::vector<uint8_t>& solid) {
+	if (columns <= 0 || rows <= 0 || tileSize <= 0.0f ||
+		solid.size() < static_cast<size_t>(columns) * rows) {
+		ClearTileMap();
+		return;
+	}
+	tileOrigin_ = origin;
+	tileSize_ = tileSize;
+	invTileSize_ = 1.0f / tileSize;
+	tileColumns_ = columns;
+	tileRows_ = rows;
+	tileSolid_.assign(solid.begin(), solid.begin() + static_cast<size_t>(columns) * rows);
+}
+
+void ParticleCollisionWorld::ClearTileMap() {
+	tileColumns_ = 0;
+	tileRows_ = 0;
+	tileSolid_.clear();
+}
+
+void ParticleCollisionWorld::Clear() {
+	shapes_.clear();
+	cellStart_.clear();
+	cellShapes_.clear();
+	gridWidth_ = 0;
+	gridHeight_ = 0;
+	dirty_ = false;
+	ClearTileMap();
+}
+
+// ========================================
+// グリッドの構築
+// ========================================
+
+void ParticleCollisionWorld::Build(float cellSize) {
+	dirty_ = false;
+	cellStart_.clear();
+	cellShapes_.clear();
+	gridWidth_ = 0;
+	gridHeight_ = 0;
+	if (shapes_.empty()) return;
+
+	// 1. 全形状の外接矩形
+	float minX = shapes_[0].minX, minY = shapes_[0].minY;
+	float maxX = shapes_[0].maxX, maxY = shapes_[0].maxY;
+	for (const Shape& shape : shapes_) {
+		minX = std::min(minX, shape.minX);
+		minY = std::min(minY, shape.minY);
+		maxX = std::max(maxX, shape.maxX);
+		maxY = std::max(maxY, shape.maxY);
+	}
+
+	// 2. セル数が上限を超えるならセルを大きくする
+	cellSize = std::max(1.0f, cellSize);
+	const float extent = std::max(maxX - minX, maxY - minY);
+	cellSize = std::max(cellSize, extent / static_cast<float>(kMaxGridCells));
+	cellSize_ = cellSize;
+	invCellSize_ = 1.0f / cellSize;
+	gridMinX_ = minX;
+	gridMinY_ = minY;
+	gridWidth_ = std::clamp(static_cast<int>((maxX - minX) * invCellSize_) + 1, 1, kMaxGridCells);
+	gridHeight_ = std::clamp(static_cast<int>((maxY - minY) * invCellSize_) + 1, 1, kMaxGridCells);
+
+	// 3. 各形状が重なるセルの範囲
+	auto cellRange = [this](const Shape& shape, int& x0, int& y0, int& x1, int& y1) {
+		x0 = std::clamp(static_cast<int>((shape.minX - gridMinX_) * invCellSize_), 0, gridWidth_ - 1);
+		y0 = std::clamp(static_cast<int>((shape.minY - gridMinY_) * invCellSize_), 0, gridHeight_ - 1);
+		x1 = std::clamp(static_cast<int>((shape.maxX - gridMinX_) * invCellSize_), 0, gridWidth_ - 1);
+		y1 = std::clamp(static_cast<int>((shape.maxY - gridMinY_) * invCellSize_), 0, gridHeight_ - 1);
+	};
+
+	// 4. 数えて先頭位置を決め、詰めて書き込む（登録順を保つ）
+	const int cellCount = gridWidth_ * gridHeight_;
+	cellStart_.assign(cellCount + 1, 0);
+	for (const Shape& shape : shapes_) {
+		int x0, y0, x1, y1;
+		cellRange(shape, x0, y0, x1, y1);
+		for (int y = y0; y <= y1; ++y) {
+			for (int x = x0; x <= x1; ++x) {
+				cellStart_[y * gridWidth_ + x + 1]++;
+			}
+		}
+	}
+	for (int c = 0; c < cellCount; ++c) {
+		cellStart_[c + 1] += cellStart_[c];
+	}
+
+	cellShapes_.resize(cellStart_[cellCount]);
+	std::vector<int> cursor(cellStart_.begin(), cellStart_.end() - 1);
+	for (int s = 0; s < static_cast<int>(shapes_.size()); ++s) {
+		int x0, y0, x1, y1;
+		cellRange(shapes_[s], x0, y0, x1, y1);
+		for (int y = y0; y <= y1; ++y) {
+			for (int x = x0; x <= x1; ++x) {
+				cellShapes_[cursor[y * gridWidth_ + x]++] = s;
+			}
+		}
+	}
+}
+
+// ========================================
+// 判定
+// ========================================
+
+bool ParticleCollisionWorld::Query(float x, float y, Contact& outContact) const {
+	if (gridWidth_ > 0) {
+		const float fx = (x - gridMinX_) * invCellSize_;
+		const float fy = (y - gridMinY_) * invCellSize_;
+		if (fx >= 0.0f && fy >= 0.0f && fx < static_cast<float>(gridWidth_) && fy < static_cast<float>(gridHeight_)) {
+			const int cell = static_cast<int>(fy) * gridWidth_ + static_cast<int>(fx);
+			for (int k = cellStart_[cell]; k < cellStart_[cell + 1]; ++k) {
+				if (QueryShape(shapes_[cellShapes_[k]], x, y, outContact)) {
+					return true;
+				}
+			}
+		}
+	}
+
+	return tileColumns_ > 0 && QueryTileMap(x, y, outContact);
+}
+
+bool ParticleCollisionWorld::QueryShape(const Shape& shape, float x, float y, Contact& outContact) {
+	// 外接矩形で先にふるい落とす
+	if (x < shape.minX || x > shape.maxX || y < shape.minY || y > shape.maxY) return false;
+
+	const float dx = x - shape.centerX;
+	const float dy = y - shape.centerY;
+
+	if (shape.isCircle) {
+		const float distanceSq = dx * dx + dy * dy;
+		if (distanceSq >= shape.radius * shape.radius) return false;
+
+		// 中心ちょうどなら上に押し出す
+		const float distance = std::sqrt(distanceSq);
+		const float nx = distance > 0.0001f ? dx / distance : 0.0f;
+		const float ny = distance > 0.0001f ? dy / distance : 1.0f;
+		outContact.normal = { nx, ny };
+		outContact.position = { shape.centerX + nx * shape.radius, shape.centerY + ny * shape.radius };
+		return true;
+	}
+
+	// 矩形のローカル座標に直す
+	const float localX = dx * shape.cosAngle + dy * shape.sinAngle;
+	const float localY = -dx * shape.sinAngle + dy * shape.cosAngle;
+	const float penetrationX = shape.halfWidth - std::fabs(localX);
+	const float penetrationY = shape.halfHeight - std::fabs(localY);
+	if (penetrationX <= 0.0f || penetrationY <= 0.0f) return false;
+
+	// めり込みが浅い方の辺に押し出す
+	float normalX = 0.0f;
+	float normalY = 0.0f;
+	float surfaceX = localX;
+	float surfaceY = localY;
+	if (penetrationX < penetrationY) {
+		normalX = localX >= 0.0f ? 1.0f : -1.0f;
+		surfaceX = normalX * shape.halfWidth;
+	}
+	else {
+		normalY = localY >= 0.0f ? 1.0f : -1.0f;
+		surfaceY = normalY * shape.halfHeight;
+	}
+
+	outContact.normal = {
+		normalX * shape.cosAngle - normalY * shape.sinAngle,
+		normalX * shape.sinAngle + normalY * shape.cosAngle
+	};
+	outContact.position = {
+		shape.centerX + surfaceX * shape.cosAngle - surfaceY * shape.sinAngle,
+		shape.centerY + surfaceX * shape.sinAngle + surfaceY * shape.cosAngle
+	};
+	return true;
+}
+
+bool ParticleCollisionWorld::IsSolidTile(int column, int row) const {
+	if (column < 0 || row < 0 || column >= tileColumns_ || row >= tileRows_) return false;
+	return tileSolid_[row * tileColumns_ + column] != 0;
+}
+
+bool ParticleCollisionWorld::QueryTileMap(float x, float y, Contact& outContact) const {
+	const float fx = (x - tileOrigin_.x) * invTileSize_;
+	const float fy = (y - tileOrigin_.y) * invTileSize_;
+	if (fx < 0.0f || fy < 0.0f) return false;
+
+	const int column = static_cast<int>(fx);
+	const int row = static_cast<int>(fy);
+	if (!IsSolidTile(column, row)) return false;
+
+	// 隣が空いている辺のうち、一番近い辺へ押し出す（壁の中へ押し込まないように）
+	const float left = fx - static_cast<float>(column);
+	const float bottom = fy - static_cast<float>(row);
+	struct Edge { float distance; float nx; float ny; bool open; };
+	const Edge edges[4] = {
+		{ 1.0f - bottom, 0.0f, 1.0f, !IsSolidTile(column, row + 1) },  // 上
+		{ bottom, 0.0f, -1.0f, !IsSolidTile(column, row - 1) },        // 下
+		{ left, -1.0f, 0.0f, !IsSolidTile(column - 1, row) },          // 左
+		{ 1.0f - left, 1.0f, 0.0f, !IsSolidTile(column + 1, row) },    // 右
+	};
+
+	int best = -1;
+	for (int e = 0; e < 4; ++e) {
+		if (!edges[e].open) continue;
+		if (best < 0 || edges[e].distance < edges[best].distance) best = e;
+	}
+	if (best < 0) {
+		// 周りが全部壁：上へ押し出す
+		best = 0;
+	}
+
+	const Edge& edge = edges[best];
+	outContact.normal = { edge.nx, edge.ny };
+	outContact.position = {
+		x + edge.nx * edge.distance * tileSize_,
+		y + edge.ny * edge.distance * tileSize_
+	};
+	return true;
+}
@@ -0,0 +1,105 @@
+﻿#pragma once
+#include "Vector2.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 粒と地形（動かない円・矩形・タイルマップ）の当たり判定
+/// 粒は点として扱い、Query は「点が形状の中に入っていたら表面まで押し戻した位置と法線」を返す。
+/// 円・矩形は粗い一様グリッドに登録しておき、粒1つにつき自分のセルの形状だけを調べる
+/// （粒の数に比例するコストで、形状が増えても1粒あたりの判定数はほぼ変わらない）。
+/// タイルマップはそれ自体がグリッドなので、番号を求めて直接引く。
+/// 形状を追加・削除したら Build で作り直す（ParticleManager は更新の前に自動で行う）
+/// </summary>
+class ParticleCollisionWorld {
+public:
+	// グリッドの既定のセルサイズ（ワールド長）
+	static constexpr float kDefaultCellSize = 128.0f;
+	// グリッドの1辺の最大セル数（広すぎる地形はセルを大きくして収める）
+	static constexpr int kMaxGridCells = 256;
+
+	struct Contact {
+		Vector2 position;  // 表面まで押し戻した位置
+		Vector2 normal;    // 表面の外向きの法線（長さ1）
+	};
+
+	// ========================================
+	// 形状の登録
+	// ========================================
+
+	void AddCircle(const Vector2& center, float radius);
+
+	/// <summary>
+	/// 矩形を追加（angle はラジアン、中心まわりの回転）
+	/// </summary>
+	void AddRect(const Vector2& center, float width, float height, float angle);
+
+	/// <summary>
+	/// タイルマップを設定する（1つだけ持てる）
+	/// origin はマップ左下の角、列は +X、行は +Y 方向に並ぶ。solid は行優先で 0 以外が壁
+	/// </summary>
+	void SetTileMap(const Vector2& origin, float tileSize, int columns, int rows, const std::vector<uint8_t>& solid);
+	void ClearTileMap();
+
+	// 全形状とタイルマップを消す
+	void Clear();
+
+	/// <summary>
+	/// 円・矩形のグリッドを作り直す
+	/// </summary>
+	void Build(float cellSize = kDefaultCellSize);
+	bool IsDirty() const { return dirty_; }
+
+	// ========================================
+	// 判定
+	// ========================================
+
+	/// <summary>
+	/// 点 (x, y) が地形の中にあれば押し戻し先を返す（複数に入っていたら最初に見つけたもの）
+	/// Build 後は読み取り専用なので、複数スレッドから同時に呼んでよい
+	/// </summary>
+	bool Query(float x, float y, Contact& outContact) const;
+
+	bool IsEmpty() const { return shapes_.empty() && tileColumns_ == 0; }
+	int GetShapeCount() const { return static_cast<int>(shapes_.size()); }
+	int GetGridWidth() const { return gridWidth_; }
+	int GetGridHeight() const { return gridHeight_; }
+	float GetCellSize() const { return cellSize_; }
+	bool HasTileMap() const { return tileColumns_ > 0; }
+
+private:
+	struct Shape {
+		bool isCircle = true;
+		float centerX = 0.0f;
+		float centerY = 0.0f;
+		float radius = 0.0f;                       // 円
+		float halfWidth = 0.0f, halfHeight = 0.0f; // 矩形
+		float cosAngle = 1.0f, sinAngle = 0.0f;
+		float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;  // 外接矩形
+	};
+
+	static bool QueryShape(const Shape& shape, float x, float y, Contact& outContact);
+	bool QueryTileMap(float x, float y, Contact& outContact) const;
+	bool IsSolidTile(int column, int row) const;
+
+	std::vector<Shape> shapes_;
+	bool dirty_ = false;
+
+	// 一様グリッド（セルごとの形状番号を詰めて持つ）
+	float cellSize_ = kDefaultCellSize;
+	float invCellSize_ = 1.0f / kDefaultCellSize;
+	float gridMinX_ = 0.0f;
+	float gridMinY_ = 0.0f;
+	int gridWidth_ = 0;
+	int gridHeight_ = 0;
+	std::vector<int> cellStart_;    // セル c の形状は cellShapes_[cellStart_[c], cellStart_[c + 1])
+	std::vector<int> cellShapes_;
+
+	// タイルマップ
+	Vector2 tileOrigin_ = { 0.0f, 0.0f };
+	float tileSize_ = 1.0f;
+	float invTileSize_ = 1.0f;
+	int tileColumns_ = 0;
+	int tileRows_ = 0;
+	std::vector<uint8_t> tileSolid_;
+};
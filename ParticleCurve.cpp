@@ -0,0 +1,89 @@
+﻿#include "ParticleCurve.h"
+#include <algorithm>
+
+namespace {
+
+	// time 順に並べたキーの中から t を挟む2つを探し、区間内の割合を返す
+	template <typename Key>
+	float FindSegment(const std::vector<Key>& keys, float t, size_t& outIndex) {
+		if (t <= keys.front().time) {
+			outIndex = 0;
+			return 0.0f;
+		}
+		for (size_t i = 1; i < keys.size(); ++i) {
+			if (t <= keys[i].time) {
+				outIndex = i - 1;
+				const float span = keys[i].time - keys[i - 1].time;
+				return span > 0.0f ? (t - keys[i - 1].time) / span : 1.0f;
+			}
+		}
+		outIndex = keys.size() - 1;
+		return 0.0f;
+	}
+
+	template <typename Key>
+	std::vector<Key> SortedKeys(const std::vector<Key>& keys) {
+		std::vector<Key> sorted = keys;
+		std::stable_sort(sorted.begin(), sorted.end(), [](const Key& a, const Key& b) {
+			return a.time < b.time;
+		});
+		return sorted;
+	}
+}
+
+float ParticleCurve::EvaluateScale(const std::vector<ParticleScaleKey>& keys, float t) {
+	if (keys.empty()) return 1.0f;
+
+	size_t index = 0;
+	const float f = FindSegment(keys, t, index);
+	if (index + 1 >= keys.size()) return keys[index].value;
+
+	const float a = keys[index].value;
+	const float b = keys[index + 1].value;
+	return a + (b - a) * f;
+}
+
+unsigned int ParticleCurve::EvaluateColor(const std::vector<ParticleColorKey>& keys, float t) {
+	if (keys.empty()) return 0xFFFFFFFF;
+
+	size_t index = 0;
+	const float f = FindSegment(keys, t, index);
+	if (index + 1 >= keys.size()) return keys[index].color;
+
+	return LerpColor(keys[index].color, keys[index + 1].color, f);
+}
+
+ParticleLifetimeLut ParticleCurve::Bake(const std::vector<ParticleScaleKey>& scaleKeys,
+	const std::vector<ParticleColorKey>& colorKeys) {
+	const std::vector<ParticleScaleKey> scales = SortedKeys(scaleKeys);
+	const std::vector<ParticleColorKey> colors = SortedKeys(colorKeys);
+
+	ParticleLifetimeLut lut;
+	for (int i = 0; i < kParticleLutSize; ++i) {
+		const float t = static_cast<float>(i) / static_cast<float>(kParticleLutSize - 1);
+		lut.scale[i] = EvaluateScale(scales, t);
+		lut.color[i] = EvaluateColor(colors, t);
+	}
+	return lut;
+}
+
+unsigned int ParticleCurve::LerpColor(unsigned int start, unsigned int end, float t) {
+	// RGBA各チャンネルを抽出
+	float sR = static_cast<float>((start >> 24) & 0xFF);
+	float sG = static_cast<float>((start >> 16) & 0xFF);
+	float sB = static_cast<float>((start >> 8) & 0xFF);
+	float sA = static_cast<float>(start & 0xFF);
+
+	float eR = static_cast<float>((end >> 24) & 0xFF);
+	float eG = static_cast<float>((end >> 16) & 0xFF);
+	float eB = static_cast<float>((end >> 8) & 0xFF);
+	float eA = static_cast<float>(end & 0xFF);
+
+	// 補間
+	unsigned int r = static_cast<unsigned int>(sR + (eR - sR) * t);
+	unsigned int g = static_cast<unsigned int>(sG + (eG - sG) * t);
+	unsigned int b = static_cast<unsigned int>(sB + (eB - sB) * t);
+	unsigned int a = static_cast<unsigned int>(sA + (eA - sA) * t);
+
+	return (r << 24) | (g << 16) | (b << 8) | a;
+}
@@ -0,0 +1,58 @@
+﻿#pragma once
+#include <array>
+#include <vector>
+
+// 寿命カーブを焼き込むテーブルの解像度
+constexpr int kParticleLutSize = 64;
+
+/// <summary>
+/// スケールカーブのキー（time は寿命の進行度 0.0 ～ 1.0）
+/// </summary>
+struct ParticleScaleKey {
+	float time = 0.0f;
+	float value = 1.0f;
+};
+
+/// <summary>
+/// 色カーブのキー（色は 0xRRGGBBAA）
+/// </summary>
+struct ParticleColorKey {
+	float time = 0.0f;
+	unsigned int color = 0xFFFFFFFF;
+};
+
+/// <summary>
+/// 寿命に対するスケール・色を焼き込んだテーブル
+/// 更新時は進行度から番号を1つ求めて読むだけになる
+/// </summary>
+struct ParticleLifetimeLut {
+	std::array<float, kParticleLutSize> scale{};
+	std::array<unsigned int, kParticleLutSize> color{};
+};
+
+/// <summary>
+/// 多点カーブの評価と焼き込み
+/// キーは time 順に並んでいなくてよい（評価時に並べ替えたものを使う）
+/// </summary>
+class ParticleCurve {
+public:
+	// 進行度 t（0.0 ～ 1.0）に対応するテーブルの番号（最も近い標本）
+	static int LutIndex(float t) {
+		return static_cast<int>(t * static_cast<float>(kParticleLutSize - 1) + 0.5f);
+	}
+
+	/// <summary>
+	/// カーブを評価する（最初のキーより前・最後のキーより後は端の値）
+	/// </summary>
+	static float EvaluateScale(const std::vector<ParticleScaleKey>& keys, float t);
+	static unsigned int EvaluateColor(const std::vector<ParticleColorKey>& keys, float t);
+
+	/// <summary>
+	/// テーブルに焼き込む（キーが空なら 1.0 / 白で埋める）
+	/// </summary>
+	static ParticleLifetimeLut Bake(const std::vector<ParticleScaleKey>& scaleKeys,
+		const std::vector<ParticleColorKey>& colorKeys);
+
+	// 2色を RGBA チャンネルごとに線形補間する（切り捨て）
+	static unsigned int LerpColor(unsigned int start, unsigned int end, float t);
+};
@@ -0,0 +1,199 @@
+﻿#include "ParticleDrawList.h"
+#include "ParticleStorage.h"
+#include "SpriteSheet.h"
+#include <algorithm>
+
+const ParticleDrawList::TextureSize& ParticleDrawList::GetTextureSize(int textureHandle) {
+	auto it = textureSizes_.find(textureHandle);
+	if (it == textureSizes_.end()) {
+		TextureSize size = { 0, 0 };
+		Novice::GetTextureSize(textureHandle, &size.width, &size.height);
+		it = textureSizes_.emplace(textureHandle, size).first;
+	}
+	return it->second;
+}
+
+int ParticleDrawList::FindOrAddBin(BlendMode blendMode, int textureHandle) {
+	// テクスチャハンドルは小さな連番なので (ブレンドモード, ハンドル) の表で引く
+	const int blendIndex = static_cast<int>(blendMode);
+	if (blendIndex >= 0 && blendIndex < kBlendModeCount && textureHandle >= 0) {
+		std::vector<int>& table = binLookup_[blendIndex];
+		if (textureHandle >= static_cast<int>(table.size())) {
+			table.resize(textureHandle + 1, -1);
+		}
+		if (table[textureHandle] < 0) {
+			const TextureSize& size = GetTextureSize(textureHandle);
+			bins_.push_back({ blendMode, textureHandle, size.width, size.height, 0, 0 });
+			table[textureHandle] = static_cast<int>(bins_.size()) - 1;
+		}
+		return table[textureHandle];
+	}
+
+	// 想定外のキーは線形探索
+	for (int b = 0; b < static_cast<int>(bins_.size()); ++b) {
+		if (bins_[b].blendMode == blendMode && bins_[b].textureHandle == textureHandle) {
+			return b;
+		}
+	}
+	const TextureSize& size = GetTextureSize(textureHandle);
+	bins_.push_back({ blendMode, textureHandle, size.width, size.height, 0, 0 });
+	return static_cast<int>(bins_.size()) - 1;
+}
+
+void ParticleDrawList::Build(const ParticleStorage& storage, const Matrix3x3& vpMatrix, const CullView* cullView) {
+	const int count = storage.GetCount();
+	bins_.clear();
+	binOfParticle_.resize(count);
+	culledCount_ = 0;
+	typeRejectedCount_ = 0;
+
+	// 1. 各粒のビンを決めて個数を数える（範囲外の粒は座標変換の前にここで捨てる）
+	int drawnCount = 0;
+	for (int i = 0; i < count; ++i) {
+		if (cullView != nullptr && cullView->rejectedTypes != nullptr &&
+			cullView->rejectedTypes[static_cast<int>(storage.type[i])]) {
+			binOfParticle_[i] = kCulledBin;
+			culledCount_++;
+			typeRejectedCount_++;
+			continue;
+		}
+
+		const int bin = FindOrAddBin(storage.blendMode[i], storage.textureHandle[i]);
+
+		if (cullView != nullptr) {
+			// 描画サイズ（ピクセル）をワールド長に直して、中心からの半径で判定
+			float baseSize = storage.drawSize[i];
+			if (baseSize <= 0.0f) {
+				const ParticleStorage::AnimState& anim = storage.anim[i];
+				baseSize = static_cast<float>(anim.sheet != nullptr ? anim.sheet->GetFrameWidth() : bins_[bin].texWidth);
+			}
+			const float half = baseSize * storage.currentScale[i] * 0.5f * cullView->worldPerPixel;
+			const float x = storage.posX[i];
+			const float y = storage.posY[i];
+			if (x + half < cullView->min.x || x - half > cullView->max.x ||
+				y + half < cullView->min.y || y - half > cullView->max.y) {
+				binOfParticle_[i] = kCulledBin;
+				culledCount_++;
+				continue;
+			}
+		}
+
+		bins_[bin].count++;
+		binOfParticle_[i] = static_cast<uint16_t>(bin);
+		drawnCount++;
+	}
+	quads_.resize(drawnCount);
+
+	// 表を次のフレーム用に空に戻す
+	for (const Bin& bin : bins_) {
+		const int blendIndex = static_cast<int>(bin.blendMode);
+		if (blendIndex >= 0 && blendIndex < kBlendModeCount && bin.textureHandle >= 0) {
+			binLookup_[blendIndex][bin.textureHandle] = -1;
+		}
+	}
+
+	// 2. 空でないビンを (blendMode, textureHandle) 順に並べ、開始位置を決める
+	//    （全粒がカリングされたビンはここで落とす）
+	binOrder_.clear();
+	for (int b = 0; b < static_cast<int>(bins_.size()); ++b) {
+		if (bins_[b].count > 0) {
+			binOrder_.push_back(b);
+		}
+	}
+	std::sort(binOrder_.begin(), binOrder_.end(), [this](int a, int b) {
+		if (bins_[a].blendMode != bins_[b].blendMode) return bins_[a].blendMode < bins_[b].blendMode;
+		return bins_[a].textureHandle < bins_[b].textureHandle;
+	});
+
+	const int binCount = static_cast<int>(binOrder_.size());
+	std::vector<Bin>& sorted = sortedBins_;
+	sorted.resize(binCount);
+	binRemap_.resize(bins_.size());
+	writeCursor_.resize(binCount);
+	int offset = 0;
+	for (int b = 0; b < binCount; ++b) {
+		Bin& bin = sorted[b];
+		bin = bins_[binOrder_[b]];
+		binRemap_[binOrder_[b]] = b;
+		bin.begin = offset;
+		offset += bin.count;
+		writeCursor_[b] = bin.begin;
+	}
+	bins_.swap(sorted);
+
+	// 3. 画面座標に変換しながらビンに振り分ける（ビン内は元の並び順を保つ）
+	for (int i = 0; i < count; ++i) {
+		if (binOfParticle_[i] == kCulledBin) continue;
+
+		const int b = binRemap_[binOfParticle_[i]];
+		const Bin& bin = bins_[b];
+		Quad& q = quads_[writeCursor_[b]++];
+
+		// 行列演算でスクリーン座標に変換
+		Vector2 screenPos = Matrix3x3::Transform({ storage.posX[i], storage.posY[i] }, vpMatrix);
+
+		// アニメーション使用時はシートの矩形表から引く
+		const ParticleStorage::AnimState& anim = storage.anim[i];
+		if (anim.sheet != nullptr) {
+			const SpriteFrameRect& frame = anim.sheet->GetFrame(anim.currentFrame);
+			q.srcX = frame.x;
+			q.srcY = frame.y;
+			q.srcW = frame.w;
+			q.srcH = frame.h;
+		}
+		else {
+			q.srcX = 0;
+			q.srcY = 0;
+			q.srcW = bin.texWidth;
+			q.srcH = bin.texHeight;
+		}
+
+		// 描画サイズ（0なら1フレーム分のサイズを使用）
+		float baseSize = storage.drawSize[i];
+		if (baseSize <= 0.0f) {
+			baseSize = static_cast<float>(q.srcW);
+		}
+
+		// スケール適用後のサイズ、中心座標基準
+		float drawSize = baseSize * storage.currentScale[i];
+		float offsetX = screenPos.x - drawSize * 0.5f;
+		float offsetY = screenPos.y - drawSize * 0.5f;
+
+		q.left = static_cast<int>(offsetX);
+		q.top = static_cast<int>(offsetY);
+		q.right = static_cast<int>(offsetX + drawSize);
+		q.bottom = static_cast<int>(offsetY + drawSize);
+		q.color = storage.currentColor[i];
+	}
+}
+
+void ParticleDrawList::Submit() const {
+	bool hasBlendMode = false;
+	BlendMode currentBlendMode = kBlendModeNormal;
+
+	for (const Bin& bin : bins_) {
+		// ビンはブレンドモード順なので、切り替えはモードが変わるときだけ
+		if (!hasBlendMode || bin.blendMode != currentBlendMode) {
+			Novice::SetBlendMode(bin.blendMode);
+			currentBlendMode = bin.blendMode;
+			hasBlendMode = true;
+		}
+
+		for (int i = bin.begin; i < bin.begin + bin.count; ++i) {
+			const Quad& q = quads_[i];
+			Novice::DrawQuad(
+				q.left, q.top,       // 左上
+				q.right, q.top,      // 右上
+				q.left, q.bottom,    // 左下
+				q.right, q.bottom,   // 右下
+				q.srcX, q.srcY,
+				q.srcW, q.srcH,
+				bin.textureHandle,
+				q.color
+			);
+		}
+	}
+
+	// デフォルトに戻す
+	Novice::SetBlendMode(kBlendModeNormal);
+}
@@ -0,0 +1,97 @@
+﻿#pragma once
+#include "Novice.h"
+#include "Matrix3x3.h"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+class ParticleStorage;
+
+/// <summary>
+/// パーティクルの描画リスト
+/// 生存中の粒を (blendMode, textureHandle) ごとのビンに1回で振り分け（カウンティングソート）、
+/// ビン単位で SetBlendMode を呼んでまとめて描画する。
+/// ビンはキー順、ビン内はストレージ上の並び順なので描画順は決定的。
+/// </summary>
+class ParticleDrawList {
+public:
+	// 画面座標に変換済みの1枚分
+	struct Quad {
+		int left, top, right, bottom;
+		int srcX, srcY, srcW, srcH;
+		unsigned int color;
+	};
+
+	// 同じブレンドモード・テクスチャの粒のまとまり
+	struct Bin {
+		BlendMode blendMode;
+		int textureHandle;
+		int texWidth;
+		int texHeight;
+		int begin;  // quads_ 内の開始位置
+		int count;
+	};
+
+	// 描画しない粒のビン番号
+	static const uint16_t kCulledBin = 0xFFFF;
+
+	// カリング範囲（ワールド座標）
+	struct CullView {
+		Vector2 min;                 // Camera2D::GetViewRect の範囲
+		Vector2 max;
+		float worldPerPixel = 1.0f;  // 画面1ピクセルあたりのワールド長（= ズーム）
+		const uint8_t* rejectedTypes = nullptr;  // ParticleType ごと、非0ならその種類を丸ごと捨てる
+	};
+
+	/// <summary>
+	/// ストレージから描画リストを作る（Novice の描画は呼ばない）
+	/// </summary>
+	/// <param name="cullView">nullptr ならカリングしない。指定時は座標変換の前に範囲外の粒を捨てる</param>
+	void Build(const ParticleStorage& storage, const Matrix3x3& vpMatrix, const CullView* cullView = nullptr);
+
+	/// <summary>
+	/// 作った描画リストを描画する
+	/// </summary>
+	void Submit() const;
+
+	const std::vector<Bin>& GetBins() const { return bins_; }
+	const std::vector<Quad>& GetQuads() const { return quads_; }
+
+	// 直前の Build で描画する / 捨てた粒の数
+	int GetDrawnCount() const { return static_cast<int>(quads_.size()); }
+	int GetCulledCount() const { return culledCount_; }
+	int GetTypeRejectedCount() const { return typeRejectedCount_; }
+
+	// テクスチャサイズのキャッシュを破棄する（テクスチャを読み直したとき用）
+	void ClearTextureSizeCache() { textureSizes_.clear(); }
+
+private:
+	struct TextureSize {
+		int width;
+		int height;
+	};
+
+	// テクスチャサイズを取得（初回のみ Novice に問い合わせる）
+	const TextureSize& GetTextureSize(int textureHandle);
+	// キーに対応するビン番号（無ければ作る）
+	int FindOrAddBin(BlendMode blendMode, int textureHandle);
+
+	std::vector<Bin> bins_;
+	std::vector<Quad> quads_;
+
+	// 作業用（フレームをまたいで使い回す）
+	std::vector<Bin> sortedBins_;
+	std::vector<int> binOrder_;
+	std::vector<uint16_t> binOfParticle_;
+	std::vector<int> binRemap_;
+	std::vector<int> writeCursor_;
+
+	// (ブレンドモード, テクスチャハンドル) → ビン番号（未使用は -1）
+	static const int kBlendModeCount = kBlendModeExclusion + 1;
+	std::vector<int> binLookup_[kBlendModeCount];
+
+	std::unordered_map<int, TextureSize> textureSizes_;
+
+	int culledCount_ = 0;        // 範囲外で捨てた粒（種類ごとの棄却を含む）
+	int typeRejectedCount_ = 0;  // そのうち種類ごとの外接矩形で捨てた粒
+};
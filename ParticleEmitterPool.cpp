@@ -0,0 +1,107 @@
+﻿#include "ParticleEmitterPool.h"
+
+EmitterHandle ParticleEmitterPool::Create(ParticleType type) {
+	uint32_t slotIndex = 0;
+	if (!freeSlots_.empty()) {
+		slotIndex = freeSlots_.back();
+		freeSlots_.pop_back();
+	}
+	else {
+		slotIndex = static_cast<uint32_t>(slots_.size());
+		slots_.push_back(Slot{});
+	}
+
+	Slot& slot = slots_[slotIndex];
+	slot.dense = static_cast<int32_t>(emitters_.size());
+
+	Emitter emitter;
+	emitter.type = type;
+	emitters_.push_back(emitter);
+	timers_.push_back(0.0f);
+	types_.push_back(static_cast<uint8_t>(type));
+	slotOfDense_.push_back(slotIndex);
+
+	return { slotIndex, slot.generation };
+}
+
+bool ParticleEmitterPool::Destroy(EmitterHandle handle) {
+	const int dense = FindDense(handle);
+	if (dense < 0) return false;
+
+	// 末尾と入れ替えて詰める
+	const int last = GetCount() - 1;
+	if (dense != last) {
+		emitters_[dense] = emitters_[last];
+		timers_[dense] = timers_[last];
+		types_[dense] = types_[last];
+		slotOfDense_[dense] = slotOfDense_[last];
+		slots_[slotOfDense_[dense]].dense = dense;
+	}
+	emitters_.pop_back();
+	timers_.pop_back();
+	types_.pop_back();
+	slotOfDense_.pop_back();
+
+	// 世代を進めて古いハンドルを無効にする
+	Slot& slot = slots_[handle.index];
+	slot.dense = -1;
+	slot.generation = (slot.generation + 1 == 0) ? 1 : slot.generation + 1;
+	freeSlots_.push_back(handle.index);
+	return true;
+}
+
+void ParticleEmitterPool::Clear() {
+	while (!emitters_.empty()) {
+		Destroy(HandleAt(GetCount() - 1));
+	}
+}
+
+ParticleEmitterPool::Emitter* ParticleEmitterPool::Get(EmitterHandle handle) {
+	const int dense = FindDense(handle);
+	return dense >= 0 ? &emitters_[dense] : nullptr;
+}
+
+const ParticleEmitterPool::Emitter* ParticleEmitterPool::Get(EmitterHandle handle) const {
+	const int dense = FindDense(handle);
+	return dense >= 0 ? &emitters_[dense] : nullptr;
+}
+
+float ParticleEmitterPool::GetTimer(EmitterHandle handle) const {
+	const int dense = FindDense(handle);
+	return dense >= 0 ? timers_[dense] : 0.0f;
+}
+
+void ParticleEmitterPool::ResetTimer(EmitterHandle handle) {
+	const int dense = FindDense(handle);
+	if (dense >= 0) timers_[dense] = 0.0f;
+}
+
+EmitterHandle ParticleEmitterPool::HandleAt(int denseIndex) const {
+	const uint32_t slotIndex = slotOfDense_[denseIndex];
+	return { slotIndex, slots_[slotIndex].generation };
+}
+
+void ParticleEmitterPool::Advance(float deltaTime, const float* intervalByType, std::vector<int>& fired) {
+	fired.clear();
+	const int count = GetCount();
+	float* timers = timers_.data();
+	const uint8_t* types = types_.data();
+
+	for (int i = 0; i < count; ++i) {
+		const float interval = intervalByType[types[i]];
+		if (interval < 0.0f) continue;
+
+		timers[i] += deltaTime;
+		if (timers[i] >= interval) {
+			timers[i] -= interval;
+			fired.push_back(i);
+		}
+	}
+}
+
+int ParticleEmitterPool::FindDense(EmitterHandle handle) const {
+	if (handle.index >= slots_.size()) return -1;
+	const Slot& slot = slots_[handle.index];
+	if (slot.generation != handle.generation) return -1;
+	return slot.dense;
+}
@@ -0,0 +1,92 @@
+﻿#pragma once
+#include "Vector2.h"
+#include "ParticleEnum.h"
+#include "FastRandom.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// エミッターのハンドル
+/// スロット番号と世代の組で、止めたエミッターのハンドルは同じスロットが再利用されても無効のまま
+/// </summary>
+struct EmitterHandle {
+	static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+	uint32_t index = kInvalidIndex;
+	uint32_t generation = 0;
+
+	// 一度でも発行されたハンドルか（生きているかは ParticleEmitterPool::IsAlive で確認する）
+	bool IsValid() const { return index != kInvalidIndex; }
+
+	bool operator==(const EmitterHandle& other) const = default;
+};
+
+/// <summary>
+/// 連続発生エミッターのプール（数に上限なし）
+/// 生きているエミッターは常に [0, GetCount()) に詰めて持ち、止めたら末尾と入れ替える。
+/// タイマーと種類は別の連続配列に分けてあるので、Advance は全エミッターを1本のループで回せる。
+/// 外からはハンドルで指し、配列上の番号（dense index）は削除のたびに変わりうる
+/// </summary>
+class ParticleEmitterPool {
+public:
+	// タイマー以外のデータ（発生するときだけ触る）
+	struct Emitter {
+		ParticleType type = ParticleType::Explosion;
+		Vector2 position = { 0.0f, 0.0f };                     // 基準位置
+		EmitterFollowMode followMode = EmitterFollowMode::None; // 追従モード
+		const Vector2* followTarget = nullptr;                  // 追従対象（プレイヤー位置など。エミッターより長く生きること）
+		const Vector2* target = nullptr;                        // Homing用ターゲット（同上）
+		FastRandom random;       // このエミッター専用の乱数
+		uint64_t streamId = 0;   // 乱数のシードを作るときの番号
+	};
+
+	/// <summary>
+	/// エミッターを作る（タイマーは0から）
+	/// </summary>
+	EmitterHandle Create(ParticleType type);
+
+	/// <summary>
+	/// エミッターを止める（無効・停止済みのハンドルなら false）
+	/// </summary>
+	bool Destroy(EmitterHandle handle);
+	void Clear();
+
+	bool IsAlive(EmitterHandle handle) const { return FindDense(handle) >= 0; }
+	int GetCount() const { return static_cast<int>(emitters_.size()); }
+
+	// ハンドルから引く（無効なら nullptr）
+	Emitter* Get(EmitterHandle handle);
+	const Emitter* Get(EmitterHandle handle) const;
+	float GetTimer(EmitterHandle handle) const;
+	void ResetTimer(EmitterHandle handle);
+
+	// 配列上の番号で引く（[0, GetCount())）
+	Emitter& At(int denseIndex) { return emitters_[denseIndex]; }
+	const Emitter& At(int denseIndex) const { return emitters_[denseIndex]; }
+	float TimerAt(int denseIndex) const { return timers_[denseIndex]; }
+	EmitterHandle HandleAt(int denseIndex) const;
+
+	/// <summary>
+	/// 全エミッターのタイマーを進め、発生間隔を超えたものの番号を fired に積む（配列順）
+	/// 1フレームに発生するのは1エミッター1回まで
+	/// </summary>
+	/// <param name="intervalByType">ParticleType ごとの発生間隔（負ならその種類は止めておく）</param>
+	void Advance(float deltaTime, const float* intervalByType, std::vector<int>& fired);
+
+private:
+	struct Slot {
+		uint32_t generation = 1;  // 0 は既定のハンドルと区別するため使わない
+		int32_t dense = -1;       // 配列上の番号（-1 なら空き）
+	};
+
+	int FindDense(EmitterHandle handle) const;
+
+	std::vector<Slot> slots_;
+	std::vector<uint32_t> freeSlots_;
+
+	// 配列上の番号で並ぶデータ（Advance はこの2本だけを触る）
+	std::vector<float> timers_;
+	std::vector<uint8_t> types_;
+	std::vector<uint32_t> slotOfDense_;
+	std::vector<Emitter> emitters_;
+};
@@ -19,6 +19,15 @@ enum class EmitterShape {
 	Rectangle   // 矩形（エリア全体）
 };
 
+/// <summary>
+/// エミッターの追従モード
+/// </summary>
+enum class EmitterFollowMode {
+	None,           // 固定位置（発生時の座標で固定）
+	FollowTarget,   // ターゲット追従（プレイヤーなど）
+	WorldPoint      // ワールド座標の固定点
+};
+
 /// <summary>
 /// エフェクトの種類
 /// </summary>
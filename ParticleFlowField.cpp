@@ -0,0 +1,213 @@
+﻿#include "ParticleFlowField.h"
+#include "FastRandom.h"
+#include "JsonUtil.h"
+#include <algorithm>
+
+#ifdef min
+#undef min
+#endif
+
+#ifdef max
+#undef max
+#endif
+
+namespace {
+
+	// 周期 period の格子に勾配を置いたノイズ（Perlin）。格子は period ごとに繰り返す
+	class PeriodicGradientNoise {
+	public:
+		PeriodicGradientNoise(int period, uint64_t seed) : period_(std::max(1, period)) {
+			FastRandom random(seed);
+			const int count = period_ * period_;
+			gradX_.resize(count);
+			gradY_.resize(count);
+			for (int i = 0; i < count; ++i) {
+				const float angle = random.RandomFloat(0.0f, 6.28318531f);
+				gradX_[i] = std::cos(angle);
+				gradY_[i] = std::sin(angle);
+			}
+		}
+
+		// u, v は格子単位の座標（[0, period) の範囲を想定）
+		float Evaluate(float u, float v) const {
+			const float floorU = std::floor(u);
+			const float floorV = std::floor(v);
+			const int i0 = Wrap(static_cast<int>(floorU));
+			const int j0 = Wrap(static_cast<int>(floorV));
+			const int i1 = Wrap(i0 + 1);
+			const int j1 = Wrap(j0 + 1);
+			const float fu = u - floorU;
+			const float fv = v - floorV;
+
+			const float n00 = Dot(i0, j0, fu, fv);
+			const float n10 = Dot(i1, j0, fu - 1.0f, fv);
+			const float n01 = Dot(i0, j1, fu, fv - 1.0f);
+			const float n11 = Dot(i1, j1, fu - 1.0f, fv - 1.0f);
+
+			const float su = Fade(fu);
+			const float sv = Fade(fv);
+			const float nx0 = n00 + (n10 - n00) * su;
+			const float nx1 = n01 + (n11 - n01) * su;
+			return nx0 + (nx1 - nx0) * sv;
+		}
+
+	private:
+		int Wrap(int value) const {
+			const int m = value % period_;
+			return m < 0 ? m + period_ : m;
+		}
+
+		float Dot(int i, int j, float dx, float dy) const {
+			const int index = j * period_ + i;
+			return gradX_[index] * dx + gradY_[index] * dy;
+		}
+
+		static float Fade(float t) {
+			return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+		}
+
+		int period_;
+		std::vector<float> gradX_;
+		std::vector<float> gradY_;
+	};
+}
+
+void ParticleFlowField::Resize(int width, int height, float cellSize) {
+	width_ = std::max(1, width);
+	height_ = std::max(1, height);
+	cellSize_ = std::max(0.001f, cellSize);
+	invCellSize_ = 1.0f / cellSize_;
+	velX_.assign(static_cast<size_t>(width_) * height_, 0.0f);
+	velY_.assign(static_cast<size_t>(width_) * height_, 0.0f);
+}
+
+void ParticleFlowField::Clear() {
+	width_ = 0;
+	height_ = 0;
+	velX_.clear();
+	velY_.clear();
+}
+
+void ParticleFlowField::BuildCurlNoise(int width, int height, float cellSize, int period, int octaves, uint64_t seed) {
+	Resize(width, height, cellSize);
+	period = std::max(1, period);
+	octaves = std::max(1, octaves);
+
+	// 1. ポテンシャル ψ を格子点ごとに求める（周期がセル数で割り切れるので場の端でつながる）
+	std::vector<float> potential(velX_.size(), 0.0f);
+	float amplitude = 1.0f;
+	for (int o = 0; o < octaves; ++o) {
+		const int octavePeriod = period << o;
+		PeriodicGradientNoise noise(octavePeriod, FastRandom::DeriveSeed(seed, static_cast<uint64_t>(o)));
+		const float scaleU = static_cast<float>(octavePeriod) / static_cast<float>(width_);
+		const float scaleV = static_cast<float>(octavePeriod) / static_cast<float>(height_);
+		for (int y = 0; y < height_; ++y) {
+			for (int x = 0; x < width_; ++x) {
+				potential[y * width_ + x] += noise.Evaluate(static_cast<float>(x) * scaleU, static_cast<float>(y) * scaleV) * amplitude;
+			}
+		}
+		amplitude *= 0.5f;
+	}
+
+	// 2. カール（∂ψ/∂y, -∂ψ/∂x）を中心差分で求める（端は反対側とつなぐ）
+	float maxLengthSq = 0.0f;
+	for (int y = 0; y < height_; ++y) {
+		const int up = Wrap(y + 1, height_) * width_;
+		const int down = Wrap(y - 1, height_) * width_;
+		for (int x = 0; x < width_; ++x) {
+			const int right = Wrap(x + 1, width_);
+			const int left = Wrap(x - 1, width_);
+			const float dPsiDx = (potential[y * width_ + right] - potential[y * width_ + left]) * 0.5f;
+			const float dPsiDy = (potential[up + x] - potential[down + x]) * 0.5f;
+
+			const int index = y * width_ + x;
+			velX_[index] = dPsiDy;
+			velY_[index] = -dPsiDx;
+			maxLengthSq = std::max(maxLengthSq, dPsiDx * dPsiDx + dPsiDy * dPsiDy);
+		}
+	}
+
+	// 3. 最大の速さが 1 になるように正規化（強さは種類ごとの windStrength で掛ける）
+	if (maxLengthSq > 0.0f) {
+		const float scale = 1.0f / std::sqrt(maxLengthSq);
+		for (size_t i = 0; i < velX_.size(); ++i) {
+			velX_[i] *= scale;
+			velY_[i] *= scale;
+		}
+	}
+}
+
+bool ParticleFlowField::LoadFromJson(const nlohmann::json& j) {
+	try {
+		const int width = JsonUtil::GetValue<int>(j, "width", 0);
+		const int height = JsonUtil::GetValue<int>(j, "height", 0);
+		const float cellSize = JsonUtil::GetValue<float>(j, "cellSize", 32.0f);
+		if (width <= 0 || height <= 0 || cellSize <= 0.0f || !j.contains("vectors") || !j["vectors"].is_array()) {
+#ifdef _DEBUG
+			Novice::ConsolePrintf("ParticleFlowField: Invalid field header\n");
+#endif
+			return false;
+		}
+
+		const nlohmann::json& vectors = j["vectors"];
+		if (vectors.size() != static_cast<size_t>(width) * height) {
+#ifdef _DEBUG
+			Novice::ConsolePrintf("ParticleFlowField: Expected %d vectors, got %d\n",
+				width * height, static_cast<int>(vectors.size()));
+#endif
+			return false;
+		}
+
+		// 読み終えるまで今の場は残す
+		std::vector<float> velX(vectors.size());
+		std::vector<float> velY(vectors.size());
+		for (size_t i = 0; i < vectors.size(); ++i) {
+			const nlohmann::json& v = vectors[i];
+			if (!v.is_array() || v.size() < 2) {
+#ifdef _DEBUG
+				Novice::ConsolePrintf("ParticleFlowField: Vector %d is not [x, y]\n", static_cast<int>(i));
+#endif
+				return false;
+			}
+			velX[i] = v[0].get<float>();
+			velY[i] = v[1].get<float>();
+		}
+
+		Resize(width, height, cellSize);
+		velX_.swap(velX);
+		velY_.swap(velY);
+		return true;
+	}
+	catch (const std::exception& e) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticleFlowField: Failed to load field: %s\n", e.what());
+#endif
+		return false;
+	}
+}
+
+nlohmann::json ParticleFlowField::ToJson() const {
+	nlohmann::json j;
+	j["width"] = width_;
+	j["height"] = height_;
+	j["cellSize"] = cellSize_;
+
+	nlohmann::json vectors = nlohmann::json::array();
+	for (size_t i = 0; i < velX_.size(); ++i) {
+		vectors.push_back({ velX_[i], velY_[i] });
+	}
+	j["vectors"] = vectors;
+	return j;
+}
+
+bool ParticleFlowField::LoadFromFile(const std::string& filepath) {
+	nlohmann::json j;
+	if (!JsonUtil::LoadFromFile(filepath, j)) {
+		return false;
+	}
+	return LoadFromJson(j);
+}
+
+bool ParticleFlowField::SaveToFile(const std::string& filepath) const {
+	return JsonUtil::SaveToFile(filepath, ToJson(), 0);
+}
@@ -0,0 +1,107 @@
+﻿#pragma once
+#include "Vector2.h"
+#include "json.hpp"
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 風の流れ場（2D グリッドに速度ベクトルを焼き込んだもの）
+/// 起動時に1回だけ作り、更新中は Sample で双線形補間して読むだけにする。
+/// 場は上下左右につながっていて（タイル状）、範囲外の座標は折り返して読む。
+/// 作り方は2通り：
+///   - BuildCurlNoise：周期的なノイズのカール（発散が無いので粒が一点に集まらない）
+///   - LoadFromJson：手で作ったグリッド（{"width","height","cellSize","vectors":[[x,y],...]}）
+/// </summary>
+class ParticleFlowField {
+public:
+	/// <summary>
+	/// タイル状のカールノイズで場を作る（最大の速さが 1 になるよう正規化）
+	/// </summary>
+	/// <param name="width">横のセル数</param>
+	/// <param name="height">縦のセル数</param>
+	/// <param name="cellSize">1セルのワールド長</param>
+	/// <param name="period">場1枚あたりのノイズの周期数（大きいほど細かい渦）</param>
+	/// <param name="octaves">重ねるノイズの数</param>
+	/// <param name="seed">ノイズのシード</param>
+	void BuildCurlNoise(int width, int height, float cellSize, int period, int octaves, uint64_t seed);
+
+	/// <summary>
+	/// JSON から読み込む（形式が不正なら false で、場は変更しない）
+	/// </summary>
+	bool LoadFromJson(const nlohmann::json& j);
+	nlohmann::json ToJson() const;
+
+	bool LoadFromFile(const std::string& filepath);
+	bool SaveToFile(const std::string& filepath) const;
+
+	void Clear();
+	bool IsEmpty() const { return velX_.empty(); }
+
+	int GetWidth() const { return width_; }
+	int GetHeight() const { return height_; }
+	float GetCellSize() const { return cellSize_; }
+
+	// セルの速度（範囲外の番号は折り返す）
+	Vector2 GetCell(int x, int y) const {
+		const int index = Wrap(y, height_) * width_ + Wrap(x, width_);
+		return { velX_[index], velY_[index] };
+	}
+
+	/// <summary>
+	/// ワールド座標の速度を双線形補間で求める（場が空なら 0）
+	/// </summary>
+	void Sample(float x, float y, float& outX, float& outY) const {
+		if (velX_.empty()) {
+			outX = 0.0f;
+			outY = 0.0f;
+			return;
+		}
+
+		const float fx = x * invCellSize_;
+		const float fy = y * invCellSize_;
+		const float floorX = std::floor(fx);
+		const float floorY = std::floor(fy);
+		const float tx = fx - floorX;
+		const float ty = fy - floorY;
+
+		const int x0 = Wrap(static_cast<int>(floorX), width_);
+		const int y0 = Wrap(static_cast<int>(floorY), height_);
+		const int x1 = (x0 + 1 == width_) ? 0 : x0 + 1;
+		const int row0 = y0 * width_;
+		const int row1 = ((y0 + 1 == height_) ? 0 : y0 + 1) * width_;
+
+		const float* vx = velX_.data();
+		const float* vy = velY_.data();
+		const float topX = vx[row0 + x0] + (vx[row0 + x1] - vx[row0 + x0]) * tx;
+		const float bottomX = vx[row1 + x0] + (vx[row1 + x1] - vx[row1 + x0]) * tx;
+		const float topY = vy[row0 + x0] + (vy[row0 + x1] - vy[row0 + x0]) * tx;
+		const float bottomY = vy[row1 + x0] + (vy[row1 + x1] - vy[row1 + x0]) * tx;
+		outX = topX + (bottomX - topX) * ty;
+		outY = topY + (bottomY - topY) * ty;
+	}
+
+	Vector2 Sample(const Vector2& position) const {
+		Vector2 v = { 0.0f, 0.0f };
+		Sample(position.x, position.y, v.x, v.y);
+		return v;
+	}
+
+private:
+	static int Wrap(int value, int size) {
+		const int m = value % size;
+		return m < 0 ? m + size : m;
+	}
+
+	void Resize(int width, int height, float cellSize);
+
+	int width_ = 0;
+	int height_ = 0;
+	float cellSize_ = 1.0f;
+	float invCellSize_ = 1.0f;
+
+	// セルごとの速度（行優先、x と y は別の配列）
+	std::vector<float> velX_;
+	std::vector<float> velY_;
+};
@@ -2,10 +2,14 @@
 #include <cmath>
 #include <cstdlib>
 #include <algorithm>
+#include <map>
+#include <chrono>
 #include "JsonUtil.h"
 #include "json.hpp"
 #include "Camera2D.h"
 #include "Effect.h"
+#include "ParticlePresetCache.h"
+#include "SpriteSheet.h"
 
 // nlohmann/json の警告を抑制
 #pragma warning(push)
@@ -32,16 +36,53 @@ using nlohmann::json;
 static const float kDeg2Rad = 3.14159265f / 180.0f;
 // デフォルトのパラメータファイルパス
 static const std::string kDefaultParamPath = "Resources/Data/particle_params.json";
+// パラメータファイルの形式（1: 寿命がフレーム数、2: 寿命が秒）
+static const int kParamsFormatVersion = 2;
+// 形式1の寿命を秒に直すときのフレームレート
+static const float kLegacyFramesPerSecond = 60.0f;
+// 風の流れ場（ファイルが無ければカールノイズで作る）
+static const std::string kDefaultFlowFieldPath = "Resources/Data/flow_field.json";
+static const int kFlowFieldCells = 64;         // 縦横のセル数
+static const float kFlowFieldCellSize = 32.0f; // 1セルのワールド長（場1枚 = 2048 x 2048）
+static const int kFlowFieldPeriod = 4;         // 場1枚あたりの渦の周期
+static const int kFlowFieldOctaves = 2;
 
 ParticleManager::ParticleManager() {
+	particles_.Resize(kMaxParticles);
+	SetRandomSeed(FastRandom::kDefaultSeed);
 	LoadCommonResources();  // 先にテクスチャをロード
 
-	// JSONからパラメータを読み込み（ファイルがなければデフォルトで作成）
-	if (!LoadParamsFromJson(kDefaultParamPath)) {
+	// コンパイル済みキャッシュが JSON より新しければそれを読む（JSON の解析を省く）
+	// 無い・古い・壊れているときは JSON から読み（ファイルがなければデフォルトで作成）、キャッシュを作り直す
+	if (!LoadParamsFromCache(GetParamsCachePath(kDefaultParamPath), kDefaultParamPath) &&
+		!LoadParamsFromJson(kDefaultParamPath)) {
 		// 読み込み失敗時はデフォルトパラメータを設定して保存
 		LoadParams();
 		SaveParamsToJson(kDefaultParamPath);
 	}
+
+	// 風の流れ場は起動時に1回だけ作る
+	if (!LoadFlowFieldFromJson(kDefaultFlowFieldPath)) {
+		BuildCurlNoiseFlowField(FastRandom::kDefaultSeed);
+	}
+}
+
+bool ParticleManager::LoadFlowFieldFromJson(const std::string& filepath) {
+	if (!flowField_.LoadFromFile(filepath)) {
+		return false;
+	}
+	flowOffset_ = { 0.0f, 0.0f };
+#ifdef _DEBUG
+	Novice::ConsolePrintf("ParticleManager: Flow field loaded from %s (%d x %d)\n",
+		filepath.c_str(), flowField_.GetWidth(), flowField_.GetHeight());
+#endif
+	return true;
+}
+
+void ParticleManager::BuildCurlNoiseFlowField(uint64_t seed) {
+	flowField_.BuildCurlNoise(kFlowFieldCells, kFlowFieldCells, kFlowFieldCellSize,
+		kFlowFieldPeriod, kFlowFieldOctaves, seed);
+	flowOffset_ = { 0.0f, 0.0f };
 }
 
 // ブレンドモード変換ヘルパー
@@ -58,6 +99,34 @@ const char* ParticleManager::BlendModeToString(BlendMode mode) {
 	}
 }
 
+const char* ParticleManager::ParticleTypeToString(ParticleType type) {
+	switch (type) {
+	case ParticleType::Explosion: return "Explosion";
+	case ParticleType::Debris: return "Debris";
+	case ParticleType::Hit: return "Hit";
+	case ParticleType::Dust: return "Dust";
+	case ParticleType::MuzzleFlash: return "MuzzleFlash";
+	case ParticleType::Rain: return "Rain";
+	case ParticleType::Snow: return "Snow";
+	case ParticleType::Orb: return "Orb";
+	case ParticleType::Charge: return "Charge";
+	case ParticleType::Glow: return "Glow";
+	case ParticleType::Shockwave: return "Shockwave";
+	case ParticleType::Sparkle: return "Sparkle";
+	case ParticleType::Slash: return "Slash";
+	case ParticleType::SmokeCloud: return "SmokeCloud";
+	default: return "Unknown";
+	}
+}
+
+ParticleType ParticleManager::StringToParticleType(const std::string& str, ParticleType fallback) {
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		ParticleType type = static_cast<ParticleType>(i);
+		if (str == ParticleTypeToString(type)) return type;
+	}
+	return fallback;
+}
+
 BlendMode ParticleManager::StringToBlendMode(const std::string& str) {
 	if (str == "None") return kBlendModeNone;
 	if (str == "Normal") return kBlendModeNormal;
@@ -69,12 +138,33 @@ BlendMode ParticleManager::StringToBlendMode(const std::string& str) {
 	return kBlendModeNormal;
 }
 
+int ParticleManager::GetDefaultPriority(ParticleType type) {
+	switch (type) {
+	// ゲームプレイに関わる手応え系は残す
+	case ParticleType::Explosion:
+	case ParticleType::Hit:
+	case ParticleType::MuzzleFlash:
+	case ParticleType::Charge:
+	case ParticleType::Shockwave:
+	case ParticleType::Slash:
+		return 2;
+	// 装飾系は真っ先に消してよい
+	case ParticleType::Dust:
+	case ParticleType::Sparkle:
+	case ParticleType::SmokeCloud:
+	case ParticleType::Orb:
+		return 0;
+	default:
+		return 1;
+	}
+}
+
 void ParticleManager::LoadParams() {
 	// 1. 爆発（加算ブレンドで明るく光る）
 	ParticleParam explosion;
 	explosion.count = 1;
-	explosion.lifeMin = 40;
-	explosion.lifeMax = 40;
+	explosion.lifeMin = 0.67f;
+	explosion.lifeMax = 0.67f;
 	explosion.speedMin = 0.0f;
 	explosion.speedMax = 0.0f;
 	explosion.angleBase = 0.0f;
@@ -101,8 +191,8 @@ void ParticleManager::LoadParams() {
 	// 2. デブリ（通常ブレンド）
 	ParticleParam debris;
 	debris.count = 10;
-	debris.lifeMin = 40;
-	debris.lifeMax = 60;
+	debris.lifeMin = 0.67f;
+	debris.lifeMax = 1.0f;
 	debris.speedMin = 150.0f;
 	debris.speedMax = 300.0f;
 	debris.angleBase = 0.0f;
@@ -129,8 +219,8 @@ void ParticleManager::LoadParams() {
 	// 3. ヒットエフェクト（加算ブレンド）
 	ParticleParam hit;
 	hit.count = 18;
-	hit.lifeMin = 15;
-	hit.lifeMax = 55;
+	hit.lifeMin = 0.25f;
+	hit.lifeMax = 0.92f;
 	hit.speedMin = 225.0f;
 	hit.speedMax = 280.0f;
 	hit.angleBase = 90.0f;
@@ -157,8 +247,8 @@ void ParticleManager::LoadParams() {
 	// 4. 土煙（通常ブレンド）
 	ParticleParam dust;
 	dust.count = 8;
-	dust.lifeMin = 30;
-	dust.lifeMax = 45;
+	dust.lifeMin = 0.5f;
+	dust.lifeMax = 0.75f;
 	dust.speedMin = 50.0f;
 	dust.speedMax = 100.0f;
 	dust.angleBase = -90.0f;
@@ -185,8 +275,8 @@ void ParticleManager::LoadParams() {
 	// 5. マズルフラッシュ（加算ブレンド）
 	ParticleParam muzzle;
 	muzzle.count = 1;
-	muzzle.lifeMin = 8;
-	muzzle.lifeMax = 12;
+	muzzle.lifeMin = 0.13f;
+	muzzle.lifeMax = 0.2f;
 	muzzle.speedMin = 0.0f;
 	muzzle.speedMax = 0.0f;
 	muzzle.angleBase = 0.0f;
@@ -213,8 +303,8 @@ void ParticleManager::LoadParams() {
 	// ★6. 雨（連続発生 - 改良版）
 	ParticleParam rain;
 	rain.count = 30;                           // 1回の発生数
-	rain.lifeMin = 120;
-	rain.lifeMax = 180;
+	rain.lifeMin = 2.0f;
+	rain.lifeMax = 3.0f;
 	rain.speedMin = 0.0f;
 	rain.speedMax = 0.0f;
 	rain.angleBase = -90.0f;                   // 下向き（Y+が上なので-90度）
@@ -236,13 +326,15 @@ void ParticleManager::LoadParams() {
 	rain.isContinuous = true;
 	rain.emitInterval = 0.1f;                  // 0.1秒ごとに発生
 	rain.bounceDamping = 0.3f;                 // ★跳ね返り係数
+	rain.windStrength = 20.0f;                 // 流れ場の風の強さ（落下が速いので少し流れる程度）
+	rain.useCoarseBounds = true;               // 画面外の雨はまとめて捨てる
 	params_[ParticleType::Rain] = rain;
 
 	// ★7. 雪（連続発生 - 改良版）
 	ParticleParam snow;
 	snow.count = 50;
-	snow.lifeMin = 180;
-	snow.lifeMax = 240;
+	snow.lifeMin = 3.0f;
+	snow.lifeMax = 4.0f;
 	snow.speedMin = 0.0f;
 	snow.speedMax = 0.0f;
 	snow.angleBase = -90.0f;                   // 下向き
@@ -263,14 +355,15 @@ void ParticleManager::LoadParams() {
 	snow.blendMode = kBlendModeNormal;
 	snow.isContinuous = true;
 	snow.emitInterval = 0.15f;
-	snow.windStrength = 30.0f;                 // ★横風の強さ
+	snow.windStrength = 30.0f;                 // ★流れ場の風の強さ
+	snow.useCoarseBounds = true;
 	params_[ParticleType::Snow] = snow;
 
 	// ★8. オーブ（ふわふわ浮遊 - 改良版）
 	ParticleParam orb;
 	orb.count = 5;                             // 少なめに変更
-	orb.lifeMin = 300;                         // 長寿命
-	orb.lifeMax = 360;
+	orb.lifeMin = 5.0f;                         // 長寿命
+	orb.lifeMax = 6.0f;
 	orb.speedMin = 0.0f;
 	orb.speedMax = 0.0f;
 	orb.angleBase = 0.0f;
@@ -293,13 +386,14 @@ void ParticleManager::LoadParams() {
 	orb.emitInterval = 0.2f;
 	orb.floatAmplitude = 30.0f;                // ★浮遊の振幅
 	orb.floatFrequency = 1.0f;                 // ★浮遊の周波数
+	orb.windStrength = 15.0f;                  // 流れ場の風でゆっくり漂う
 	params_[ParticleType::Orb] = orb;
 
 	// ★9. チャージ（Homing）
 	ParticleParam charge;
 	charge.count = 5;
-	charge.lifeMin = 30;
-	charge.lifeMax = 60;
+	charge.lifeMin = 0.5f;
+	charge.lifeMax = 1.0f;
 	charge.speedMin = 50.0f;
 	charge.speedMax = 100.0f;
 	charge.angleBase = 0.0f;
@@ -323,9 +417,8 @@ void ParticleManager::LoadParams() {
 
 	// 10. Glow (汎用の光・オーラ)
 	ParticleParam glow;
-	glow.textureHandle = texGlow_; // ※LoadCommonResourcesで上書きされますが念のため
 	glow.count = 1;
-	glow.lifeMin = 20; glow.lifeMax = 40;
+	glow.lifeMin = 0.33f; glow.lifeMax = 0.67f;
 	glow.scaleStart = 1.0f; glow.scaleEnd = 0.0f;
 	glow.colorStart = 0xFFFFFFFF;
 	glow.colorEnd = 0xFFFFFF00;
@@ -335,9 +428,8 @@ void ParticleManager::LoadParams() {
 
 	// 11. Shockwave (衝撃波リング)
 	ParticleParam ring;
-	ring.textureHandle = texRing_;
 	ring.count = 1;
-	ring.lifeMin = 15; ring.lifeMax = 20;
+	ring.lifeMin = 0.25f; ring.lifeMax = 0.33f;
 	ring.scaleStart = 0.5f; ring.scaleEnd = 2.5f; // 急激に広がる
 	ring.colorStart = 0xFFFFFFCC;
 	ring.colorEnd = 0xFFFFFF00;
@@ -347,9 +439,8 @@ void ParticleManager::LoadParams() {
 
 	// 12. Sparkle (キラキラ)
 	ParticleParam spark;
-	spark.textureHandle = texSparkle_;
 	spark.count = 3;
-	spark.lifeMin = 30; spark.lifeMax = 50;
+	spark.lifeMin = 0.5f; spark.lifeMax = 0.83f;
 	spark.scaleStart = 0.8f; spark.scaleEnd = 0.0f;
 	spark.colorStart = 0xFFFF80FF;
 	spark.colorEnd = 0xFFFF8000;
@@ -361,9 +452,8 @@ void ParticleManager::LoadParams() {
 
 	// 13. Slash (斬撃・軌跡)
 	ParticleParam slash;
-	slash.textureHandle = texScratch_;
 	slash.count = 1;
-	slash.lifeMin = 10; slash.lifeMax = 15;
+	slash.lifeMin = 0.17f; slash.lifeMax = 0.25f;
 	slash.scaleStart = 1.5f; slash.scaleEnd = 0.5f;
 	slash.colorStart = 0xFFFFFFFF;
 	slash.colorEnd = 0xFFFFFF00;
@@ -373,366 +463,585 @@ void ParticleManager::LoadParams() {
 
 	// 14. SmokeCloud (もくもく煙)
 	ParticleParam smoke;
-	smoke.textureHandle = texSmoke_;
 	smoke.count = 2;
-	smoke.lifeMin = 60; smoke.lifeMax = 90;
+	smoke.lifeMin = 1.0f; smoke.lifeMax = 1.5f;
 	smoke.scaleStart = 0.5f; smoke.scaleEnd = 1.5f;
 	smoke.colorStart = 0x808080DD; // 灰色
 	smoke.colorEnd = 0x00000000;
 	smoke.speedMin = 20.0f; smoke.speedMax = 50.0f;
 	smoke.gravity = { 0.0f, 100.0f }; // 上へ昇る
+	smoke.windStrength = 25.0f;       // 流れ場の風でたなびく
 	smoke.blendMode = kBlendModeNormal;
 	params_[ParticleType::SmokeCloud] = smoke;
+
+	// 満杯時の優先度とテクスチャ
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		ParticleType type = static_cast<ParticleType>(i);
+		params_[type].priority = GetDefaultPriority(type);
+		params_[type].texturePath = GetDefaultTexturePath(type);
+	}
+
+	ResolveTextures();
+	BakeAllLifetimeCurves();
 }
 
 
 void ParticleManager::Update(float deltaTime) {
-	// 連続発生の処理（追従モード対応）
-	for (auto& [type, emitter] : continuousEmitters_) {
-		if (!emitter.isActive) continue;
-		if (params_.find(type) == params_.end()) continue;
+	if (recorder_.IsRecording()) {
+		RecordFollowTargets();
+		recorder_.RecordUpdate(deltaTime);
+	}
 
-		const ParticleParam& param = params_[type];
-		if (!param.isContinuous) continue;
+	// 設定ファイルの更新を一定間隔で確認する
+	if (hotReloadEnabled_) {
+		hotReloadTimer_ += deltaTime;
+		if (hotReloadTimer_ >= kHotReloadInterval) {
+			hotReloadTimer_ = 0.0f;
+			ReloadParamsIfChanged();
+		}
+	}
 
-		// タイマー更新
-		emitter.timer += deltaTime;
+	// 前のフレームの負荷で、このフレームの発生量の倍率を決める
+	if (governor_.GetSettings().source == ParticleBudgetSource::FrameTime) {
+		if (reportedFrameMs_ >= 0.0f) {
+			governor_.Evaluate(reportedFrameMs_, deltaTime);
+		}
+	}
+	else {
+		governor_.Evaluate(lastUpdateMs_ + lastDrawMs_, deltaTime);
+	}
 
-		// 発生間隔を超えたら発生
-		if (emitter.timer >= param.emitInterval) {
-			emitter.timer -= param.emitInterval;
+	const auto updateStart = std::chrono::steady_clock::now();
 
-			// ★追従モードに応じた位置計算
-			Vector2 emitPos = emitter.position;
-			if (emitter.followMode == EmitterFollowMode::FollowTarget && emitter.followTarget != nullptr) {
-				emitPos = *emitter.followTarget;
+	// 前のフレームに予約された発生をまとめて処理
+	FlushQueuedEmits();
 
-				// ★環境パーティクルの場合、画面上端から発生
-				if (type == ParticleType::Rain || type == ParticleType::Snow) {
-					emitPos.y += 360.0f;  // 画面上端
-				}
-			}
+	// 固定ステップで進める（フレームレートに関係なく、寿命・移動・発生間隔が同じ刻みで進む）
+	stepAccumulator_ += std::max(0.0f, deltaTime);
+	int steps = static_cast<int>(stepAccumulator_ / fixedStep_);
+	if (steps > maxSubSteps_) {
+		// 追いつけない分は捨てる（処理落ちしたフレームの次がさらに重くなるのを防ぐ）
+		skippedSteps_ += static_cast<unsigned int>(steps - maxSubSteps_);
+		steps = maxSubSteps_;
+		stepAccumulator_ = std::fmod(stepAccumulator_, fixedStep_);
+	}
+	else {
+		stepAccumulator_ -= static_cast<float>(steps) * fixedStep_;
+	}
 
-			// ターゲットがあればEmitWithTarget、なければEmit
-			if (emitter.target != nullptr) {
-				EmitWithTarget(type, emitPos, emitter.target);
-			}
-			else {
-				Emit(type, emitPos);
-			}
+	lastSubSteps_ = steps;
+	for (int s = 0; s < steps; ++s) {
+		Step(fixedStep_);
+	}
+
+	// 軌跡は見た目だけなので固定ステップではなくフレームの時間で進める
+	trails_.Update(std::max(0.0f, deltaTime));
+
+	lastUpdateMs_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - updateStart).count();
+}
+
+void ParticleManager::SetFixedStep(float step) {
+	// 極端な値で1フレームのステップ数が爆発しないよう 1/1000 秒 〜 1/10 秒に収める
+	fixedStep_ = std::clamp(step, 0.001f, 0.1f);
+	stepAccumulator_ = 0.0f;
+}
+
+void ParticleManager::SetMaxSubSteps(int count) {
+	maxSubSteps_ = std::max(1, count);
+}
+
+void ParticleManager::Step(float deltaTime) {
+	// 連続発生の処理（追従モード対応）
+	// タイマーは全エミッターぶんを1本のループで進め、発生間隔を超えたものだけ発生させる
+	ParticleTypeTable<float> emitInterval;
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		ParticleType type = static_cast<ParticleType>(i);
+		const ParticleParam& param = params_[type];
+		emitInterval[type] = param.isContinuous ? std::max(0.0f, param.emitInterval) : -1.0f;
+
+		// 絞っている間は装飾系の連続発生の間隔を倍率の逆数だけ延ばす（倍率 0 なら止める）
+		if (param.isContinuous && governor_.IsThrottling() && governor_.IsGoverned(param.priority)) {
+			const float scale = governor_.GetScale();
+			emitInterval[type] = scale > 0.0f ? emitInterval[type] / scale : -1.0f;
 		}
 	}
+	emitters_.Advance(deltaTime, &*emitInterval.begin(), firedEmitters_);
 
-	// パーティクルの更新
-	for (auto& p : particles_) {
-		if (p.IsAlive()) {
-			// ★環境パーティクルの特殊処理
-			ParticleType pType = p.GetType();
-
-			// 雪の横揺れ処理
-			if (pType == ParticleType::Snow && params_.find(pType) != params_.end()) {
-				const ParticleParam& param = params_[pType];
-				if (param.windStrength > 0.0f) {
-					// sine波で横揺れ
-					float windOffset = sinf(p.GetPosition().y * 0.01f) * param.windStrength * deltaTime;
-					Vector2 currentPos = p.GetPosition();
-					currentPos.x += windOffset;
-					// ★注意：Particleクラスに SetPosition を追加する必要があります
-				}
-			}
+	for (int dense : firedEmitters_) {
+		ParticleEmitterPool::Emitter& emitter = emitters_.At(dense);
+		const ParticleType type = emitter.type;
 
-			// 通常の更新処理
-			p.Update(deltaTime);
+		// ★追従モードに応じた位置計算
+		Vector2 emitPos = emitter.position;
+		if (emitter.followMode == EmitterFollowMode::FollowTarget && emitter.followTarget != nullptr) {
+			emitPos = *emitter.followTarget;
 
-			// 地面衝突判定（雨と雪のみ）
-			if (pType == ParticleType::Rain || pType == ParticleType::Snow) {
-				p.CheckGroundCollision(groundLevel_);
+			// ★環境パーティクルの場合、画面上端から発生
+			if (GetParticleTypeTraits(type).spawnFromScreenTop) {
+				emitPos.y += 360.0f;  // 画面上端
 			}
 		}
+
+		// エミッター自身の乱数列で発生させる（ターゲットがあれば Homing）
+		if (params_[type].textureHandle >= 0) {
+			EmitBurst(type, std::span<const Vector2>(&emitPos, 1), emitter.target, emitter.random);
+		}
 	}
-}
 
-// ========== Draw メソッド ==========
-void ParticleManager::Draw(const Camera2D& camera) {
-	// カメラから ViewProjectionMatrix を取得
-	Matrix3x3 vpMatrix = camera.GetVpVpMatrix();
+	// パーティクルの更新（チャンクに分けてワーカースレッドで並列に処理）
+	ParticleTypeTable<float> windStrength;
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		ParticleType type = static_cast<ParticleType>(i);
+		windStrength[type] = params_[type].windStrength;
+	}
+
+	// 流れ場を流す（場1枚ぶんで折り返し、長時間動かしても精度が落ちないようにする）
+	if (!flowField_.IsEmpty()) {
+		const float fieldWidth = static_cast<float>(flowField_.GetWidth()) * flowField_.GetCellSize();
+		const float fieldHeight = static_cast<float>(flowField_.GetHeight()) * flowField_.GetCellSize();
+		flowOffset_.x = std::fmod(flowOffset_.x + flowScrollSpeed_.x * deltaTime, fieldWidth);
+		flowOffset_.y = std::fmod(flowOffset_.y + flowScrollSpeed_.y * deltaTime, fieldHeight);
+	}
+
+	// 地形への反応（種類ごと）。形状が変わっていればここでグリッドを作り直す
+	ParticleTypeTable<ParticleWorldResponse> worldResponse;
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		ParticleType type = static_cast<ParticleType>(i);
+		worldResponse[type].collide = params_[type].collideWithWorld;
+		worldResponse[type].killOnHit = params_[type].killOnWorldHit;
+		worldResponse[type].bounceDamping = params_[type].bounceDamping;
+	}
+	if (collisionWorld_.IsDirty()) {
+		collisionWorld_.Build();
+	}
 
-	// パーティクルタイプごとにブレンドモードをグループ化して描画
-	for (auto it = params_.begin(); it != params_.end(); ++it) {
-		ParticleType type = it->first;
-		const ParticleParam& param = it->second;
+	ParticleStepContext context;
+	context.deltaTime = deltaTime;
+	context.groundY = groundLevel_;
+	context.windStrengthByType = &*windStrength.begin();
+	context.flowField = &flowField_;
+	context.flowOffset = flowOffset_;
+	context.world = &collisionWorld_;
+	context.worldResponseByType = &*worldResponse.begin();
+	context.simdLevel = ParticleStorage::GetBestSimdLevel();
+
+	// 外接矩形は使う種類があるときだけ作る
+	bool needsBounds = false;
+	for (const ParticleParam& param : params_) {
+		needsBounds = needsBounds || param.useCoarseBounds;
+	}
 
-		// このタイプのブレンドモードを設定
-		Novice::SetBlendMode(param.blendMode);
+	const int count = particles_.GetCount();
+	const int chunkCount = (count + kUpdateChunkSize - 1) / kUpdateChunkSize;
+	if (static_cast<int>(groundHitQueues_.size()) < chunkCount) {
+		groundHitQueues_.resize(chunkCount);
+	}
+	if (needsBounds && static_cast<int>(chunkBounds_.size()) < chunkCount) {
+		chunkBounds_.resize(chunkCount);
+	}
 
-		// このタイプの生きているパーティクルを描画
-		for (auto& p : particles_) {
-			if (!p.IsAlive() || p.GetType() != type) continue;
+	jobSystem_.ParallelFor(count, kUpdateChunkSize, [&](int chunkIndex, int begin, int end) {
+		std::vector<ParticleGroundHit>& hits = groundHitQueues_[chunkIndex];
+		hits.clear();
+		particles_.StepRange(begin, end, context, &hits);
 
-			// ワールド座標を取得
-			Vector2 worldPos = p.GetPosition();
+		if (needsBounds) {
+			ParticleTypeTable<ParticleBounds>& bounds = chunkBounds_[chunkIndex];
+			bounds = ParticleTypeTable<ParticleBounds>{};
+			particles_.AccumulateBounds(begin, end, &*bounds.begin());
+		}
+	});
+
+	// ========== 同期点 ==========
+	// 消えた粒を詰めてから、地面ヒットによる発生をチャンク順に処理する
+	// （チャンク分けは粒の数だけで決まるので、結果はスレッド数に依存しない）
+	particles_.RemoveDead();
+
+	typeBounds_ = ParticleTypeTable<ParticleBounds>{};
+	if (needsBounds) {
+		for (int c = 0; c < chunkCount; ++c) {
+			for (int t = 0; t < kParticleTypeCount; ++t) {
+				ParticleType type = static_cast<ParticleType>(t);
+				typeBounds_[type].Merge(chunkBounds_[c][type]);
+			}
+		}
+	}
 
-			// 行列演算でスクリーン座標に変換
-			Vector2 screenPos = Matrix3x3::Transform(worldPos, vpMatrix);
+	for (int c = 0; c < chunkCount; ++c) {
+		for (const ParticleGroundHit& hit : groundHitQueues_[c]) {
+			const ParticleParam& param = params_[hit.type];
+			if (param.useGroundHitEmit) {
+				emitQueue_.push_back({ param.groundHitEmitType, hit.position, nullptr });
+			}
+		}
+		groundHitQueues_[c].clear();
+	}
 
-			// テクスチャサイズを取得
-			int texWidth, texHeight;
-			Novice::GetTextureSize(p.GetTextureHandle(), &texWidth, &texHeight);
+	// 地面ヒットによる発生は種類ごとにまとめて、このフレームのうちに出す
+	FlushQueuedEmits();
+}
 
-			// アニメーション使用時はソース矩形を計算
-			int srcX = 0;
-			int srcY = 0;
-			int srcW = texWidth;
-			int srcH = texHeight;
+// ========== Draw メソッド ==========
+void ParticleManager::Draw(const Camera2D& camera) {
+	const auto drawStart = std::chrono::steady_clock::now();
 
-			if (p.UseAnimation()) {
-				int divX = p.GetDivX();
-				int divY = p.GetDivY();
-				int frame = p.GetCurrentFrame();
+	PrepareDraw(camera);
+	drawList_.Submit();
+	trails_.Submit();
 
-				// 1フレームのサイズ
-				srcW = texWidth / divX;
-				srcH = texHeight / divY;
+	lastDrawMs_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - drawStart).count();
+}
 
-				// フレーム番号から座標を計算
-				int frameX = frame % divX;
-				int frameY = frame / divX;
+void ParticleManager::PrepareDraw(const Camera2D& camera) {
+	if (!cullingEnabled_) {
+		// 生存中の粒を (ブレンドモード, テクスチャ) ごとに1回で振り分ける
+		drawList_.Build(particles_, camera.GetVpVpMatrix());
+		trails_.Build(camera.GetVpVpMatrix());
+		return;
+	}
 
-				srcX = frameX * srcW;
-				srcY = frameY * srcH;
-			}
+	// カメラに映る範囲を求め、範囲外の粒は座標変換の前に捨てる
+	ParticleDrawList::CullView view;
+	camera.GetViewRect(view.min, view.max);
+	view.worldPerPixel = camera.GetZoom();
 
-			// 描画サイズを取得（0なら1フレーム分のサイズを使用）
-			float baseSize = p.GetDrawSize();
-			if (baseSize <= 0.0f) {
-				baseSize = static_cast<float>(srcW);  // アニメーション考慮
-			}
+	// 粗い外接矩形が画面と重ならない種類は丸ごと捨てる
+	bool anyRejected = false;
+	for (int t = 0; t < kParticleTypeCount; ++t) {
+		ParticleType type = static_cast<ParticleType>(t);
+		const ParticleParam& param = params_[type];
+		const ParticleBounds& bounds = typeBounds_[type];
 
-			// スケール適用後のサイズ
-			float finalScale = p.GetCurrentScale();
-			float drawWidth = baseSize * finalScale;
-			float drawHeight = baseSize * finalScale;
-
-			// 中心座標基準で描画するためのオフセット
-			float offsetX = screenPos.x - drawWidth * 0.5f;
-			float offsetY = screenPos.y - drawHeight * 0.5f;
-
-			// 描画
-			Novice::DrawQuad(
-				static_cast<int>(offsetX), static_cast<int>(offsetY),                           // 左上
-				static_cast<int>(offsetX + drawWidth), static_cast<int>(offsetY),               // 右上
-				static_cast<int>(offsetX), static_cast<int>(offsetY + drawHeight),              // 左下
-				static_cast<int>(offsetX + drawWidth), static_cast<int>(offsetY + drawHeight),  // 右下
-				srcX, srcY,                                                                      // ソース矩形
-				srcW, srcH,                                                                      // ソース矩形
-				p.GetTextureHandle(),
-				p.GetCurrentColor()
-			);
+		bool rejected = false;
+		if (param.useCoarseBounds && !bounds.IsEmpty()) {
+			const float margin = param.coarseBoundsMargin;
+			rejected = bounds.maxX + margin < view.min.x || bounds.minX - margin > view.max.x ||
+				bounds.maxY + margin < view.min.y || bounds.minY - margin > view.max.y;
 		}
+		typeRejected_[type] = rejected ? 1 : 0;
+		anyRejected = anyRejected || rejected;
 	}
+	view.rejectedTypes = anyRejected ? &*typeRejected_.begin() : nullptr;
 
-	// デフォルトに戻す
-	Novice::SetBlendMode(kBlendModeNormal);
+	drawList_.Build(particles_, camera.GetVpVpMatrix(), &view);
+	trails_.Build(camera.GetVpVpMatrix());
 }
 
 // ========== Emit メソッド（拡張版） ==========
 void ParticleManager::Emit(ParticleType type, const Vector2& pos) {
 	// 指定されたタイプの設定を取得
-	if (params_.find(type) == params_.end()) {
+	if (!IsValidParticleType(type)) {
 #ifdef _DEBUG
 		Novice::ConsolePrintf("ParticleManager::Emit - Invalid ParticleType\n");
 #endif
 		return;
 	}
 
-	const ParticleParam& param = params_[type];
-
 	// テクスチャが無効な場合はスキップ
-	if (param.textureHandle < 0) {
+	if (params_[type].textureHandle < 0) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticleManager::Emit - Invalid texture handle: %d\n", params_[type].textureHandle);
+#endif
+		return;
+	}
+
+	recorder_.Record(ParticleReplayOp::Emit, type, pos);
+	EmitBurst(type, std::span<const Vector2>(&pos, 1), nullptr, random_);
+}
+
+// ターゲット指定版 Emit（Homing用）
+void ParticleManager::EmitWithTarget(ParticleType type, const Vector2& pos, const Vector2* target) {
+	if (!IsValidParticleType(type)) return;
+	if (params_[type].textureHandle < 0) return;
+
+	recorder_.Record(ParticleReplayOp::Emit, type, pos, 0, 0, target);
+	EmitBurst(type, std::span<const Vector2>(&pos, 1), target, random_);
+}
+
+void ParticleManager::EmitBatch(ParticleType type, std::span<const Vector2> positions) {
+	EmitBatchWithTarget(type, positions, nullptr);
+}
+
+void ParticleManager::EmitBatchWithTarget(ParticleType type, std::span<const Vector2> positions, const Vector2* target) {
+	if (!IsValidParticleType(type)) {
 #ifdef _DEBUG
-		Novice::ConsolePrintf("ParticleManager::Emit - Invalid texture handle: %d\n", param.textureHandle);
+		Novice::ConsolePrintf("ParticleManager::EmitBatch - Invalid ParticleType\n");
 #endif
 		return;
 	}
+	if (params_[type].textureHandle < 0) return;
 
-	// 設定された個数ぶん発生させる
-	for (int i = 0; i < param.count; ++i) {
-		Particle& p = GetNextParticle();
-
-		// パーティクルタイプを設定
-		p.SetType(type);
-
-		// --- ランダム計算 ---
-		int life = static_cast<int>(RandomFloat(static_cast<float>(param.lifeMin), static_cast<float>(param.lifeMax)));
-
-		// Emitter Shape に応じた座標生成
-		Vector2 spawnPos = GenerateEmitPosition(pos, param);
-
-		// 速度ベクトル
-		float speed = RandomFloat(param.speedMin, param.speedMax);
-		float halfRange = param.angleRange / 2.0f;
-		float angleDeg = param.angleBase + RandomFloat(-halfRange, halfRange);
-		float angleRad = angleDeg * (3.14159265f / 180.0f);
-		Vector2 vel = { cosf(angleRad) * speed, sinf(angleRad) * speed };
-
-		// 加速度の合成（重力 + acceleration）
-		Vector2 totalAcc = param.gravity + param.acceleration;
-
-		// 回転速度のランダム化
-		float rotSpeed = RandomFloat(param.rotationSpeedMin, param.rotationSpeedMax);
-
-		// サイズをランダムに決定（これを描画サイズとして使用）
-		float size = RandomFloat(param.sizeMin, param.sizeMax);
-
-		// パーティクル初期化
-		p.Initialize(
-			spawnPos, vel, totalAcc, life,
-			param.textureHandle,
-			param.scaleStart, param.scaleEnd,
-			param.colorStart, param.colorEnd,
-			0.0f, rotSpeed,
-			param.blendMode,
-			size,  // 描画サイズを渡す
-			// アニメーションパラメータを渡す
-			param.useAnimation,
-			param.divX,
-			param.divY,
-			param.totalFrames,
-			param.animSpeed
-		);
-
-		// ★オーブの場合は Stationary に設定
-		if (type == ParticleType::Orb) {
-			p.SetBehavior(ParticleBehavior::Stationary);
+	if (recorder_.IsRecording()) {
+		recorder_.Record(ParticleReplayOp::EmitBatch, type, { 0.0f, 0.0f }, static_cast<uint32_t>(positions.size()), 0, target);
+		for (const Vector2& pos : positions) {
+			recorder_.Record(ParticleReplayOp::BatchPoint, type, pos);
 		}
-		else {
-			p.SetBehavior(ParticleBehavior::Physics);
+	}
+	EmitBurst(type, positions, target, random_);
+}
+
+void ParticleManager::QueueEmit(ParticleType type, const Vector2& pos) {
+	QueueEmitWithTarget(type, pos, nullptr);
+}
+
+void ParticleManager::QueueEmitWithTarget(ParticleType type, const Vector2& pos, const Vector2* target) {
+	if (!IsValidParticleType(type)) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticleManager::QueueEmit - Invalid ParticleType\n");
+#endif
+		return;
+	}
+	recorder_.Record(ParticleReplayOp::QueueEmit, type, pos, 0, 0, target);
+	emitQueue_.push_back({ type, pos, target });
+}
+
+void ParticleManager::FlushEmitQueue() {
+	recorder_.Record(ParticleReplayOp::FlushEmitQueue, ParticleType::Explosion, { 0.0f, 0.0f });
+	FlushQueuedEmits();
+}
+
+void ParticleManager::FlushQueuedEmits() {
+	if (emitQueue_.empty()) return;
+
+	// 種類ごとに並べ替える（同じ種類の中では予約順を保つので、結果は予約の仕方だけで決まる）
+	std::stable_sort(emitQueue_.begin(), emitQueue_.end(), [](const EmitCommand& a, const EmitCommand& b) {
+		return a.type < b.type;
+	});
+
+	// 種類とターゲットが同じ連続した予約を1回の EmitBatch にまとめる
+	size_t begin = 0;
+	while (begin < emitQueue_.size()) {
+		const ParticleType type = emitQueue_[begin].type;
+		const Vector2* target = emitQueue_[begin].target;
+
+		batchPositions_.clear();
+		size_t end = begin;
+		while (end < emitQueue_.size() && emitQueue_[end].type == type && emitQueue_[end].target == target) {
+			batchPositions_.push_back(emitQueue_[end].position);
+			++end;
+		}
+
+		if (params_[type].textureHandle >= 0) {
+			EmitBurst(type, batchPositions_, target, random_);
+		}
+		begin = end;
+	}
+
+	emitQueue_.clear();
+}
+
+void ParticleManager::EmitBurst(ParticleType type, std::span<const Vector2> positions, const Vector2* target, FastRandom& random) {
+	const ParticleParam& param = params_[type];
+	const ParticleTypeTraits& traits = GetParticleTypeTraits(type);
+	if (param.count <= 0 || positions.empty()) return;
+
+	// 地点ごとの発生数。負荷が高いときは装飾系だけ倍率を掛ける
+	// （端数は次の地点・次の発生に持ち越すので、平均すると倍率どおりの数になる）
+	const int positionCount = static_cast<int>(positions.size());
+	const bool governed = governor_.IsThrottling() && governor_.IsGoverned(param.priority);
+	burstOffsets_.resize(static_cast<size_t>(positionCount) + 1);
+	burstOffsets_[0] = 0;
+	for (int p = 0; p < positionCount; ++p) {
+		int count = param.count;
+		if (governed) {
+			float& carry = governedCountCarry_[type];
+			carry += static_cast<float>(param.count) * governor_.GetScale();
+			count = static_cast<int>(carry);
+			carry -= static_cast<float>(count);
+		}
+		burstOffsets_[p + 1] = burstOffsets_[p] + count;
+	}
+
+	const int total = burstOffsets_[positionCount];
+	if (total <= 0) return;
+
+	// --- ランダム計算 ---
+	// 1粒あたり kRandomsPerParticle 個の [0, 1) を、発生する全粒ぶんまとめて作る
+	// （使わない値も必ず消費するので、形状などを変えても後続の粒の列はずれない。
+	//   地点ごとに FillUnit を呼んだ場合と同じ列になる）
+	burstRandoms_.resize(static_cast<size_t>(total) * kRandomsPerParticle);
+	random.FillUnit(burstRandoms_.data(), static_cast<int>(burstRandoms_.size()));
+
+	// 全粒で共通の部分は先に1回だけ作る
+	ParticleSpawnDesc common;
+	common.acceleration = param.gravity + param.acceleration;  // 加速度の合成（重力 + acceleration）
+	common.textureHandle = param.textureHandle;
+	common.lifetimeLut = static_cast<int>(type);
+	common.scaleStart = param.scaleStart;
+	common.scaleEnd = param.scaleEnd;
+	common.colorStart = param.colorStart;
+	common.colorEnd = param.colorEnd;
+	common.blendMode = param.blendMode;
+	common.useAnimation = param.useAnimation;
+	// シートはバーストごとに1回だけ引き、全粒で同じものを指す
+	common.spriteSheet = param.useAnimation ? SpriteSheet::Get(param.textureHandle, param.divX, param.divY) : nullptr;
+	common.divX = param.divX;
+	common.divY = param.divY;
+	common.totalFrames = param.totalFrames;
+	common.animSpeed = param.animSpeed;
+
+	const float halfRange = param.angleRange / 2.0f;
+	burstDescs_.resize(total);
+
+	// 地点ごとに、決めた個数ぶんの初期化データを作る
+	for (int p = 0; p < positionCount; ++p) {
+		for (int k = burstOffsets_[p]; k < burstOffsets_[p + 1]; ++k) {
+			const float* u = &burstRandoms_[static_cast<size_t>(k) * kRandomsPerParticle];
+			ParticleSpawnDesc& desc = burstDescs_[k];
+			desc = common;
+
+			desc.life = Lerp(param.lifeMin, param.lifeMax, u[0]);
+
+			// Emitter Shape に応じた座標生成
+			desc.position = GenerateEmitPosition(positions[p], param, u[1], u[2]);
+
+			// 速度ベクトル
+			float speed = Lerp(param.speedMin, param.speedMax, u[3]);
+			float angleDeg = param.angleBase + Lerp(-halfRange, halfRange, u[4]);
+			float angleRad = angleDeg * (3.14159265f / 180.0f);
+			desc.velocity = { cosf(angleRad) * speed, sinf(angleRad) * speed };
+
+			// 回転速度のランダム化
+			desc.rotationSpeed = Lerp(param.rotationSpeedMin, param.rotationSpeedMax, u[5]);
+
+			// サイズをランダムに決定（これを描画サイズとして使用）
+			desc.drawSize = Lerp(param.sizeMin, param.sizeMax, u[6]);
+		}
+	}
+
+	// スロットはまとめて確保する（プールが満杯なら DropNew で -1 になる粒もある）
+	burstIndices_.resize(total);
+	particles_.SpawnBatch(type, burstDescs_.data(), total, param.priority, burstIndices_.data());
+
+	// ★Homing（追従できる種類で、パラメータでも有効なとき）/ ★オーブなどその場に留まる種類は Stationary
+	// 生成直後は Physics なので、それ以外のときだけ設定し直す
+	const bool homing = traits.homing && param.useHoming && target != nullptr;
+	for (int k = 0; k < total; ++k) {
+		const int index = burstIndices_[k];
+		if (index < 0) continue;
+		typeBounds_[type].Expand(burstDescs_[k].position.x, burstDescs_[k].position.y);
+
+		if (homing) {
+			particles_.SetBehavior(index, ParticleBehavior::Homing);
+			particles_.SetHomingTarget(index, target, param.homingStrength);
+		}
+		else if (traits.stationary) {
+			particles_.SetBehavior(index, ParticleBehavior::Stationary);
 		}
 	}
 }
 
-Vector2 ParticleManager::GenerateEmitPosition(const Vector2& basePos, const ParticleParam& param) {
+Vector2 ParticleManager::GenerateEmitPosition(const Vector2& basePos, const ParticleParam& param, float u, float v) {
 	Vector2 spawnPos = basePos;
 
 	switch (param.emitterShape) {
 	case EmitterShape::Point:
 		// 点発生：emitRange を適用
 		if (param.emitRange.x > 0.0f) {
-			spawnPos.x += RandomFloat(-param.emitRange.x * 0.5f, param.emitRange.x * 0.5f);
+			spawnPos.x += Lerp(-param.emitRange.x * 0.5f, param.emitRange.x * 0.5f, u);
 		}
 		if (param.emitRange.y > 0.0f) {
-			spawnPos.y += RandomFloat(-param.emitRange.y * 0.5f, param.emitRange.y * 0.5f);
+			spawnPos.y += Lerp(-param.emitRange.y * 0.5f, param.emitRange.y * 0.5f, v);
 		}
 		break;
 
 	case EmitterShape::Line:
 		// 線発生：X方向にランダム配置
-		spawnPos.x += RandomFloat(-param.emitterSize.x * 0.5f, param.emitterSize.x * 0.5f);
+		spawnPos.x += Lerp(-param.emitterSize.x * 0.5f, param.emitterSize.x * 0.5f, u);
 		break;
 
 	case EmitterShape::Rectangle:
 		// 矩形発生：X, Y 両方向にランダム配置
-		spawnPos.x += RandomFloat(-param.emitterSize.x * 0.5f, param.emitterSize.x * 0.5f);
-		spawnPos.y += RandomFloat(-param.emitterSize.y * 0.5f, param.emitterSize.y * 0.5f);
+		spawnPos.x += Lerp(-param.emitterSize.x * 0.5f, param.emitterSize.x * 0.5f, u);
+		spawnPos.y += Lerp(-param.emitterSize.y * 0.5f, param.emitterSize.y * 0.5f, v);
 		break;
 	}
 
 	return spawnPos;
 }
 
-// ターゲット指定版 Emit（Homing用）
-void ParticleManager::EmitWithTarget(ParticleType type, const Vector2& pos, const Vector2* target) {
-	if (params_.find(type) == params_.end()) return;
+void ParticleManager::EmitDashGhost(TrailHandle& dashTrail, const Vector2& pos, float scale, int texHandle) {
+	if (texHandle < 0) return;
 
-	const ParticleParam& param = params_[type];
-	if (param.textureHandle < 0) return;
-
-	for (int i = 0; i < param.count; ++i) {
-		Particle& p = GetNextParticle();
-		p.SetType(type);
-
-		int life = static_cast<int>(RandomFloat(static_cast<float>(param.lifeMin), static_cast<float>(param.lifeMax)));
-
-		// Emitter Shape に応じた座標生成
-		Vector2 spawnPos = GenerateEmitPosition(pos, param);
-
-		// 速度ベクトル
-		float speed = RandomFloat(param.speedMin, param.speedMax);
-		float halfRange = param.angleRange / 2.0f;
-		float angleDeg = param.angleBase + RandomFloat(-halfRange, halfRange);
-		float angleRad = angleDeg * (3.14159265f / 180.0f);
-		Vector2 vel = { cosf(angleRad) * speed, sinf(angleRad) * speed };
-
-		Vector2 totalAcc = param.gravity + param.acceleration;
-		float rotSpeed = RandomFloat(param.rotationSpeedMin, param.rotationSpeedMax);
-		float size = RandomFloat(param.sizeMin, param.sizeMax);
-
-		p.Initialize(
-			spawnPos, vel, totalAcc, life,
-			param.textureHandle,
-			param.scaleStart, param.scaleEnd,
-			param.colorStart, param.colorEnd,
-			0.0f, rotSpeed,
-			param.blendMode,
-			size,
-			param.useAnimation,
-			param.divX, param.divY,
-			param.totalFrames, param.animSpeed
-		);
-
-		// ★Homing 設定
-		if (param.useHoming && target != nullptr) {
-			p.SetBehavior(ParticleBehavior::Homing);
-			p.SetHomingTarget(target, param.homingStrength);
+	// 残像の粒を呼ぶたびに撒く代わりに、ダッシュ中の位置を1本の軌跡に足していく
+	// 前の呼び出しから間が空いたら別のダッシュとみなし、前の軌跡は消えるに任せて新しく始める
+	const ParticleTrail* trail = trails_.Get(dashTrail);
+	if (trail == nullptr || trail->GetTimeSincePush() > kDashTrailBreakTime) {
+		if (trail != nullptr && recorder_.IsRecording()) {
+			const uint32_t oldId = recorder_.FindTrailId(dashTrail);
+			if (oldId != ParticleRecorder::kUnknownTrail) {
+				recorder_.Record(ParticleReplayOp::StopDashTrail, ParticleType::Explosion, { 0.0f, 0.0f }, oldId);
+			}
 		}
-		else if (type == ParticleType::Orb) {
-			p.SetBehavior(ParticleBehavior::Stationary);
+		trails_.Release(dashTrail);
+
+		// 帯は進む向きに沿うので、太さは横向きに走る画像の縦幅に合わせる（向き・反転は帯に影響しない）
+		int texWidth = 0;
+		int texHeight = 0;
+		Novice::GetTextureSize(texHandle, &texWidth, &texHeight);
+		const float width = static_cast<float>(texHeight) * scale;
+
+		dashTrail = CreateDashTrail(texHandle, width);
+		if (recorder_.IsRecording()) {
+			recorder_.Record(ParticleReplayOp::StartDashTrail, ParticleType::Explosion, { width, 0.0f },
+				recorder_.AssignTrailId(dashTrail));
 		}
-		else {
-			p.SetBehavior(ParticleBehavior::Physics);
+	}
+
+	if (recorder_.IsRecording()) {
+		const uint32_t id = recorder_.FindTrailId(dashTrail);
+		if (id != ParticleRecorder::kUnknownTrail) {
+			recorder_.Record(ParticleReplayOp::DashTrailPoint, ParticleType::Explosion, pos, id);
 		}
 	}
+	PushTrail(dashTrail, pos);
 }
 
-void ParticleManager::EmitDashGhost(const Vector2& pos, float scale, float rotation, bool isFlipX, int texHandle) {
-	isFlipX; // 未使用警告回避
-	if (texHandle < 0) return;
+TrailHandle ParticleManager::CreateDashTrail(int texHandle, float width) {
+	ParticleTrailSettings settings;
+	settings.textureHandle = texHandle;
+	settings.blendMode = kBlendModeNormal;
+	settings.pointLifetime = 0.33f;                 // 旧残像の寿命
+	settings.minSegmentLength = 24.0f;
+	settings.widthStart = width;
+	settings.widthEnd = settings.widthStart * 0.8f; // 旧残像の縮小率
+	settings.colorStart = 0x8888FFFF;               // 半透明の青
+	settings.colorEnd = 0x8888FF00;
+	return trails_.Create(settings);
+}
 
-	Particle& p = GetNextParticle();
-
-	// Ghost タイプのパーティクルとして初期化
-	p.Initialize(
-		pos,                          // 位置
-		{ 0.0f, 0.0f },              // 速度なし
-		{ 0.0f, 0.0f },              // 加速度なし
-		20,                          // 寿命（フレーム）
-		texHandle,                   // テクスチャハンドル
-		scale,                       // 開始スケール
-		scale * 0.8f,                // 終了スケール（少し縮小）
-		0x8888FFFF,                  // 開始色（半透明の青）
-		0x8888FF00,                  // 終了色（完全に透明）
-		rotation,                    // 回転角
-		0.0f,                        // 回転速度なし
-		kBlendModeNormal,            // 通常ブレンド
-		0.0f,                        // 描画サイズ（0 = 画像サイズ）
-		false, 1, 1, 1, 0.0f         // アニメーションなし
-	);
-
-	p.SetBehavior(ParticleBehavior::Ghost);
-	p.SetType(ParticleType::Dust);
+// =================================
+//  軌跡（リボン）
+// =================================
+TrailHandle ParticleManager::StartTrail(const ParticleTrailSettings& settings) {
+	ParticleTrailSettings resolved = settings;
+	if (resolved.textureHandle < 0) {
+		resolved.textureHandle = GetTrailTexture();
+	}
+	return trails_.Create(resolved);
 }
 
-void ParticleManager::Clear() {
-	for (auto& p : particles_) {
-		p.Initialize(
-			{ 0,0 }, { 0,0 }, { 0,0 }, 0, 0,
-			1.0f, 1.0f, WHITE, 0xFFFFFF00,
-			0.0f, 0.0f, kBlendModeNone,
-			0.0f,                        // 描画サイズ
-			false, 1, 1, 1, 0.0f         // アニメーションなし
-		);
+void ParticleManager::PushTrail(TrailHandle handle, const Vector2& pos) {
+	if (ParticleTrail* trail = trails_.Get(handle)) {
+		trail->Push(pos);
 	}
-	nextIndex_ = 0;
+}
+
+void ParticleManager::StopTrail(TrailHandle handle) {
+	trails_.Release(handle);
+}
+
+int ParticleManager::GetTrailTexture() {
+	return ResolveTexture(kTrailTexturePath);
+}
+
+void ParticleManager::Clear() {
+	recorder_.Record(ParticleReplayOp::Clear, ParticleType::Explosion, { 0.0f, 0.0f });
+	particles_.KillAll();
+	emitQueue_.clear();
+	typeBounds_ = ParticleTypeTable<ParticleBounds>{};
+	governedCountCarry_ = ParticleTypeTable<float>{};
+	trails_.Clear();
 }
 
 // =================================
@@ -743,36 +1052,107 @@ void ParticleManager::StartContinuousEmit(ParticleType type, const Vector2& pos)
 }
 
 void ParticleManager::StartContinuousEmitWithTarget(ParticleType type, const Vector2& pos, const Vector2* target) {
-	if (params_.find(type) == params_.end()) return;
+	if (!IsValidParticleType(type)) return;
+	recorder_.Record(ParticleReplayOp::StartContinuous, type, pos, 0, 0, target);
 
-	ContinuousEmitter& emitter = continuousEmitters_[type];
-	emitter.type = type;
-	emitter.position = pos;
-	emitter.followMode = EmitterFollowMode::None;  // デフォルトは固定
-	emitter.followTarget = nullptr;
-	emitter.target = target;
-	emitter.timer = 0.0f;
-	emitter.isActive = true;
+	ParticleEmitterPool::Emitter* emitter = emitters_.Get(StartTypeEmitter(type));
+	emitter->position = pos;
+	emitter->target = target;
 }
 
 void ParticleManager::StopContinuousEmit(ParticleType type) {
-	if (continuousEmitters_.find(type) != continuousEmitters_.end()) {
-		continuousEmitters_[type].isActive = false;
-	}
+	if (!IsValidParticleType(type)) return;
+	recorder_.Record(ParticleReplayOp::StopContinuous, type, { 0.0f, 0.0f });
+	emitters_.Destroy(typeEmitters_[type]);
+	typeEmitters_[type] = EmitterHandle{};
 }
 
 void ParticleManager::StopAllContinuousEmit() {
-	for (auto& [type, emitter] : continuousEmitters_) {
-		emitter.isActive = false;
+	recorder_.Record(ParticleReplayOp::StopAllContinuous, ParticleType::Explosion, { 0.0f, 0.0f });
+	emitters_.Clear();
+	for (EmitterHandle& handle : typeEmitters_) {
+		handle = EmitterHandle{};
+	}
+}
+
+EmitterHandle ParticleManager::StartTypeEmitter(ParticleType type) {
+	// 動いていれば同じエミッターを使い回す（乱数の列もそのまま続ける）
+	EmitterHandle& handle = typeEmitters_[type];
+	if (!emitters_.IsAlive(handle)) {
+		handle = CreateEmitter(type, { 0.0f, 0.0f }, nullptr);
 	}
+
+	ParticleEmitterPool::Emitter* emitter = emitters_.Get(handle);
+	emitter->position = { 0.0f, 0.0f };
+	emitter->followMode = EmitterFollowMode::None;  // デフォルトは固定
+	emitter->followTarget = nullptr;
+	emitter->target = nullptr;
+	emitters_.ResetTimer(handle);
+	return handle;
 }
 
 // =================================
-//  環境パーティクル専用API
+//  連続発生エミッター（ハンドル版）
 // =================================
-void ParticleManager::StartEnvironmentEffect(ParticleType type, EmitterFollowMode mode, const Vector2& basePos) {
-	if (params_.find(type) == params_.end()) return;
+EmitterHandle ParticleManager::StartEmitter(ParticleType type, const Vector2& pos, const Vector2* target) {
+	if (!IsValidParticleType(type)) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticleManager::StartEmitter - Invalid ParticleType\n");
+#endif
+		return EmitterHandle{};
+	}
+
+	EmitterHandle handle = CreateEmitter(type, pos, target);
+	if (recorder_.IsRecording()) {
+		recorder_.Record(ParticleReplayOp::StartEmitter, type, pos, recorder_.AssignEmitterId(handle), 0, target);
+	}
+	return handle;
+}
+
+EmitterHandle ParticleManager::CreateEmitter(ParticleType type, const Vector2& pos, const Vector2* target) {
+	EmitterHandle handle = emitters_.Create(type);
+	ParticleEmitterPool::Emitter* emitter = emitters_.Get(handle);
+	emitter->position = pos;
+	emitter->target = target;
 
+	// 作った順の番号からシードを作る（同じシード・同じ操作なら同じ列になる）
+	emitter->streamId = nextEmitterStream_++;
+	emitter->random.Seed(FastRandom::DeriveSeed(randomSeed_, emitter->streamId));
+	return handle;
+}
+
+void ParticleManager::StopEmitter(EmitterHandle handle) {
+	RecordEmitterOp(ParticleReplayOp::StopEmitter, handle, { 0.0f, 0.0f });
+	emitters_.Destroy(handle);
+}
+
+void ParticleManager::SetEmitterPosition(EmitterHandle handle, const Vector2& pos) {
+	if (ParticleEmitterPool::Emitter* emitter = emitters_.Get(handle)) {
+		RecordEmitterOp(ParticleReplayOp::SetEmitterPosition, handle, pos);
+		emitter->position = pos;
+	}
+}
+
+void ParticleManager::SetEmitterFollow(EmitterHandle handle, EmitterFollowMode mode, const Vector2* followTarget) {
+	if (ParticleEmitterPool::Emitter* emitter = emitters_.Get(handle)) {
+		RecordEmitterOp(ParticleReplayOp::SetEmitterFollow, handle, { 0.0f, 0.0f }, static_cast<uint8_t>(mode), nullptr,
+			followTarget != nullptr ? ParticleReplayEvent::kFlagFollow : 0);
+		emitter->followMode = mode;
+		emitter->followTarget = followTarget;
+	}
+}
+
+void ParticleManager::SetEmitterTarget(EmitterHandle handle, const Vector2* target) {
+	if (ParticleEmitterPool::Emitter* emitter = emitters_.Get(handle)) {
+		RecordEmitterOp(ParticleReplayOp::SetEmitterTarget, handle, { 0.0f, 0.0f }, 0, target);
+		emitter->target = target;
+	}
+}
+
+// =================================
+//  環境パーティクル専用API
+// =================================
+void ParticleManager::ApplyEnvironmentDefaults(ParticleType type) {
 	// ★強制設定：環境パーティクルは必ず連続発生にする
 	params_[type].isContinuous = true;
 	if (params_[type].emitInterval <= 0.0f) {
@@ -797,15 +1177,18 @@ void ParticleManager::StartEnvironmentEffect(ParticleType type, EmitterFollowMod
 			break;
 		}
 	}
+}
+
+void ParticleManager::StartEnvironmentEffect(ParticleType type, EmitterFollowMode mode, const Vector2& basePos) {
+	if (!IsValidParticleType(type)) return;
+
+	ApplyEnvironmentDefaults(type);
+
+	recorder_.Record(ParticleReplayOp::StartEnvironment, type, basePos, 0, static_cast<uint8_t>(mode));
 
-	ContinuousEmitter& emitter = continuousEmitters_[type];
-	emitter.type = type;
-	emitter.position = basePos;
-	emitter.followMode = mode;
-	emitter.followTarget = nullptr;
-	emitter.target = nullptr;
-	emitter.timer = 0.0f;
-	emitter.isActive = true;
+	ParticleEmitterPool::Emitter* emitter = emitters_.Get(StartTypeEmitter(type));
+	emitter->position = basePos;
+	emitter->followMode = mode;
 
 #ifdef _DEBUG
 	const char* modeName = "Unknown";
@@ -825,86 +1208,195 @@ void ParticleManager::StopEnvironmentEffect(ParticleType type) {
 }
 
 void ParticleManager::UpdateEnvironmentParams(ParticleType type, const ParticleParam& newParams) {
-	if (params_.find(type) != params_.end()) {
-		params_[type] = newParams;
-	}
+	if (!IsValidParticleType(type)) return;
+	params_[type] = newParams;
+	BakeLifetimeCurves(type);
 }
 
 void ParticleManager::SetFollowTarget(ParticleType type, const Vector2* target) {
-	if (continuousEmitters_.find(type) != continuousEmitters_.end()) {
-		continuousEmitters_[type].followTarget = target;
+	if (!IsValidParticleType(type)) return;
+	if (ParticleEmitterPool::Emitter* emitter = emitters_.Get(typeEmitters_[type])) {
+		recorder_.Record(ParticleReplayOp::SetFollowTarget, type, { 0.0f, 0.0f }, 0, 0, nullptr,
+			target != nullptr ? ParticleReplayEvent::kFlagFollow : 0);
+		emitter->followTarget = target;
 	}
 }
 
 void ParticleManager::UpdateFollowPosition(ParticleType type, const Vector2& newPos) {
-	if (continuousEmitters_.find(type) != continuousEmitters_.end()) {
-		continuousEmitters_[type].position = newPos;
+	if (!IsValidParticleType(type)) return;
+	if (ParticleEmitterPool::Emitter* emitter = emitters_.Get(typeEmitters_[type])) {
+		recorder_.Record(ParticleReplayOp::UpdateFollow, type, newPos);
+		emitter->position = newPos;
 	}
 }
 
 void ParticleManager::SetGroundLevel(float groundY) {
+	recorder_.Record(ParticleReplayOp::SetGroundLevel, ParticleType::Explosion, { 0.0f, groundY });
 	groundLevel_ = groundY;
 }
 
+// =================================
+//  記録と再生
+// =================================
+void ParticleManager::StartRecording() {
+	ParticleReplayHeader header;
+	header.seed = randomSeed_;
+	header.fixedStep = fixedStep_;
+	header.maxSubSteps = maxSubSteps_;
+	header.poolPolicy = static_cast<uint32_t>(particles_.GetPolicy());
+	header.groundLevel = groundLevel_;
+	header.stepAccumulator = stepAccumulator_;
+	header.flowOffsetX = flowOffset_.x;
+	header.flowOffsetY = flowOffset_.y;
+	recorder_.Start(header);
+}
+
+bool ParticleManager::SaveRecording(const std::string& filepath) const {
+	return recorder_.GetLog().Save(filepath);
+}
+
+void ParticleManager::RecordEmitterOp(ParticleReplayOp op, EmitterHandle handle, const Vector2& pos,
+	uint8_t mode, const Vector2* target, uint8_t flags) {
+	if (!recorder_.IsRecording()) return;
+
+	// 記録を始める前に作られたエミッターは再生側に無いので書かない
+	const uint32_t id = recorder_.FindEmitterId(handle);
+	if (id == ParticleRecorder::kUnknownEmitter) return;
+	recorder_.Record(op, ParticleType::Explosion, pos, id, mode, target, flags);
+}
+
+void ParticleManager::RecordFollowTargets() {
+	// 追従対象はポインタなので、Update で読まれる直前の位置を書いておく
+	for (int t = 0; t < kParticleTypeCount; ++t) {
+		const ParticleType type = static_cast<ParticleType>(t);
+		const ParticleEmitterPool::Emitter* emitter = emitters_.Get(typeEmitters_[type]);
+		if (emitter != nullptr && emitter->followTarget != nullptr) {
+			recorder_.RecordTypeFollow(type, *emitter->followTarget);
+		}
+	}
+
+	for (int i = 0; i < emitters_.GetCount(); ++i) {
+		const ParticleEmitterPool::Emitter& emitter = emitters_.At(i);
+		if (emitter.followTarget != nullptr) {
+			recorder_.RecordEmitterFollow(emitters_.HandleAt(i), *emitter.followTarget);
+		}
+	}
+}
+
 ParticleParam* ParticleManager::GetParam(ParticleType type) {
-	auto it = params_.find(type);
-	return (it != params_.end()) ? &it->second : nullptr;
+	return IsValidParticleType(type) ? &params_[type] : nullptr;
+}
+
+void ParticleManager::BakeLifetimeCurves(ParticleType type) {
+	if (!IsValidParticleType(type)) return;
+	const ParticleParam& param = params_[type];
+
+	// カーブが無ければ Start / End を2点のカーブとして扱う
+	std::vector<ParticleScaleKey> scaleKeys = param.scaleCurve;
+	if (scaleKeys.empty()) {
+		scaleKeys = { { 0.0f, param.scaleStart }, { 1.0f, param.scaleEnd } };
+	}
+	std::vector<ParticleColorKey> colorKeys = param.colorCurve;
+	if (colorKeys.empty()) {
+		colorKeys = { { 0.0f, param.colorStart }, { 1.0f, param.colorEnd } };
+	}
+
+	// テーブル番号は種類の番号と同じ
+	particles_.SetLifetimeLut(static_cast<int>(type), ParticleCurve::Bake(scaleKeys, colorKeys));
+}
+
+void ParticleManager::BakeAllLifetimeCurves() {
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		BakeLifetimeCurves(static_cast<ParticleType>(i));
+	}
 }
 
 const ParticleParam* ParticleManager::GetParam(ParticleType type) const {
-	auto it = params_.find(type);
-	return (it != params_.end()) ? &it->second : nullptr;
+	return IsValidParticleType(type) ? &params_[type] : nullptr;
 }
 
 void ParticleManager::LoadCommonResources() {
-	// テクスチャを一括ロード
-	texExplosion_ = Novice::LoadTexture("./Resources/images/effect/explosion.png");
-	texDebris_ = Novice::LoadTexture("./Resources/images/effect/debris.png");
-	texHit_ = Novice::LoadTexture("./Resources/images/effect/hit.png");
-	texDust_ = Novice::LoadTexture("./Resources/images/effect/hit_ver1.png");
-	texRain_ = Novice::LoadTexture("./Resources/images/effect/rain.png");
-	texSnow_ = Novice::LoadTexture("./Resources/images/effect/snow.png");
-	texOrb_ = Novice::LoadTexture("./Resources/images/effect/orb.png");
-	texGlow_ = Novice::LoadTexture("./Resources/images/effect/particle_output/particle_glow.png");
-	texRing_ = Novice::LoadTexture("./Resources/images/effect/particle_output/particle_ring.png");
-	texSparkle_ = Novice::LoadTexture("./Resources/images/effect/particle_output/particle_sparkle.png");
-	texScratch_ = Novice::LoadTexture("./Resources/images/effect/particle_output/particle_scratch.png");
-	texSmoke_ = Novice::LoadTexture("./Resources/images/effect/particle_output/particle_smoke.png");
+	// テクスチャは全てパスで引き直す（読み込み順が変わってもハンドルの取り違えが起きない）
+	textureCache_.clear();
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		ResolveTexture(GetDefaultTexturePath(static_cast<ParticleType>(i)));
+	}
+	GetTrailTexture();
 
 #ifdef _DEBUG
 	Novice::ConsolePrintf("ParticleManager::LoadCommonResources\n");
-	Novice::ConsolePrintf("  Explosion: %d\n", texExplosion_);
-	Novice::ConsolePrintf("  Debris: %d\n", texDebris_);
-	Novice::ConsolePrintf("  Hit: %d\n", texHit_);
-	Novice::ConsolePrintf("  Dust: %d\n", texDust_);
+	for (const auto& [path, handle] : textureCache_) {
+		Novice::ConsolePrintf("  %s: %d\n", path.c_str(), handle);
+	}
 #endif
 
-	// パラメータにハンドルをセット
-	params_[ParticleType::Explosion].textureHandle = texExplosion_;
-	params_[ParticleType::Debris].textureHandle = texDebris_;
-	params_[ParticleType::Hit].textureHandle = texHit_;
-	params_[ParticleType::Dust].textureHandle = texDust_;
-	params_[ParticleType::MuzzleFlash].textureHandle = texHit_;
-	params_[ParticleType::Rain].textureHandle = texRain_;
-	params_[ParticleType::Snow].textureHandle = texSnow_;
-	params_[ParticleType::Orb].textureHandle = texOrb_;
-	params_[ParticleType::Charge].textureHandle = texGlow_;
-	params_[ParticleType::Glow].textureHandle = texGlow_;
-	params_[ParticleType::Shockwave].textureHandle = texRing_;
-	params_[ParticleType::Sparkle].textureHandle = texSparkle_;
-	params_[ParticleType::Slash].textureHandle = texScratch_;
-	params_[ParticleType::SmokeCloud].textureHandle = texSmoke_;
-}
-
-Particle& ParticleManager::GetNextParticle() {
-	Particle& p = particles_[nextIndex_];
-	nextIndex_ = (nextIndex_ + 1) % kMaxParticles;
-	return p;
-}
-
-float ParticleManager::RandomFloat(float min, float max) {
+	// 読み直したテクスチャのサイズは描画側で取り直す
+	drawList_.ClearTextureSizeCache();
+
+	// まだテクスチャが決まっていない種類は既定のものにする
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		ParticleType type = static_cast<ParticleType>(i);
+		if (params_[type].texturePath.empty()) {
+			params_[type].texturePath = GetDefaultTexturePath(type);
+		}
+	}
+	ResolveTextures();
+}
+
+const char* ParticleManager::GetDefaultTexturePath(ParticleType type) {
+	switch (type) {
+	case ParticleType::Explosion: return "./Resources/images/effect/explosion.png";
+	case ParticleType::Debris: return "./Resources/images/effect/debris.png";
+	case ParticleType::Hit: return "./Resources/images/effect/hit.png";
+	case ParticleType::Dust: return "./Resources/images/effect/hit_ver1.png";
+	case ParticleType::MuzzleFlash: return "./Resources/images/effect/hit.png";
+	case ParticleType::Rain: return "./Resources/images/effect/rain.png";
+	case ParticleType::Snow: return "./Resources/images/effect/snow.png";
+	case ParticleType::Orb: return "./Resources/images/effect/orb.png";
+	case ParticleType::Charge: return "./Resources/images/effect/particle_output/particle_glow.png";
+	case ParticleType::Glow: return "./Resources/images/effect/particle_output/particle_glow.png";
+	case ParticleType::Shockwave: return "./Resources/images/effect/particle_output/particle_ring.png";
+	case ParticleType::Sparkle: return "./Resources/images/effect/particle_output/particle_sparkle.png";
+	case ParticleType::Slash: return "./Resources/images/effect/particle_output/particle_scratch.png";
+	case ParticleType::SmokeCloud: return "./Resources/images/effect/particle_output/particle_smoke.png";
+	default: return "";
+	}
+}
+
+int ParticleManager::ResolveTexture(const std::string& path) {
+	if (path.empty()) return -1;
+
+	auto it = textureCache_.find(path);
+	if (it != textureCache_.end()) return it->second;
+
+	const int handle = Novice::LoadTexture(path.c_str());
+	textureCache_.emplace(path, handle);
+	return handle;
+}
+
+void ParticleManager::ResolveTextures() {
+	for (ParticleParam& param : params_) {
+		param.textureHandle = ResolveTexture(param.texturePath);
+	}
+}
+
+float ParticleManager::Lerp(float min, float max, float u) {
 	if (min >= max) return min;
-	return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
+	return min + (max - min) * u;
+}
+
+void ParticleManager::SetRandomSeed(uint64_t seed) {
+	randomSeed_ = seed;
+	random_.Seed(seed);
+
+	// 連続発生はエミッターごとに独立した列を持つ（他の Emit の回数に影響されない）
+	// 動いているエミッターは並び順に番号を振り直す
+	nextEmitterStream_ = 1;
+	for (int i = 0; i < emitters_.GetCount(); ++i) {
+		ParticleEmitterPool::Emitter& emitter = emitters_.At(i);
+		emitter.streamId = nextEmitterStream_++;
+		emitter.random.Seed(FastRandom::DeriveSeed(seed, emitter.streamId));
+	}
 }
 
 void ParticleManager::DrawDebugWindow() {
@@ -1022,8 +1514,8 @@ void ParticleManager::DrawDebugWindow() {
 	ImGui::SameLine();
 	if (ImGui::Button("+##Count")) p.count = std::min(50, p.count + 1);
 
-	ImGui::SliderInt("Life Min", &p.lifeMin, 1, 300);
-	ImGui::SliderInt("Life Max", &p.lifeMax, 1, 300);
+	ImGui::SliderFloat("Life Min (sec)", &p.lifeMin, 0.02f, 5.0f);
+	ImGui::SliderFloat("Life Max (sec)", &p.lifeMax, 0.02f, 5.0f);
 	if (p.lifeMin > p.lifeMax) p.lifeMax = p.lifeMin;
 
 	ImGui::Separator();
@@ -1069,10 +1561,20 @@ void ParticleManager::DrawDebugWindow() {
 
 	ImGui::Separator();
 
+	// 地形との当たり判定
+	ImGui::Checkbox("Collide With World", &p.collideWithWorld);
+	if (p.collideWithWorld) {
+		ImGui::SameLine();
+		ImGui::Checkbox("Kill On Hit", &p.killOnWorldHit);
+		if (!p.killOnWorldHit) {
+			ImGui::SliderFloat("Bounce Damping##World", &p.bounceDamping, 0.0f, 1.0f);
+		}
+	}
+
+	ImGui::Separator();
+
 	// ========== ★追加：環境パーティクル専用パラメータ ==========
-	if (currentDebugType_ == ParticleType::Rain ||
-		currentDebugType_ == ParticleType::Snow ||
-		currentDebugType_ == ParticleType::Orb) {
+	if (GetParticleTypeTraits(currentDebugType_).wind) {
 		ImGui::Text("=== Environment Specific ===");
 
 		if (currentDebugType_ == ParticleType::Rain) {
@@ -1084,13 +1586,11 @@ void ParticleManager::DrawDebugWindow() {
 			}
 		}
 
-		if (currentDebugType_ == ParticleType::Snow) {
-			ImGui::SliderFloat("Wind Strength", &p.windStrength, 0.0f, 100.0f);
-			ImGui::SameLine();
-			ImGui::TextDisabled("(?)");
-			if (ImGui::IsItemHovered()) {
-				ImGui::SetTooltip("Horizontal wind swaying effect");
-			}
+		ImGui::SliderFloat("Wind Strength", &p.windStrength, 0.0f, 100.0f);
+		ImGui::SameLine();
+		ImGui::TextDisabled("(?)");
+		if (ImGui::IsItemHovered()) {
+			ImGui::SetTooltip("Drift speed along the flow field (world units/sec at the strongest point)");
 		}
 
 		if (currentDebugType_ == ParticleType::Orb) {
@@ -1175,14 +1675,16 @@ void ParticleManager::DrawDebugWindow() {
 	// ========== 見た目設定 ==========
 	ImGui::Text("=== Appearance ===");
 
-	ImGui::SliderFloat("Start Scale", &p.scaleStart, 0.1f, 5.0f);
-	ImGui::SliderFloat("End Scale", &p.scaleEnd, 0.0f, 5.0f);
+	bool curveChanged = false;
+	curveChanged |= ImGui::SliderFloat("Start Scale", &p.scaleStart, 0.1f, 5.0f);
+	curveChanged |= ImGui::SliderFloat("End Scale", &p.scaleEnd, 0.0f, 5.0f);
 
 	ImGui::Text("Start Color:");
 	ColorRGBA startColor = ColorRGBA::FromUInt(p.colorStart);
 	float startRGBA[4] = { startColor.r, startColor.g, startColor.b, startColor.a };
 	if (ImGui::ColorEdit4("##StartColor", startRGBA)) {
 		p.colorStart = ColorRGBA(startRGBA[0], startRGBA[1], startRGBA[2], startRGBA[3]).ToUInt();
+		curveChanged = true;
 	}
 
 	ImGui::Text("End Color:");
@@ -1190,6 +1692,74 @@ void ParticleManager::DrawDebugWindow() {
 	float endRGBA[4] = { endColor.r, endColor.g, endColor.b, endColor.a };
 	if (ImGui::ColorEdit4("##EndColor", endRGBA)) {
 		p.colorEnd = ColorRGBA(endRGBA[0], endRGBA[1], endRGBA[2], endRGBA[3]).ToUInt();
+		curveChanged = true;
+	}
+
+	// ========== 多点カーブ ==========
+	// キーが無いときは上の Start / End がそのまま2点のカーブになる
+	if (ImGui::TreeNode("Lifetime Curves")) {
+		ImGui::Text("Scale Keys: %d", static_cast<int>(p.scaleCurve.size()));
+		for (size_t k = 0; k < p.scaleCurve.size(); ++k) {
+			ImGui::PushID(static_cast<int>(k));
+			ImGui::SetNextItemWidth(100.0f);
+			curveChanged |= ImGui::SliderFloat("##ScaleTime", &p.scaleCurve[k].time, 0.0f, 1.0f, "t=%.2f");
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(100.0f);
+			curveChanged |= ImGui::SliderFloat("##ScaleValue", &p.scaleCurve[k].value, 0.0f, 5.0f);
+			ImGui::SameLine();
+			if (ImGui::Button("x")) {
+				p.scaleCurve.erase(p.scaleCurve.begin() + k);
+				curveChanged = true;
+				ImGui::PopID();
+				break;
+			}
+			ImGui::PopID();
+		}
+		if (ImGui::Button("Add Scale Key")) {
+			// 初回は Start / End から始める
+			if (p.scaleCurve.empty()) {
+				p.scaleCurve = { { 0.0f, p.scaleStart }, { 1.0f, p.scaleEnd } };
+			}
+			p.scaleCurve.push_back({ 0.5f, ParticleCurve::EvaluateScale(p.scaleCurve, 0.5f) });
+			curveChanged = true;
+		}
+
+		ImGui::Separator();
+
+		ImGui::Text("Color Keys: %d", static_cast<int>(p.colorCurve.size()));
+		for (size_t k = 0; k < p.colorCurve.size(); ++k) {
+			ImGui::PushID(1000 + static_cast<int>(k));
+			ImGui::SetNextItemWidth(100.0f);
+			curveChanged |= ImGui::SliderFloat("##ColorTime", &p.colorCurve[k].time, 0.0f, 1.0f, "t=%.2f");
+			ImGui::SameLine();
+			ColorRGBA keyColor = ColorRGBA::FromUInt(p.colorCurve[k].color);
+			float keyRGBA[4] = { keyColor.r, keyColor.g, keyColor.b, keyColor.a };
+			if (ImGui::ColorEdit4("##ColorValue", keyRGBA, ImGuiColorEditFlags_NoInputs)) {
+				p.colorCurve[k].color = ColorRGBA(keyRGBA[0], keyRGBA[1], keyRGBA[2], keyRGBA[3]).ToUInt();
+				curveChanged = true;
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("x")) {
+				p.colorCurve.erase(p.colorCurve.begin() + k);
+				curveChanged = true;
+				ImGui::PopID();
+				break;
+			}
+			ImGui::PopID();
+		}
+		if (ImGui::Button("Add Color Key")) {
+			if (p.colorCurve.empty()) {
+				p.colorCurve = { { 0.0f, p.colorStart }, { 1.0f, p.colorEnd } };
+			}
+			p.colorCurve.push_back({ 0.5f, ParticleCurve::EvaluateColor(p.colorCurve, 0.5f) });
+			curveChanged = true;
+		}
+
+		ImGui::TreePop();
+	}
+
+	if (curveChanged) {
+		BakeLifetimeCurves(currentDebugType_);
 	}
 
 	ImGui::Separator();
@@ -1221,10 +1791,7 @@ void ParticleManager::DrawDebugWindow() {
 	}
 
 	// 活性パーティクル数表示
-	int aliveCount = 0;
-	for (const auto& particle : particles_) {
-		if (particle.IsAlive()) aliveCount++;
-	}
+	int aliveCount = particles_.GetCount();
 	ImGui::Separator();
 	ImGui::Text("Active Particles: %d / %d", aliveCount, kMaxParticles);
 
@@ -1239,30 +1806,16 @@ void ParticleManager::DrawDebugWindow() {
 // ========== JSONシリアライズ ==========
 json ParticleManager::SerializeParams() const {
 	json root = json::object();
+	root["version"] = kParamsFormatVersion;
 
-	for (const auto& [type, param] : params_) {
-		std::string typeName;
-		switch (type) {
-		case ParticleType::Explosion: typeName = "Explosion"; break;
-		case ParticleType::Debris: typeName = "Debris"; break;
-		case ParticleType::Hit: typeName = "Hit"; break;
-		case ParticleType::Dust: typeName = "Dust"; break;
-		case ParticleType::MuzzleFlash: typeName = "MuzzleFlash"; break;
-		case ParticleType::Rain: typeName = "Rain"; break;
-		case ParticleType::Snow: typeName = "Snow"; break;
-		case ParticleType::Orb: typeName = "Orb"; break;
-		case ParticleType::Charge: typeName = "Charge"; break;
-		case ParticleType::Glow: typeName = "Glow"; break;
-		case ParticleType::Shockwave: typeName = "Shockwave"; break;
-		case ParticleType::Sparkle: typeName = "Sparkle"; break;
-		case ParticleType::Slash: typeName = "Slash"; break;
-		case ParticleType::SmokeCloud: typeName = "SmokeCloud"; break;
-		default: typeName = "Unknown"; break;
-		}
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		const ParticleType type = static_cast<ParticleType>(i);
+		const ParticleParam& param = params_[type];
+		std::string typeName = ParticleTypeToString(type);
 
 		nlohmann::json paramJson;
 		paramJson["count"] = param.count;
-		paramJson["textureHandle"] = param.textureHandle;
+		paramJson["texture"] = param.texturePath;
 		paramJson["lifeMin"] = param.lifeMin;
 		paramJson["lifeMax"] = param.lifeMax;
 		paramJson["speedMin"] = param.speedMin;
@@ -1287,6 +1840,22 @@ json ParticleManager::SerializeParams() const {
 		paramJson["scaleEnd"] = param.scaleEnd;
 		paramJson["colorStart"] = param.colorStart;
 		paramJson["colorEnd"] = param.colorEnd;
+
+		// 多点カーブは設定されているときだけ書く（無ければ Start / End の2点）
+		if (!param.scaleCurve.empty()) {
+			json scaleCurve = json::array();
+			for (const ParticleScaleKey& key : param.scaleCurve) {
+				scaleCurve.push_back({ {"time", key.time}, {"value", key.value} });
+			}
+			paramJson["scaleCurve"] = scaleCurve;
+		}
+		if (!param.colorCurve.empty()) {
+			json colorCurve = json::array();
+			for (const ParticleColorKey& key : param.colorCurve) {
+				colorCurve.push_back({ {"time", key.time}, {"color", key.color} });
+			}
+			paramJson["colorCurve"] = colorCurve;
+		}
 		paramJson["rotationSpeedMin"] = param.rotationSpeedMin;
 		paramJson["rotationSpeedMax"] = param.rotationSpeedMax;
 		paramJson["useAnimation"] = param.useAnimation;
@@ -1296,11 +1865,30 @@ json ParticleManager::SerializeParams() const {
 		paramJson["animSpeed"] = param.animSpeed;
 		paramJson["blendMode"] = BlendModeToString(param.blendMode);
 
+		// 発生源の形状・追従・連続発生
+		paramJson["emitterShape"] = param.emitterShape == EmitterShape::Line ? "Line" :
+			param.emitterShape == EmitterShape::Rectangle ? "Rectangle" : "Point";
+		paramJson["emitterSize"] = {
+			{"x", param.emitterSize.x},
+			{"y", param.emitterSize.y}
+		};
+		paramJson["useHoming"] = param.useHoming;
+		paramJson["homingStrength"] = param.homingStrength;
+		paramJson["isContinuous"] = param.isContinuous;
+		paramJson["emitInterval"] = param.emitInterval;
+
 		// ★環境パーティクル専用パラメータ
 		paramJson["bounceDamping"] = param.bounceDamping;
 		paramJson["windStrength"] = param.windStrength;
 		paramJson["floatAmplitude"] = param.floatAmplitude;
 		paramJson["floatFrequency"] = param.floatFrequency;
+		paramJson["priority"] = param.priority;
+		paramJson["useGroundHitEmit"] = param.useGroundHitEmit;
+		paramJson["groundHitEmitType"] = ParticleTypeToString(param.groundHitEmitType);
+		paramJson["collideWithWorld"] = param.collideWithWorld;
+		paramJson["killOnWorldHit"] = param.killOnWorldHit;
+		paramJson["useCoarseBounds"] = param.useCoarseBounds;
+		paramJson["coarseBoundsMargin"] = param.coarseBoundsMargin;
 
 		root[typeName] = paramJson;
 	}
@@ -1310,7 +1898,12 @@ json ParticleManager::SerializeParams() const {
 
 bool ParticleManager::DeserializeParams(const nlohmann::json& j) {
 	try {
-		params_.clear();
+		// JSON に無い種類は未設定（テクスチャ無し）に戻す
+		params_ = ParticleTypeTable<ParticleParam>{};
+
+		// 形式1（version なし）は寿命がフレーム数なので秒に直す
+		const int version = JsonUtil::GetValue<int>(j, "version", 1);
+		const float lifeScale = (version < 2) ? 1.0f / kLegacyFramesPerSecond : 1.0f;
 
 		std::map<std::string, ParticleType> typeMap = {
 			{"Explosion", ParticleType::Explosion},
@@ -1335,9 +1928,14 @@ bool ParticleManager::DeserializeParams(const nlohmann::json& j) {
 				ParticleParam param;
 
 				param.count = JsonUtil::GetValue<int>(paramJson, "count", 1);
-				param.textureHandle = JsonUtil::GetValue<int>(paramJson, "textureHandle", -1);
-				param.lifeMin = JsonUtil::GetValue<int>(paramJson, "lifeMin", 30);
-				param.lifeMax = JsonUtil::GetValue<int>(paramJson, "lifeMax", 60);
+				// テクスチャはパスで持つ（古いファイルの textureHandle は読み込み順で変わるので使わない）
+				param.texturePath = JsonUtil::GetValue<std::string>(paramJson, "texture", GetDefaultTexturePath(type));
+				if (paramJson.contains("lifeMin")) {
+					param.lifeMin = JsonUtil::GetValue<float>(paramJson, "lifeMin", param.lifeMin) * lifeScale;
+				}
+				if (paramJson.contains("lifeMax")) {
+					param.lifeMax = JsonUtil::GetValue<float>(paramJson, "lifeMax", param.lifeMax) * lifeScale;
+				}
 				param.speedMin = JsonUtil::GetValue<float>(paramJson, "speedMin", 100.0f);
 				param.speedMax = JsonUtil::GetValue<float>(paramJson, "speedMax", 200.0f);
 				param.angleBase = JsonUtil::GetValue<float>(paramJson, "angleBase", 0.0f);
@@ -1416,24 +2014,29 @@ bool ParticleManager::DeserializeParams(const nlohmann::json& j) {
 				param.windStrength = JsonUtil::GetValue<float>(paramJson, "windStrength", 0.0f);
 				param.floatAmplitude = JsonUtil::GetValue<float>(paramJson, "floatAmplitude", 0.0f);
 				param.floatFrequency = JsonUtil::GetValue<float>(paramJson, "floatFrequency", 1.0f);
-
-				// テクスチャハンドル復元
-				if (param.textureHandle == -1) {
-					switch (type) {
-					case ParticleType::Explosion: param.textureHandle = texExplosion_; break;
-					case ParticleType::Debris: param.textureHandle = texDebris_; break;
-					case ParticleType::Hit: param.textureHandle = texHit_; break;
-					case ParticleType::Dust: param.textureHandle = texDust_; break;
-					case ParticleType::MuzzleFlash: param.textureHandle = texExplosion_; break;
-					case ParticleType::Rain: param.textureHandle = texRain_; break;
-					case ParticleType::Snow: param.textureHandle = texSnow_; break;
-					case ParticleType::Orb: param.textureHandle = texOrb_; break;
-					case ParticleType::Charge: param.textureHandle = texGlow_; break;
-					case ParticleType::Glow: param.textureHandle = texGlow_; break;
-					case ParticleType::Shockwave: param.textureHandle = texRing_; break;
-					case ParticleType::Sparkle: param.textureHandle = texSparkle_; break;
-					case ParticleType::Slash: param.textureHandle = texScratch_; break;
-					case ParticleType::SmokeCloud: param.textureHandle = texSmoke_; break;
+				param.priority = JsonUtil::GetValue<int>(paramJson, "priority", GetDefaultPriority(type));
+				param.useGroundHitEmit = JsonUtil::GetValue<bool>(paramJson, "useGroundHitEmit", false);
+				param.groundHitEmitType = StringToParticleType(
+					JsonUtil::GetValue<std::string>(paramJson, "groundHitEmitType", "Dust"), ParticleType::Dust);
+				param.collideWithWorld = JsonUtil::GetValue<bool>(paramJson, "collideWithWorld", false);
+				param.killOnWorldHit = JsonUtil::GetValue<bool>(paramJson, "killOnWorldHit", false);
+				param.useCoarseBounds = JsonUtil::GetValue<bool>(paramJson, "useCoarseBounds", false);
+				param.coarseBoundsMargin = JsonUtil::GetValue<float>(paramJson, "coarseBoundsMargin", 128.0f);
+
+				if (paramJson.contains("scaleCurve") && paramJson["scaleCurve"].is_array()) {
+					for (const auto& keyJson : paramJson["scaleCurve"]) {
+						ParticleScaleKey key;
+						key.time = JsonUtil::GetValue<float>(keyJson, "time", 0.0f);
+						key.value = JsonUtil::GetValue<float>(keyJson, "value", 1.0f);
+						param.scaleCurve.push_back(key);
+					}
+				}
+				if (paramJson.contains("colorCurve") && paramJson["colorCurve"].is_array()) {
+					for (const auto& keyJson : paramJson["colorCurve"]) {
+						ParticleColorKey key;
+						key.time = JsonUtil::GetValue<float>(keyJson, "time", 0.0f);
+						key.color = JsonUtil::GetValue<unsigned int>(keyJson, "color", 0xFFFFFFFF);
+						param.colorCurve.push_back(key);
 					}
 				}
 
@@ -1441,6 +2044,8 @@ bool ParticleManager::DeserializeParams(const nlohmann::json& j) {
 			}
 		}
 
+		ResolveTextures();
+		BakeAllLifetimeCurves();
 		return true;
 	}
 	catch (const std::exception& e) {
@@ -1460,6 +2065,9 @@ bool ParticleManager::SaveParamsToJson(const std::string& filepath) {
 #ifdef _DEBUG
 			Novice::ConsolePrintf("ParticleManager: Parameters saved to %s\n", filepath.c_str());
 #endif
+			// JSON の後に書くので、キャッシュの方が新しくなる
+			ParticlePresetCache::Save(GetParamsCachePath(filepath), params_);
+			WatchParamsFile(filepath);
 			return true;
 		}
 
@@ -1492,6 +2100,17 @@ bool ParticleManager::LoadParamsFromJson(const std::string& filepath) {
 #ifdef _DEBUG
 		Novice::ConsolePrintf("ParticleManager: Parameters loaded from %s\n", filepath.c_str());
 #endif
+		// 古い形式は読み込み時に変換済みなので、新しい形式で書き直す（キャッシュも一緒に書かれる）
+		if (JsonUtil::GetValue<int>(j, "version", 1) < kParamsFormatVersion) {
+#ifdef _DEBUG
+			Novice::ConsolePrintf("ParticleManager: Migrated %s to format version %d\n", filepath.c_str(), kParamsFormatVersion);
+#endif
+			SaveParamsToJson(filepath);
+		}
+		else {
+			ParticlePresetCache::Save(GetParamsCachePath(filepath), params_);
+			WatchParamsFile(filepath);
+		}
 		return true;
 	}
 
@@ -1500,4 +2119,83 @@ bool ParticleManager::LoadParamsFromJson(const std::string& filepath) {
 #endif
 	LoadParams();
 	return false;
-}
\ No newline at end of file
+}
+
+// ========== バイナリキャッシュ ==========
+std::string ParticleManager::GetParamsCachePath(const std::string& jsonPath) {
+	return std::filesystem::path(jsonPath).replace_extension(".bin").string();
+}
+
+bool ParticleManager::LoadParamsFromCache(const std::string& cachePath, const std::string& sourcePath) {
+	if (!ParticlePresetCache::IsUpToDate(cachePath, sourcePath)) {
+		return false;
+	}
+
+	ParticleTypeTable<ParticleParam> params;
+	if (!ParticlePresetCache::Load(cachePath, params)) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticleManager: Cache %s is unreadable. Falling back to JSON.\n", cachePath.c_str());
+#endif
+		return false;
+	}
+
+	params_ = std::move(params);
+	ResolveTextures();
+	BakeAllLifetimeCurves();
+	WatchParamsFile(sourcePath);
+#ifdef _DEBUG
+	Novice::ConsolePrintf("ParticleManager: Parameters loaded from cache %s\n", cachePath.c_str());
+#endif
+	return true;
+}
+
+// ========== ホットリロード ==========
+void ParticleManager::SetHotReloadEnabled(bool enabled) {
+	hotReloadEnabled_ = enabled;
+	hotReloadTimer_ = 0.0f;
+}
+
+void ParticleManager::WatchParamsFile(const std::string& filepath) {
+	paramsPath_ = filepath;
+	std::error_code ec;
+	paramsWriteTime_ = std::filesystem::last_write_time(filepath, ec);
+}
+
+bool ParticleManager::ReloadParamsIfChanged() {
+	if (paramsPath_.empty()) return false;
+
+	std::error_code ec;
+	const auto writeTime = std::filesystem::last_write_time(paramsPath_, ec);
+	if (ec || writeTime == paramsWriteTime_) return false;
+
+	// 書きかけのファイルを読んで失敗しても、次に更新されたときにまた試す
+	paramsWriteTime_ = writeTime;
+
+	nlohmann::json j;
+	if (!JsonUtil::LoadFromFile(paramsPath_, j)) {
+		return false;
+	}
+
+	// 粒やエミッターには触らず、設定だけ差し替える（失敗したら元に戻す）
+	ParticleTypeTable<ParticleParam> previous = params_;
+	if (!DeserializeParams(j)) {
+		params_ = std::move(previous);
+		BakeAllLifetimeCurves();
+		return false;
+	}
+
+	ParticlePresetCache::Save(GetParamsCachePath(paramsPath_), params_);
+
+	// 動いている種類ごとのエミッター（環境パーティクルなど）が止まらないよう、開始時の強制設定をかけ直す
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		const ParticleType type = static_cast<ParticleType>(i);
+		if (emitters_.IsAlive(typeEmitters_[type])) {
+			ApplyEnvironmentDefaults(type);
+		}
+	}
+	++hotReloadCount_;
+#ifdef _DEBUG
+	Novice::ConsolePrintf("ParticleManager: Hot reloaded %s\n", paramsPath_.c_str());
+#endif
+	return true;
+}
@@ -1,31 +1,38 @@
 ﻿#pragma once
-#include "Particle.h"
+#include "ParticleStorage.h"
+#include "ParticleDrawList.h"
+#include "ParticleEmitterPool.h"
+#include "ParticleFlowField.h"
+#include "ParticleCollisionWorld.h"
+#include "ParticleBudgetGovernor.h"
+#include "ParticleTrail.h"
+#include "ParticleReplay.h"
+#include "JobSystem.h"
+#include "FastRandom.h"
 #include "Vector2.h"
 #include "Novice.h"
 #include <array>
+#include <filesystem>
+#include <span>
+#include <unordered_map>
 #include <vector>
-#include <map>
 #include <string>
 #include "json.hpp"
 #include "ParticleEnum.h"
+#include "ParticleTypeTraits.h"
 
 // 前方宣言
 class Camera2D;
 class DebugWindow;
-
-// エミッターの追従モード
-enum class EmitterFollowMode {
-	None,           // 固定位置（発生時の座標で固定）
-	FollowTarget,   // ターゲット追従（プレイヤーなど）
-	WorldPoint      // ワールド座標の固定点
-};
+class ParticleBenchmark;
 
 // 1種類のエフェクトの設定データ（拡張版）
 struct ParticleParam {
 	int count = 1;
-	int textureHandle = -1;
-	int lifeMin = 30;
-	int lifeMax = 60;
+	int textureHandle = -1;   // 読み込み時に texturePath から解決する（保存はしない）
+	std::string texturePath;  // テクスチャのパス（空ならテクスチャ無し＝発生しない）
+	float lifeMin = 0.5f;  // 寿命（秒）
+	float lifeMax = 1.0f;
 	float speedMin = 100.0f;
 	float speedMax = 200.0f;
 	float angleBase = 0.0f;
@@ -39,6 +46,10 @@ struct ParticleParam {
 	float scaleEnd = 0.0f;
 	unsigned int colorStart = 0xFFFFFFFF;
 	unsigned int colorEnd = 0xFFFFFF00;
+	// 寿命に対する多点カーブ（空なら scaleStart → scaleEnd / colorStart → colorEnd の2点）
+	// 読み込み時にテーブルへ焼き込むので、変更したら BakeLifetimeCurves を呼ぶ
+	std::vector<ParticleScaleKey> scaleCurve;
+	std::vector<ParticleColorKey> colorCurve;
 	float rotationSpeedMin = 0.0f;
 	float rotationSpeedMax = 0.0f;
 	bool useAnimation = false;
@@ -52,7 +63,7 @@ struct ParticleParam {
 	EmitterShape emitterShape = EmitterShape::Point;
 	Vector2 emitterSize = { 0.0f, 0.0f };
 
-	// Homing（追従）
+	// Homing（追従）。ParticleTypeTraits の homing を持つ種類（Charge）だけで効く
 	bool useHoming = false;
 	float homingStrength = 0.0f;
 
@@ -61,32 +72,89 @@ struct ParticleParam {
 	float emitInterval = 0.0f;         // 発生間隔（秒）
 
 	// 環境エフェクト専用パラメータ
-	float bounceDamping = 0.3f;        // 地面反発係数（雨用）
-	float windStrength = 0.0f;         // 横風の強さ（雪用）
+	float bounceDamping = 0.3f;        // 反発係数（雨の地面・地形に当たって跳ね返る種類）
+	float windStrength = 0.0f;         // 流れ場の風の強さ（雨・雪・オーブ・煙用、ワールド長/秒）
 	float floatAmplitude = 0.0f;       // 浮遊の振幅（オーブ用）
 	float floatFrequency = 1.0f;       // 浮遊の周波数（オーブ用）
+
+	// プールが満杯のときの優先度（大きいほど残る）
+	int priority = 1;
+
+	// 地面に触れたときに別のエフェクトを発生させる（雨の跳ねなど）
+	bool useGroundHitEmit = false;
+	ParticleType groundHitEmitType = ParticleType::Dust;
+
+	// 地形（GetCollisionWorld に登録した円・矩形・タイルマップ）との当たり判定
+	bool collideWithWorld = false;     // 判定する
+	bool killOnWorldHit = false;       // 当たったら消える（false なら bounceDamping で跳ね返る）
+
+	// 種類ごとの粗い外接矩形で、画面外の粒をまとめて捨てる（遠くの雨など）
+	bool useCoarseBounds = false;
+	float coarseBoundsMargin = 128.0f;  // 位置の外接矩形に足す余白（ワールド長、粒の大きさ以上にする）
 };
 
 class ParticleManager {
 	friend class DebugWindow;
+	friend class ParticleBenchmark;
+	friend class ParticleReplay;
 public:
 	ParticleManager();
 	~ParticleManager() = default;
 
 	void Update(float deltaTime);
 	void Draw(const Camera2D& camera);
+	// 描画リストと軌跡の頂点を作るところまで（DrawQuad は呼ばない。Draw はこれ + 提出）
+	void PrepareDraw(const Camera2D& camera);
 	void Emit(ParticleType type, const Vector2& pos);
 	void EmitWithTarget(ParticleType type, const Vector2& pos, const Vector2* target);
-	void EmitDashGhost(const Vector2& pos, float scale, float rotation, bool isFlipX, int texHandle);
+	// ダッシュの残像（呼ぶたびに位置を dashTrail の軌跡に足す。無効か間が空いていたら新しい軌跡を作って dashTrail に入れる）
+	// ダッシュする物体ごとに TrailHandle を1つ持って渡し、物体が消えるときは StopTrail で放す。
+	// 帯には texHandle の画像（中央の1列）を貼り、太さは画像の高さ × scale
+	void EmitDashGhost(TrailHandle& dashTrail, const Vector2& pos, float scale, int texHandle);
+
+	// 複数地点からまとめて発生させる（パラメータの解決とスロットの確保は1回だけ）
+	// positions の順に Emit を呼んだのと同じ粒が生成される
+	void EmitBatch(ParticleType type, std::span<const Vector2> positions);
+	void EmitBatchWithTarget(ParticleType type, std::span<const Vector2> positions, const Vector2* target);
+
+	// 発生の予約（次の Update の最初に、種類ごとにまとめて EmitBatch する）
+	void QueueEmit(ParticleType type, const Vector2& pos);
+	void QueueEmitWithTarget(ParticleType type, const Vector2& pos, const Vector2* target);
+	void FlushEmitQueue();
+	int GetQueuedEmitCount() const { return static_cast<int>(emitQueue_.size()); }
+
 	void DrawDebugWindow();
 	void Clear();
 	void LoadCommonResources();
 
-	// 連続発生の開始/停止
+	// ========== 連続発生エミッター（ハンドル版、数に上限なし） ==========
+	// 止めたエミッターのハンドルは無効になり、以降の呼び出しは無視される
+	EmitterHandle StartEmitter(ParticleType type, const Vector2& pos, const Vector2* target = nullptr);
+	void StopEmitter(EmitterHandle handle);
+	bool IsEmitterAlive(EmitterHandle handle) const { return emitters_.IsAlive(handle); }
+	void SetEmitterPosition(EmitterHandle handle, const Vector2& pos);
+	void SetEmitterFollow(EmitterHandle handle, EmitterFollowMode mode, const Vector2* followTarget);
+	void SetEmitterTarget(EmitterHandle handle, const Vector2* target);
+	int GetActiveEmitterCount() const { return emitters_.GetCount(); }
+
+	// 連続発生の開始/停止（種類ごとに1つのエミッターを持つ簡易版。中身はハンドル版）
 	void StartContinuousEmit(ParticleType type, const Vector2& pos);
 	void StartContinuousEmitWithTarget(ParticleType type, const Vector2& pos, const Vector2* target);
 	void StopContinuousEmit(ParticleType type);
-	void StopAllContinuousEmit();
+	void StopAllContinuousEmit();  // ハンドル版も含めて全て止める
+	bool IsContinuousEmitActive(ParticleType type) const { return emitters_.IsAlive(typeEmitters_[type]); }
+
+	// ========== 軌跡（リボン） ==========
+	// 動く物体1つにつき1本。毎フレーム PushTrail で位置を渡すと、つながった帯として描かれる
+	// StopTrail したものは残りが消えきったら自動で片付く（ハンドルは無効になる）
+	TrailHandle StartTrail(const ParticleTrailSettings& settings);
+	void PushTrail(TrailHandle handle, const Vector2& pos);
+	void StopTrail(TrailHandle handle);
+	bool IsTrailAlive(TrailHandle handle) const { return trails_.IsAlive(handle); }
+	int GetActiveTrailCount() const { return trails_.GetCount(); }
+	int GetLastTrailQuadCount() const { return trails_.GetLastQuadCount(); }
+	// 軌跡用の既定のテクスチャ（読み込み済みのハンドル）
+	int GetTrailTexture();
 
 	// 環境パーティクル専用API
 	void StartEnvironmentEffect(ParticleType type, EmitterFollowMode mode, const Vector2& basePos = { 0.0f, 0.0f });
@@ -95,23 +163,106 @@ public:
 	void SetFollowTarget(ParticleType type, const Vector2* target);
 	void UpdateFollowPosition(ParticleType type, const Vector2& newPos);
 
+	// ========== 記録と再生 ==========
+	// 記録中は発生・エミッターの操作・Update の呼び出しを溜める（ParticleReplay::Run で再生する）
+	// 開始時の乱数シード・固定ステップ・プールの方針・地面の高さもヘッダに残す
+	void StartRecording();
+	void StopRecording() { recorder_.Stop(); }
+	bool IsRecording() const { return recorder_.IsRecording(); }
+	const ParticleReplayLog& GetRecordedLog() const { return recorder_.GetLog(); }
+	bool SaveRecording(const std::string& filepath) const;
+
+	// プールが満杯のときの方針
+	void SetPoolPolicy(ParticlePoolPolicy policy) { particles_.SetPolicy(policy); }
+	ParticlePoolPolicy GetPoolPolicy() const { return particles_.GetPolicy(); }
+	const ParticlePoolStats& GetPoolStats() const { return particles_.GetStats(); }
+	void ResetPoolStats() { particles_.ResetStats(); }
+	int GetActiveParticleCount() const { return particles_.GetCount(); }
+
+	// 乱数のシード（同じシード・同じ操作なら発生する粒の列はビット単位で同じ）
+	void SetRandomSeed(uint64_t seed);
+	uint64_t GetRandomSeed() const { return randomSeed_; }
+
+	// 固定ステップ更新（Update に渡した時間を step 秒ずつ刻んで進める）
+	// 1フレームに進めるのは maxSubSteps まで。それを超えた分は追いかけずに捨てる
+	void SetFixedStep(float step);
+	float GetFixedStep() const { return fixedStep_; }
+	void SetMaxSubSteps(int count);
+	int GetMaxSubSteps() const { return maxSubSteps_; }
+	int GetLastSubStepCount() const { return lastSubSteps_; }          // 直前の Update で進めたステップ数
+	unsigned int GetSkippedStepCount() const { return skippedSteps_; } // 上限を超えて捨てたステップ数（累計）
+
+	// 風の流れ場（windStrength を持つ環境パーティクルが流される）
+	// 起動時に JSON（Resources/Data/flow_field.json）があれば読み、無ければカールノイズで作る
+	bool LoadFlowFieldFromJson(const std::string& filepath);
+	void BuildCurlNoiseFlowField(uint64_t seed);
+	const ParticleFlowField& GetFlowField() const { return flowField_; }
+	// 場を流す速さ（ワールド長/秒。場そのものが動くので、同じ場所でも風向きが変わっていく）
+	void SetFlowScrollSpeed(const Vector2& speed) { flowScrollSpeed_ = speed; }
+	const Vector2& GetFlowScrollSpeed() const { return flowScrollSpeed_; }
+
+	// 粒が当たる地形（collideWithWorld の種類だけが判定する）
+	// ステージの読み込み時に形状を登録する。グリッドは次の Update の前に作り直される
+	ParticleCollisionWorld& GetCollisionWorld() { return collisionWorld_; }
+	const ParticleCollisionWorld& GetCollisionWorld() const { return collisionWorld_; }
+
+	// 負荷に応じて装飾系（優先度の低い種類）の発生数・連続発生の頻度を自動で絞る
+	// 既定では自分で測った Update + Draw の時間を予算と比べる。
+	// FrameTime にしたときはメインループから毎フレーム ReportFrameTime を呼ぶ
+	ParticleBudgetGovernor& GetBudgetGovernor() { return governor_; }
+	const ParticleBudgetGovernor& GetBudgetGovernor() const { return governor_; }
+	void ReportFrameTime(float milliseconds) { reportedFrameMs_ = milliseconds; }
+	float GetLastUpdateMs() const { return lastUpdateMs_; }
+	float GetLastDrawMs() const { return lastDrawMs_; }
+
+	// 更新に使うワーカースレッド数（0 ならメインスレッドのみ）
+	void SetWorkerThreadCount(int count) { jobSystem_.SetWorkerCount(count); }
+	int GetWorkerThreadCount() const { return jobSystem_.GetWorkerCount(); }
+
+	// 描画時のカメラ範囲カリング
+	void SetCullingEnabled(bool enabled) { cullingEnabled_ = enabled; }
+	bool IsCullingEnabled() const { return cullingEnabled_; }
+	int GetDrawnParticleCount() const { return drawList_.GetDrawnCount(); }
+	int GetCulledParticleCount() const { return drawList_.GetCulledCount(); }
+
 	// 地面との衝突判定を設定
 	void SetGroundLevel(float groundY);
 	float GetGroundLevel() const { return groundLevel_; }
 
-	// JSON保存/読み込み
+	// JSON保存/読み込み（保存・読み込みのたびに同じ名前の .bin キャッシュも書き直す）
 	bool SaveParamsToJson(const std::string& filepath);
 	bool LoadParamsFromJson(const std::string& filepath);
 
+	// コンパイル済みのバイナリキャッシュから読む（キャッシュが JSON より古い・壊れているなら false）
+	bool LoadParamsFromCache(const std::string& cachePath, const std::string& sourcePath);
+	static std::string GetParamsCachePath(const std::string& jsonPath);
+
+	// ホットリロード：最後に読み書きした JSON の更新を監視し、変わっていたら設定だけ読み直す
+	// （生きている粒・動いているエミッターはそのまま。以降の発生から新しい設定になる）
+	void SetHotReloadEnabled(bool enabled);
+	bool IsHotReloadEnabled() const { return hotReloadEnabled_; }
+	bool ReloadParamsIfChanged();  // 読み直したら true
+	int GetHotReloadCount() const { return hotReloadCount_; }
+	const std::string& GetParamsPath() const { return paramsPath_; }
+
 	// パラメータの取得/設定
 	ParticleParam* GetParam(ParticleType type);
 	const ParticleParam* GetParam(ParticleType type) const;
 
+	// スケール・色のカーブをテーブルに焼き直す（パラメータを直接書き換えたとき用）
+	void BakeLifetimeCurves(ParticleType type);
+	void BakeAllLifetimeCurves();
+
 private:
 	void LoadParams();
-	Particle& GetNextParticle();
-	float RandomFloat(float min, float max);
-	Vector2 GenerateEmitPosition(const Vector2& basePos, const ParticleParam& param);
+	// 1ステップ分の更新（連続発生・粒の更新・地面ヒットの発生）
+	void Step(float deltaTime);
+	// positions の各地点から1回分ずつ発生させる（Emit / EmitBatch / 連続発生の共通処理）。乱数は random から取る
+	void EmitBurst(ParticleType type, std::span<const Vector2> positions, const Vector2* target, FastRandom& random);
+	// [0, 1) の乱数 u を [min, max) に変換（min >= max なら min）
+	static float Lerp(float min, float max, float u);
+	// u, v は [0, 1) の乱数（形状によっては使わない）
+	Vector2 GenerateEmitPosition(const Vector2& basePos, const ParticleParam& param, float u, float v);
 
 	// JSONシリアライズ用ヘルパー
 	nlohmann::json SerializeParams() const;
@@ -120,40 +271,129 @@ private:
 	// ブレンドモード変換ヘルパー
 	static const char* BlendModeToString(BlendMode mode);
 	static BlendMode StringToBlendMode(const std::string& str);
+	static const char* ParticleTypeToString(ParticleType type);
+	static ParticleType StringToParticleType(const std::string& str, ParticleType fallback);
+
+	// タイプごとの既定の優先度
+	static int GetDefaultPriority(ParticleType type);
+	// タイプごとの既定のテクスチャ
+	static const char* GetDefaultTexturePath(ParticleType type);
+
+	// パスからテクスチャハンドルを引く（同じパスは1回だけ読む）
+	int ResolveTexture(const std::string& path);
+	// 全種類の textureHandle を texturePath から引き直す
+	void ResolveTextures();
+	// 読み書きした JSON を監視対象にする
+	void WatchParamsFile(const std::string& filepath);
+
+	// 環境パーティクルの開始時の強制設定（連続発生・発生間隔が無ければ既定の間隔と発生範囲）
+	// StartEnvironmentEffect と、設定ファイルの読み直しで動いているエミッターに対して呼ぶ
+	void ApplyEnvironmentDefaults(ParticleType type);
+
+	// 種類ごとの簡易エミッターを（動いていれば）作り直さずに設定し直す
+	EmitterHandle StartTypeEmitter(ParticleType type);
+	// エミッターを作って乱数の列を割り当てる（記録はしない。StartEmitter / StartTypeEmitter の共通処理）
+	EmitterHandle CreateEmitter(ParticleType type, const Vector2& pos, const Vector2* target);
+
+	// 予約された発生を処理する（記録はしない。Update・Step から呼ぶ）
+	void FlushQueuedEmits();
+	// ダッシュの軌跡を作る（記録はしない。EmitDashGhost と再生の共通処理）
+	TrailHandle CreateDashTrail(int texHandle, float width);
+
+	// ハンドル版エミッターの操作を記録する（記録前に作られたエミッターなら書かない）
+	void RecordEmitterOp(ParticleReplayOp op, EmitterHandle handle, const Vector2& pos,
+		uint8_t mode = 0, const Vector2* target = nullptr, uint8_t flags = 0);
+	// 追従対象の今の位置を記録する（Update の最初）
+	void RecordFollowTargets();
+
+	static const int kMaxParticles = 2048;
+
+	// 固定ステップ
+	static constexpr float kDefaultFixedStep = 1.0f / 60.0f;
+	float fixedStep_ = kDefaultFixedStep;
+	int maxSubSteps_ = 4;
+	float stepAccumulator_ = 0.0f;
+	int lastSubSteps_ = 0;
+	unsigned int skippedSteps_ = 0;
+
+	ParticleStorage particles_;  // SoA ストレージ（容量 kMaxParticles、生存粒は先頭に詰める）
+	ParticleDrawList drawList_;  // 描画リスト（毎フレーム作り直す）
 
-	// 連続発生の管理構造体
-	struct ContinuousEmitter {
+	// 更新の並列化（チャンク単位）
+	static const int kUpdateChunkSize = 512;
+	static const int kMaxDefaultWorkerThreads = 3;  // 既定のワーカー数の上限（コアが少なければ減らす）
+	JobSystem jobSystem_{ JobSystem::GetDefaultWorkerCount(kMaxDefaultWorkerThreads) };
+	// チャンクごとの地面ヒット（同期点でチャンク順にまとめて発生させる）
+	std::vector<std::vector<ParticleGroundHit>> groundHitQueues_;
+
+	// 種類ごとの位置の外接矩形（更新で作り直し、発生時に広げる）
+	bool cullingEnabled_ = true;
+	ParticleTypeTable<ParticleBounds> typeBounds_;
+	std::vector<ParticleTypeTable<ParticleBounds>> chunkBounds_;
+	ParticleTypeTable<uint8_t> typeRejected_;  // Draw 内の作業用
+
+	// 乱数（Emit / EmitWithTarget 用。連続発生はエミッターごとに持つ）
+	static const int kRandomsPerParticle = 7;  // 寿命・位置x・位置y・速さ・角度・回転速度・サイズ
+	uint64_t randomSeed_ = FastRandom::kDefaultSeed;
+	FastRandom random_;
+	std::vector<float> burstRandoms_;  // 1回の発生ぶんの乱数（使い回す）
+	std::vector<ParticleSpawnDesc> burstDescs_;  // 1回の発生ぶんの初期化データ（使い回す）
+	std::vector<int> burstIndices_;              // 生成されたインデックス（使い回す）
+
+	// 予約された発生（FlushEmitQueue でまとめて処理する）
+	struct EmitCommand {
 		ParticleType type;
-		Vector2 position;                    // 基準位置
-		EmitterFollowMode followMode;        // 追従モード
-		const Vector2* followTarget;         // 追従対象（プレイヤー位置など）
-		const Vector2* target = nullptr;     // Homing用ターゲット
-		float timer = 0.0f;
-		bool isActive = false;
+		Vector2 position;
+		const Vector2* target;  // Homing用ターゲット（無ければ nullptr）
 	};
+	std::vector<EmitCommand> emitQueue_;
+	std::vector<Vector2> batchPositions_;  // FlushEmitQueue の作業用
 
-	static const int kMaxParticles = 2048;
-	std::array<Particle, kMaxParticles> particles_;
-	int nextIndex_ = 0;
+	// 種類ごとのパラメータ（ParticleType で直接引く）
+	ParticleTypeTable<ParticleParam> params_;
+
+	// 連続発生エミッター
+	ParticleEmitterPool emitters_;
+	ParticleTypeTable<EmitterHandle> typeEmitters_;  // StartContinuousEmit などの種類ごとの簡易版
+	std::vector<int> firedEmitters_;                 // Update の作業用（このフレームに発生するエミッター）
+	uint64_t nextEmitterStream_ = 1;                 // エミッターの乱数シードを作る通し番号
 
-	std::map<ParticleType, ParticleParam> params_;
-	std::map<ParticleType, ContinuousEmitter> continuousEmitters_;
+	// 風の流れ場（起動時に1回だけ作る）
+	ParticleFlowField flowField_;
+	Vector2 flowOffset_ = { 0.0f, 0.0f };         // 場のずれ（Step で flowScrollSpeed_ ずつ進める）
+	Vector2 flowScrollSpeed_ = { 40.0f, 0.0f };
+
+	// 粒が当たる地形（Step の前にグリッドを作り直し、更新中は読むだけ）
+	ParticleCollisionWorld collisionWorld_;
+
+	// 負荷に応じた発生量の調整（Update の最初に前フレームの測定値で倍率を決める）
+	ParticleBudgetGovernor governor_;
+	float lastUpdateMs_ = 0.0f;
+	float lastDrawMs_ = 0.0f;
+	float reportedFrameMs_ = -1.0f;                // ReportFrameTime で渡された値（無ければ負）
+	ParticleTypeTable<float> governedCountCarry_;  // 絞った発生数の端数（次の発生に持ち越す）
+	std::vector<int> burstOffsets_;                // 地点ごとの発生数の累積（EmitBurst の作業用）
 
 	float groundLevel_ = 0.0f;  // 地面のY座標
 
-	int texExplosion_ = -1;
-	int texDebris_ = -1;
-	int texHit_ = -1;
-	int texDust_ = -1;
-	int texRain_ = -1;
-	int texSnow_ = -1;
-	int texOrb_ = -1;
-
-	int texGlow_ = -1;
-	int texRing_ = -1;
-	int texSparkle_ = -1;
-	int texScratch_ = -1;
-	int texSmoke_ = -1;
+	// 軌跡（リボン）
+	static constexpr const char* kTrailTexturePath = "./Resources/images/effect/particle_white.png";
+	static constexpr float kDashTrailBreakTime = 0.1f;  // EmitDashGhost の間がこれより空いたら軌跡を切る
+	ParticleTrailPool trails_;
+
+	// 公開 API の呼び出しの記録
+	ParticleRecorder recorder_;
+
+	// 読み込んだテクスチャ（パス → ハンドル）
+	std::unordered_map<std::string, int> textureCache_;
+
+	// 設定ファイルのホットリロード
+	static constexpr float kHotReloadInterval = 0.5f;  // 更新日時を見る間隔（秒）
+	std::string paramsPath_;
+	std::filesystem::file_time_type paramsWriteTime_{};
+	bool hotReloadEnabled_ = false;
+	float hotReloadTimer_ = 0.0f;
+	int hotReloadCount_ = 0;
 
 	ParticleType currentDebugType_ = ParticleType::Explosion;
 };
\ No newline at end of file
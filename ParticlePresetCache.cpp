@@ -0,0 +1,331 @@
+﻿#include "ParticlePresetCache.h"
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+// レコードをそのまま書き出し・読み込みするので、ホストもリトルエンディアンであること
+static_assert(std::endian::native == std::endian::little, "ParticlePresetCache assumes a little-endian host");
+
+namespace {
+
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t headerSize;
+		uint32_t recordSize;
+		uint32_t typeCount;
+		uint32_t recordOffset;
+		uint32_t scaleKeyOffset;
+		uint32_t scaleKeyCount;
+		uint32_t colorKeyOffset;
+		uint32_t colorKeyCount;
+		uint32_t stringOffset;
+		uint32_t stringSize;
+	};
+
+	// 1種類分（bool は uint32_t、enum は int32_t で持つ）
+	struct Record {
+		uint32_t texturePathOffset;  // 文字列表の中の位置（長さ 0 ならテクスチャ無し）
+		uint32_t texturePathLength;
+		int32_t count;
+		float lifeMin, lifeMax;
+		float speedMin, speedMax;
+		float angleBase, angleRange;
+		float gravityX, gravityY;
+		float accelerationX, accelerationY;
+		float emitRangeX, emitRangeY;
+		float sizeMin, sizeMax;
+		float scaleStart, scaleEnd;
+		uint32_t colorStart, colorEnd;
+		uint32_t scaleKeyFirst, scaleKeyCount;  // スケールのキー配列の中の範囲
+		uint32_t colorKeyFirst, colorKeyCount;  // 色のキー配列の中の範囲
+		float rotationSpeedMin, rotationSpeedMax;
+		uint32_t useAnimation;
+		int32_t divX, divY, totalFrames;
+		float animSpeed;
+		int32_t blendMode;
+		int32_t emitterShape;
+		float emitterSizeX, emitterSizeY;
+		uint32_t useHoming;
+		float homingStrength;
+		uint32_t isContinuous;
+		float emitInterval;
+		float bounceDamping;
+		float windStrength;
+		float floatAmplitude;
+		float floatFrequency;
+		int32_t priority;
+		uint32_t useGroundHitEmit;
+		int32_t groundHitEmitType;
+		uint32_t collideWithWorld;
+		uint32_t killOnWorldHit;
+		uint32_t useCoarseBounds;
+		float coarseBoundsMargin;
+	};
+
+	struct ScaleKeyRecord {
+		float time;
+		float value;
+	};
+
+	struct ColorKeyRecord {
+		float time;
+		uint32_t color;
+	};
+
+	static_assert(sizeof(FileHeader) % 4 == 0 && sizeof(Record) % 4 == 0, "records must stay 4-byte aligned");
+	static_assert(sizeof(ScaleKeyRecord) == 8 && sizeof(ColorKeyRecord) == 8, "key records must be packed");
+
+	template <typename T>
+	void Append(std::vector<uint8_t>& bytes, const T& value) {
+		const size_t offset = bytes.size();
+		bytes.resize(offset + sizeof(T));
+		std::memcpy(bytes.data() + offset, &value, sizeof(T));
+	}
+
+	// [offset, offset + count * stride) がファイルに収まっているか
+	bool InRange(size_t size, uint32_t offset, uint32_t count, size_t stride) {
+		return offset <= size && static_cast<uint64_t>(count) * stride <= size - offset;
+	}
+}
+
+bool ParticlePresetCache::Save(const std::string& filepath, const ParticleTypeTable<ParticleParam>& params) {
+	std::vector<Record> records(kParticleTypeCount);
+	std::vector<ScaleKeyRecord> scaleKeys;
+	std::vector<ColorKeyRecord> colorKeys;
+	std::string strings;
+
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		const ParticleParam& param = params[static_cast<ParticleType>(i)];
+		Record& r = records[i];
+		std::memset(&r, 0, sizeof(Record));
+
+		r.texturePathOffset = static_cast<uint32_t>(strings.size());
+		r.texturePathLength = static_cast<uint32_t>(param.texturePath.size());
+		strings += param.texturePath;
+
+		r.count = param.count;
+		r.lifeMin = param.lifeMin;
+		r.lifeMax = param.lifeMax;
+		r.speedMin = param.speedMin;
+		r.speedMax = param.speedMax;
+		r.angleBase = param.angleBase;
+		r.angleRange = param.angleRange;
+		r.gravityX = param.gravity.x;
+		r.gravityY = param.gravity.y;
+		r.accelerationX = param.acceleration.x;
+		r.accelerationY = param.acceleration.y;
+		r.emitRangeX = param.emitRange.x;
+		r.emitRangeY = param.emitRange.y;
+		r.sizeMin = param.sizeMin;
+		r.sizeMax = param.sizeMax;
+		r.scaleStart = param.scaleStart;
+		r.scaleEnd = param.scaleEnd;
+		r.colorStart = param.colorStart;
+		r.colorEnd = param.colorEnd;
+
+		r.scaleKeyFirst = static_cast<uint32_t>(scaleKeys.size());
+		r.scaleKeyCount = static_cast<uint32_t>(param.scaleCurve.size());
+		for (const ParticleScaleKey& key : param.scaleCurve) {
+			scaleKeys.push_back({ key.time, key.value });
+		}
+		r.colorKeyFirst = static_cast<uint32_t>(colorKeys.size());
+		r.colorKeyCount = static_cast<uint32_t>(param.colorCurve.size());
+		for (const ParticleColorKey& key : param.colorCurve) {
+			colorKeys.push_back({ key.time, key.color });
+		}
+
+		r.rotationSpeedMin = param.rotationSpeedMin;
+		r.rotationSpeedMax = param.rotationSpeedMax;
+		r.useAnimation = param.useAnimation ? 1u : 0u;
+		r.divX = param.divX;
+		r.divY = param.divY;
+		r.totalFrames = param.totalFrames;
+		r.animSpeed = param.animSpeed;
+		r.blendMode = static_cast<int32_t>(param.blendMode);
+		r.emitterShape = static_cast<int32_t>(param.emitterShape);
+		r.emitterSizeX = param.emitterSize.x;
+		r.emitterSizeY = param.emitterSize.y;
+		r.useHoming = param.useHoming ? 1u : 0u;
+		r.homingStrength = param.homingStrength;
+		r.isContinuous = param.isContinuous ? 1u : 0u;
+		r.emitInterval = param.emitInterval;
+		r.bounceDamping = param.bounceDamping;
+		r.windStrength = param.windStrength;
+		r.floatAmplitude = param.floatAmplitude;
+		r.floatFrequency = param.floatFrequency;
+		r.priority = param.priority;
+		r.useGroundHitEmit = param.useGroundHitEmit ? 1u : 0u;
+		r.groundHitEmitType = static_cast<int32_t>(param.groundHitEmitType);
+		r.collideWithWorld = param.collideWithWorld ? 1u : 0u;
+		r.killOnWorldHit = param.killOnWorldHit ? 1u : 0u;
+		r.useCoarseBounds = param.useCoarseBounds ? 1u : 0u;
+		r.coarseBoundsMargin = param.coarseBoundsMargin;
+	}
+
+	// 文字列表も 4 バイト境界で終わらせる（後ろに何か足しても揃うように）
+	while (strings.size() % 4 != 0) {
+		strings.push_back('\0');
+	}
+
+	FileHeader header = {};
+	header.magic = kMagic;
+	header.version = kVersion;
+	header.headerSize = sizeof(FileHeader);
+	header.recordSize = sizeof(Record);
+	header.typeCount = static_cast<uint32_t>(kParticleTypeCount);
+	header.recordOffset = sizeof(FileHeader);
+	header.scaleKeyOffset = header.recordOffset + static_cast<uint32_t>(records.size() * sizeof(Record));
+	header.scaleKeyCount = static_cast<uint32_t>(scaleKeys.size());
+	header.colorKeyOffset = header.scaleKeyOffset + static_cast<uint32_t>(scaleKeys.size() * sizeof(ScaleKeyRecord));
+	header.colorKeyCount = static_cast<uint32_t>(colorKeys.size());
+	header.stringOffset = header.colorKeyOffset + static_cast<uint32_t>(colorKeys.size() * sizeof(ColorKeyRecord));
+	header.stringSize = static_cast<uint32_t>(strings.size());
+
+	std::vector<uint8_t> bytes;
+	bytes.reserve(header.stringOffset + strings.size());
+	Append(bytes, header);
+	for (const Record& r : records) Append(bytes, r);
+	for (const ScaleKeyRecord& k : scaleKeys) Append(bytes, k);
+	for (const ColorKeyRecord& k : colorKeys) Append(bytes, k);
+	bytes.insert(bytes.end(), strings.begin(), strings.end());
+
+	std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticlePresetCache: Failed to open for writing: %s\n", filepath.c_str());
+#endif
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	return file.good();
+}
+
+bool ParticlePresetCache::Parse(const uint8_t* data, size_t size, ParticleTypeTable<ParticleParam>& outParams) {
+	if (data == nullptr || size < sizeof(FileHeader)) return false;
+
+	FileHeader header;
+	std::memcpy(&header, data, sizeof(FileHeader));
+	if (header.magic != kMagic || header.version != kVersion ||
+		header.headerSize != sizeof(FileHeader) || header.recordSize != sizeof(Record) ||
+		header.typeCount != static_cast<uint32_t>(kParticleTypeCount)) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticlePresetCache: Header mismatch (version %u, expected %u)\n", header.version, kVersion);
+#endif
+		return false;
+	}
+
+	if (!InRange(size, header.recordOffset, header.typeCount, sizeof(Record)) ||
+		!InRange(size, header.scaleKeyOffset, header.scaleKeyCount, sizeof(ScaleKeyRecord)) ||
+		!InRange(size, header.colorKeyOffset, header.colorKeyCount, sizeof(ColorKeyRecord)) ||
+		!InRange(size, header.stringOffset, header.stringSize, 1)) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticlePresetCache: Truncated file\n");
+#endif
+		return false;
+	}
+
+	// 全部読めたときだけ outParams に移す
+	ParticleTypeTable<ParticleParam> params;
+	for (int i = 0; i < kParticleTypeCount; ++i) {
+		Record r;
+		std::memcpy(&r, data + header.recordOffset + static_cast<size_t>(i) * sizeof(Record), sizeof(Record));
+
+		if (!InRange(header.stringSize, r.texturePathOffset, r.texturePathLength, 1) ||
+			!InRange(header.scaleKeyCount, r.scaleKeyFirst, r.scaleKeyCount, 1) ||
+			!InRange(header.colorKeyCount, r.colorKeyFirst, r.colorKeyCount, 1) ||
+			r.blendMode < 0 || r.blendMode >= kCountOfBlendMode ||
+			r.emitterShape < 0 || r.emitterShape > static_cast<int32_t>(EmitterShape::Rectangle) ||
+			!IsValidParticleType(static_cast<ParticleType>(r.groundHitEmitType))) {
+#ifdef _DEBUG
+			Novice::ConsolePrintf("ParticlePresetCache: Record %d is out of range\n", i);
+#endif
+			return false;
+		}
+
+		ParticleParam& param = params[static_cast<ParticleType>(i)];
+		param.textureHandle = -1;
+		param.texturePath.assign(reinterpret_cast<const char*>(data + header.stringOffset + r.texturePathOffset), r.texturePathLength);
+		param.count = r.count;
+		param.lifeMin = r.lifeMin;
+		param.lifeMax = r.lifeMax;
+		param.speedMin = r.speedMin;
+		param.speedMax = r.speedMax;
+		param.angleBase = r.angleBase;
+		param.angleRange = r.angleRange;
+		param.gravity = { r.gravityX, r.gravityY };
+		param.acceleration = { r.accelerationX, r.accelerationY };
+		param.emitRange = { r.emitRangeX, r.emitRangeY };
+		param.sizeMin = r.sizeMin;
+		param.sizeMax = r.sizeMax;
+		param.scaleStart = r.scaleStart;
+		param.scaleEnd = r.scaleEnd;
+		param.colorStart = r.colorStart;
+		param.colorEnd = r.colorEnd;
+
+		for (uint32_t k = 0; k < r.scaleKeyCount; ++k) {
+			ScaleKeyRecord key;
+			std::memcpy(&key, data + header.scaleKeyOffset + static_cast<size_t>(r.scaleKeyFirst + k) * sizeof(ScaleKeyRecord), sizeof(key));
+			param.scaleCurve.push_back({ key.time, key.value });
+		}
+		for (uint32_t k = 0; k < r.colorKeyCount; ++k) {
+			ColorKeyRecord key;
+			std::memcpy(&key, data + header.colorKeyOffset + static_cast<size_t>(r.colorKeyFirst + k) * sizeof(ColorKeyRecord), sizeof(key));
+			param.colorCurve.push_back({ key.time, key.color });
+		}
+
+		param.rotationSpeedMin = r.rotationSpeedMin;
+		param.rotationSpeedMax = r.rotationSpeedMax;
+		param.useAnimation = r.useAnimation != 0;
+		param.divX = r.divX;
+		param.divY = r.divY;
+		param.totalFrames = r.totalFrames;
+		param.animSpeed = r.animSpeed;
+		param.blendMode = static_cast<BlendMode>(r.blendMode);
+		param.emitterShape = static_cast<EmitterShape>(r.emitterShape);
+		param.emitterSize = { r.emitterSizeX, r.emitterSizeY };
+		param.useHoming = r.useHoming != 0;
+		param.homingStrength = r.homingStrength;
+		param.isContinuous = r.isContinuous != 0;
+		param.emitInterval = r.emitInterval;
+		param.bounceDamping = r.bounceDamping;
+		param.windStrength = r.windStrength;
+		param.floatAmplitude = r.floatAmplitude;
+		param.floatFrequency = r.floatFrequency;
+		param.priority = r.priority;
+		param.useGroundHitEmit = r.useGroundHitEmit != 0;
+		param.groundHitEmitType = static_cast<ParticleType>(r.groundHitEmitType);
+		param.collideWithWorld = r.collideWithWorld != 0;
+		param.killOnWorldHit = r.killOnWorldHit != 0;
+		param.useCoarseBounds = r.useCoarseBounds != 0;
+		param.coarseBoundsMargin = r.coarseBoundsMargin;
+	}
+
+	outParams = std::move(params);
+	return true;
+}
+
+bool ParticlePresetCache::Load(const std::string& filepath, ParticleTypeTable<ParticleParam>& outParams) {
+	std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) return false;
+
+	const std::streamsize size = file.tellg();
+	if (size <= 0) return false;
+
+	std::vector<uint8_t> bytes(static_cast<size_t>(size));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char*>(bytes.data()), size)) return false;
+
+	return Parse(bytes.data(), bytes.size(), outParams);
+}
+
+bool ParticlePresetCache::IsUpToDate(const std::string& cachePath, const std::string& sourcePath) {
+	std::error_code ec;
+	const auto cacheTime = std::filesystem::last_write_time(cachePath, ec);
+	if (ec) return false;
+	const auto sourceTime = std::filesystem::last_write_time(sourcePath, ec);
+	if (ec) return false;
+	return cacheTime >= sourceTime;
+}
@@ -0,0 +1,40 @@
+﻿#pragma once
+#include "ParticleManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// パーティクル設定（particle_params.json）をコンパイルしたバイナリキャッシュ
+/// 起動のたびに JSON を解析しなくて済むよう、JSON を読んだときに書き出しておき、
+/// JSON より新しければこちらを読む。
+/// 形式（リトルエンディアン、全フィールド 4 バイト境界）：
+///   ヘッダ → 種類ごとの固定長レコード（ParticleType の順） → スケールのキー → 色のキー → 文字列表
+/// レコードからの参照は全てファイル先頭からのオフセットなので、ファイルをそのままメモリに
+/// マップして Parse に渡せる。テクスチャはハンドルではなくパスで持つ（ハンドルは読み込み側で解決する）
+/// </summary>
+class ParticlePresetCache {
+public:
+	static constexpr uint32_t kMagic = 0x43525050u;  // "PPRC"
+	// レコードの並びを変えたら上げる（古いキャッシュは読まずに JSON から作り直す）
+	static constexpr uint32_t kVersion = 1;
+
+	/// <summary>
+	/// 設定をキャッシュファイルに書き出す
+	/// </summary>
+	static bool Save(const std::string& filepath, const ParticleTypeTable<ParticleParam>& params);
+
+	/// <summary>
+	/// ファイルの中身（メモリマップしたものでもよい）から設定を読む
+	/// 形式・バージョンが合わない、範囲外を指しているなどのときは false で、outParams は変更しない
+	/// textureHandle は -1 のまま返す（texturePath から呼び出し側で解決する）
+	/// </summary>
+	static bool Parse(const uint8_t* data, size_t size, ParticleTypeTable<ParticleParam>& outParams);
+
+	static bool Load(const std::string& filepath, ParticleTypeTable<ParticleParam>& outParams);
+
+	/// <summary>
+	/// キャッシュが元の JSON 以上に新しいか（どちらかが無ければ false）
+	/// </summary>
+	static bool IsUpToDate(const std::string& cachePath, const std::string& sourcePath);
+};
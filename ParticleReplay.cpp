@@ -0,0 +1,456 @@
+﻿#include "ParticleReplay.h"
+#include "ParticleManager.h"
+#include "Camera2D.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <fstream>
+
+#ifdef min
+#undef min
+#endif
+
+#ifdef max
+#undef max
+#endif
+
+// 記録をそのまま書き出し・読み込みするので、ホストもリトルエンディアンであること
+static_assert(std::endian::native == std::endian::little, "ParticleReplayLog assumes a little-endian host");
+
+namespace {
+
+	struct FileHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t headerSize;
+		uint32_t eventSize;
+		uint32_t eventCount;
+		uint32_t reserved;
+		ParticleReplayHeader header;
+	};
+
+	// 生きている粒の状態のハッシュ（FNV-1a。浮動小数はビット列で比べる）
+	uint64_t HashParticles(const ParticleStorage& storage) {
+		uint64_t hash = 14695981039346656037ull;
+		auto mix = [&hash](uint32_t value) {
+			for (int shift = 0; shift < 32; shift += 8) {
+				hash ^= (value >> shift) & 0xFFu;
+				hash *= 1099511628211ull;
+			}
+		};
+
+		const int n = storage.GetCount();
+		mix(static_cast<uint32_t>(n));
+		for (int i = 0; i < n; ++i) {
+			mix(std::bit_cast<uint32_t>(storage.posX[i]));
+			mix(std::bit_cast<uint32_t>(storage.posY[i]));
+			mix(std::bit_cast<uint32_t>(storage.velX[i]));
+			mix(std::bit_cast<uint32_t>(storage.velY[i]));
+			mix(std::bit_cast<uint32_t>(storage.rotationSpeed[i]));
+			mix(std::bit_cast<uint32_t>(storage.drawSize[i]));
+			mix(std::bit_cast<uint32_t>(storage.lifeTimer[i]));
+			mix(static_cast<uint32_t>(storage.behavior[i]));
+		}
+		return hash;
+	}
+
+	// 昇順に並べた値の p 分位（0 〜 1）
+	double Percentile(std::vector<double>& values, double p) {
+		if (values.empty()) return 0.0;
+		std::sort(values.begin(), values.end());
+		const size_t index = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())));
+		return values[index];
+	}
+}
+
+// ========================================
+// ParticleReplayLog
+// ========================================
+
+bool ParticleReplayLog::Save(const std::string& filepath) const {
+	FileHeader file = {};
+	file.magic = kMagic;
+	file.version = kVersion;
+	file.headerSize = sizeof(FileHeader);
+	file.eventSize = sizeof(ParticleReplayEvent);
+	file.eventCount = static_cast<uint32_t>(events.size());
+	file.header = header;
+
+	std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+	if (!out.is_open()) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticleReplayLog: Failed to open for writing: %s\n", filepath.c_str());
+#endif
+		return false;
+	}
+	out.write(reinterpret_cast<const char*>(&file), sizeof(FileHeader));
+	out.write(reinterpret_cast<const char*>(events.data()), static_cast<std::streamsize>(events.size() * sizeof(ParticleReplayEvent)));
+	return out.good();
+}
+
+bool ParticleReplayLog::Load(const std::string& filepath) {
+	std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) return false;
+
+	const std::streamsize size = file.tellg();
+	if (size <= 0) return false;
+
+	std::vector<uint8_t> bytes(static_cast<size_t>(size));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char*>(bytes.data()), size)) return false;
+
+	return Parse(bytes.data(), bytes.size());
+}
+
+bool ParticleReplayLog::Parse(const uint8_t* data, size_t size) {
+	if (data == nullptr || size < sizeof(FileHeader)) return false;
+
+	FileHeader file;
+	std::memcpy(&file, data, sizeof(FileHeader));
+	if (file.magic != kMagic || file.version != kVersion ||
+		file.headerSize != sizeof(FileHeader) || file.eventSize != sizeof(ParticleReplayEvent)) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticleReplayLog: Header mismatch (version %u, expected %u)\n", file.version, kVersion);
+#endif
+		return false;
+	}
+
+	const uint64_t eventBytes = static_cast<uint64_t>(file.eventCount) * sizeof(ParticleReplayEvent);
+	if (eventBytes > size - sizeof(FileHeader)) {
+#ifdef _DEBUG
+		Novice::ConsolePrintf("ParticleReplayLog: Truncated file\n");
+#endif
+		return false;
+	}
+
+	std::vector<ParticleReplayEvent> loaded(file.eventCount);
+	std::memcpy(loaded.data(), data + sizeof(FileHeader), static_cast<size_t>(eventBytes));
+	for (const ParticleReplayEvent& e : loaded) {
+		if (e.op >= ParticleReplayOp::Count || e.type >= static_cast<uint8_t>(kParticleTypeCount)) {
+#ifdef _DEBUG
+			Novice::ConsolePrintf("ParticleReplayLog: Invalid event (op %u, type %u)\n",
+				static_cast<unsigned int>(e.op), static_cast<unsigned int>(e.type));
+#endif
+			return false;
+		}
+	}
+
+	header = file.header;
+	events = std::move(loaded);
+	return true;
+}
+
+void ParticleReplayLog::Clear() {
+	header = ParticleReplayHeader{};
+	events.clear();
+}
+
+// ========================================
+// ParticleRecorder
+// ========================================
+
+void ParticleRecorder::Start(const ParticleReplayHeader& header) {
+	log_.Clear();
+	log_.header = header;
+	log_.header.frameCount = 0;
+	emitterIds_.clear();
+	nextEmitterId_ = 0;
+	trailIds_.clear();
+	nextTrailId_ = 0;
+	lastFollow_.clear();
+	recording_ = true;
+}
+
+void ParticleRecorder::Record(ParticleReplayOp op, ParticleType type, const Vector2& pos,
+	uint32_t arg, uint8_t mode, const Vector2* target, uint8_t flags) {
+	if (!recording_) return;
+
+	ParticleReplayEvent e;
+	e.op = op;
+	e.type = static_cast<uint8_t>(type);
+	e.mode = mode;
+	e.flags = flags | (target != nullptr ? ParticleReplayEvent::kFlagTarget : 0);
+	e.frame = log_.header.frameCount;
+	e.x = pos.x;
+	e.y = pos.y;
+	e.arg = arg;
+	log_.events.push_back(e);
+
+	if (target != nullptr) {
+		Record(ParticleReplayOp::Target, type, *target);
+	}
+}
+
+void ParticleRecorder::RecordUpdate(float deltaTime) {
+	if (!recording_) return;
+	Record(ParticleReplayOp::Update, ParticleType::Explosion, { 0.0f, 0.0f }, FloatBits(deltaTime));
+	++log_.header.frameCount;
+}
+
+void ParticleRecorder::RecordTypeFollow(ParticleType type, const Vector2& pos) {
+	if (!recording_) return;
+
+	const uint64_t key = static_cast<uint64_t>(type);
+	auto it = lastFollow_.find(key);
+	if (it != lastFollow_.end() && it->second.x == pos.x && it->second.y == pos.y) return;
+	lastFollow_[key] = pos;
+	Record(ParticleReplayOp::TypeFollow, type, pos);
+}
+
+void ParticleRecorder::RecordEmitterFollow(EmitterHandle handle, const Vector2& pos) {
+	if (!recording_) return;
+
+	const uint32_t id = FindEmitterId(handle);
+	if (id == kUnknownEmitter) return;
+
+	const uint64_t key = (1ull << 32) | id;
+	auto it = lastFollow_.find(key);
+	if (it != lastFollow_.end() && it->second.x == pos.x && it->second.y == pos.y) return;
+	lastFollow_[key] = pos;
+	Record(ParticleReplayOp::EmitterFollow, ParticleType::Explosion, pos, id);
+}
+
+uint32_t ParticleRecorder::AssignEmitterId(EmitterHandle handle) {
+	const uint32_t id = nextEmitterId_++;
+	emitterIds_[HandleKey(handle)] = id;
+	return id;
+}
+
+uint32_t ParticleRecorder::FindEmitterId(EmitterHandle handle) const {
+	auto it = emitterIds_.find(HandleKey(handle));
+	return it != emitterIds_.end() ? it->second : kUnknownEmitter;
+}
+
+uint32_t ParticleRecorder::AssignTrailId(TrailHandle handle) {
+	const uint32_t id = nextTrailId_++;
+	trailIds_[HandleKey(handle)] = id;
+	return id;
+}
+
+uint32_t ParticleRecorder::FindTrailId(TrailHandle handle) const {
+	auto it = trailIds_.find(HandleKey(handle));
+	return it != trailIds_.end() ? it->second : kUnknownTrail;
+}
+
+uint32_t ParticleRecorder::FloatBits(float value) {
+	return std::bit_cast<uint32_t>(value);
+}
+
+// ========================================
+// ParticleReplay
+// ========================================
+
+ParticleReplay::Result ParticleReplay::Run(ParticleManager& manager, const ParticleReplayLog& log, const std::string& name) {
+	using Clock = std::chrono::steady_clock;
+
+	Result result;
+	result.name = name;
+
+	// 再生で変える設定（終わったら戻す）
+	const uint64_t prevSeed = manager.GetRandomSeed();
+	const float prevFixedStep = manager.GetFixedStep();
+	const int prevMaxSubSteps = manager.GetMaxSubSteps();
+	const ParticlePoolPolicy prevPolicy = manager.GetPoolPolicy();
+	const float prevGroundLevel = manager.GetGroundLevel();
+	const float prevStepAccumulator = manager.stepAccumulator_;
+	const Vector2 prevFlowOffset = manager.flowOffset_;
+
+	// 記録を始めたときの状態に揃える
+	const ParticleReplayHeader& header = log.header;
+	manager.StopAllContinuousEmit();
+	manager.Clear();
+	manager.SetRandomSeed(header.seed);
+	manager.SetFixedStep(header.fixedStep);
+	manager.SetMaxSubSteps(header.maxSubSteps);
+	manager.SetPoolPolicy(static_cast<ParticlePoolPolicy>(header.poolPolicy));
+	manager.SetGroundLevel(header.groundLevel);
+	manager.ResetPoolStats();
+	// 時間で進む状態も記録を始めた時点に戻す
+	manager.stepAccumulator_ = header.stepAccumulator;
+	manager.flowOffset_ = { header.flowOffsetX, header.flowOffsetY };
+
+	// 発生量の自動調整は計測した時間で変わるので、再生中は止めて毎回同じ粒の列にする
+	ParticleBudgetGovernor& governor = manager.GetBudgetGovernor();
+	const bool governorEnabled = governor.GetSettings().enabled;
+	governor.GetSettings().enabled = false;
+	governor.Reset();
+	// 設定ファイルの読み直しも途中でパラメータが変わらないよう止める
+	const bool hotReloadEnabled = manager.IsHotReloadEnabled();
+	manager.SetHotReloadEnabled(false);
+
+	// 記録の中のエミッター番号 → 再生側のハンドル（追従位置も番号ごとに持つ）
+	uint32_t emitterCount = 0;
+	uint32_t dashTrailCount = 0;
+	for (const ParticleReplayEvent& e : log.events) {
+		if (e.op == ParticleReplayOp::StartEmitter) emitterCount = std::max(emitterCount, e.arg + 1);
+		if (e.op == ParticleReplayOp::StartDashTrail) dashTrailCount = std::max(dashTrailCount, e.arg + 1);
+	}
+	std::vector<EmitterHandle> emitters(emitterCount);
+	// 記録の中の軌跡番号 → 再生側のダッシュの軌跡
+	std::vector<TrailHandle> dashTrails(dashTrailCount);
+	std::vector<Vector2> emitterFollow(emitterCount, { 0.0f, 0.0f });
+	ParticleTypeTable<Vector2> typeFollow;
+	// Homing のターゲット（粒が指し続けるので、再生が終わるまでアドレスが変わらない入れ物に置く）
+	std::deque<Vector2> targets;
+	std::vector<Vector2> batch;
+
+	auto emitterAt = [&](uint32_t id) {
+		return id < emitterCount ? emitters[id] : EmitterHandle{};
+	};
+
+	std::vector<double> updateMs;
+	std::vector<double> drawPrepMs;
+	updateMs.reserve(header.frameCount);
+	drawPrepMs.reserve(header.frameCount);
+	Camera2D camera;
+
+	const auto replayStart = Clock::now();
+	const size_t count = log.events.size();
+	for (size_t i = 0; i < count; ++i) {
+		const ParticleReplayEvent& e = log.events[i];
+		const ParticleType type = static_cast<ParticleType>(e.type);
+		const Vector2 pos = { e.x, e.y };
+
+		// ターゲット付きの操作は直後の Target に位置がある
+		size_t next = i + 1;
+		const Vector2* target = nullptr;
+		if ((e.flags & ParticleReplayEvent::kFlagTarget) != 0 && next < count && log.events[next].op == ParticleReplayOp::Target) {
+			targets.push_back({ log.events[next].x, log.events[next].y });
+			target = &targets.back();
+			++next;
+		}
+
+		switch (e.op) {
+		case ParticleReplayOp::Update: {
+			const auto t0 = Clock::now();
+			manager.Update(std::bit_cast<float>(e.arg));
+			const auto t1 = Clock::now();
+			manager.PrepareDraw(camera);
+			const auto t2 = Clock::now();
+			updateMs.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+			drawPrepMs.push_back(std::chrono::duration<double, std::milli>(t2 - t1).count());
+			break;
+		}
+		case ParticleReplayOp::Emit:
+			manager.EmitWithTarget(type, pos, target);
+			break;
+		case ParticleReplayOp::EmitBatch:
+			batch.clear();
+			while (batch.size() < e.arg && next < count && log.events[next].op == ParticleReplayOp::BatchPoint) {
+				batch.push_back({ log.events[next].x, log.events[next].y });
+				++next;
+			}
+			manager.EmitBatchWithTarget(type, batch, target);
+			break;
+		case ParticleReplayOp::QueueEmit:
+			manager.QueueEmitWithTarget(type, pos, target);
+			break;
+		case ParticleReplayOp::FlushEmitQueue:
+			manager.FlushEmitQueue();
+			break;
+		case ParticleReplayOp::StartDashTrail:
+			if (e.arg < dashTrailCount) {
+				dashTrails[e.arg] = manager.CreateDashTrail(manager.GetTrailTexture(), e.x);
+			}
+			break;
+		case ParticleReplayOp::DashTrailPoint:
+			if (e.arg < dashTrailCount) manager.PushTrail(dashTrails[e.arg], pos);
+			break;
+		case ParticleReplayOp::StopDashTrail:
+			if (e.arg < dashTrailCount) manager.StopTrail(dashTrails[e.arg]);
+			break;
+		case ParticleReplayOp::StartContinuous:
+			manager.StartContinuousEmitWithTarget(type, pos, target);
+			break;
+		case ParticleReplayOp::StopContinuous:
+			manager.StopContinuousEmit(type);
+			break;
+		case ParticleReplayOp::StopAllContinuous:
+			manager.StopAllContinuousEmit();
+			break;
+		case ParticleReplayOp::StartEnvironment:
+			manager.StartEnvironmentEffect(type, static_cast<EmitterFollowMode>(e.mode), pos);
+			break;
+		case ParticleReplayOp::SetFollowTarget:
+			manager.SetFollowTarget(type, (e.flags & ParticleReplayEvent::kFlagFollow) != 0 ? &typeFollow[type] : nullptr);
+			break;
+		case ParticleReplayOp::TypeFollow:
+			typeFollow[type] = pos;
+			break;
+		case ParticleReplayOp::UpdateFollow:
+			manager.UpdateFollowPosition(type, pos);
+			break;
+		case ParticleReplayOp::StartEmitter:
+			if (e.arg < emitterCount) {
+				emitters[e.arg] = manager.StartEmitter(type, pos, target);
+			}
+			break;
+		case ParticleReplayOp::StopEmitter:
+			manager.StopEmitter(emitterAt(e.arg));
+			break;
+		case ParticleReplayOp::SetEmitterPosition:
+			manager.SetEmitterPosition(emitterAt(e.arg), pos);
+			break;
+		case ParticleReplayOp::SetEmitterFollow:
+			manager.SetEmitterFollow(emitterAt(e.arg), static_cast<EmitterFollowMode>(e.mode),
+				(e.flags & ParticleReplayEvent::kFlagFollow) != 0 && e.arg < emitterCount ? &emitterFollow[e.arg] : nullptr);
+			break;
+		case ParticleReplayOp::EmitterFollow:
+			if (e.arg < emitterCount) emitterFollow[e.arg] = pos;
+			break;
+		case ParticleReplayOp::SetEmitterTarget:
+			manager.SetEmitterTarget(emitterAt(e.arg), target);
+			break;
+		case ParticleReplayOp::SetGroundLevel:
+			manager.SetGroundLevel(e.y);
+			break;
+		case ParticleReplayOp::Clear:
+			manager.Clear();
+			break;
+		default:
+			break;  // Target / BatchPoint は直前の操作が読む（旧形式の EmitDashGhost は無視）
+		}
+
+		i = next - 1;
+	}
+	result.totalMs = std::chrono::duration<double, std::milli>(Clock::now() - replayStart).count();
+
+	result.frames = static_cast<int>(updateMs.size());
+	result.updateP50Ms = Percentile(updateMs, 0.50);
+	result.updateP99Ms = Percentile(updateMs, 0.99);
+	result.drawPrepP50Ms = Percentile(drawPrepMs, 0.50);
+	result.drawPrepP99Ms = Percentile(drawPrepMs, 0.99);
+
+	const ParticlePoolStats& stats = manager.GetPoolStats();
+	result.peakLive = stats.peakCount;
+	result.evicted = stats.evicted;
+	result.dropped = stats.dropped;
+
+	result.stateHash = HashParticles(manager.particles_);
+
+	// 粒・エミッターは再生側の入れ物（typeFollow / emitterFollow / targets）を指しているので、ここで全部消す
+	manager.StopAllContinuousEmit();
+	manager.Clear();
+	manager.SetRandomSeed(prevSeed);
+	manager.SetFixedStep(prevFixedStep);
+	manager.SetMaxSubSteps(prevMaxSubSteps);
+	manager.SetPoolPolicy(prevPolicy);
+	manager.SetGroundLevel(prevGroundLevel);
+	manager.ResetPoolStats();
+	manager.stepAccumulator_ = prevStepAccumulator;
+	manager.flowOffset_ = prevFlowOffset;
+	governor.GetSettings().enabled = governorEnabled;
+	governor.Reset();
+	manager.SetHotReloadEnabled(hotReloadEnabled);
+	return result;
+}
+
+std::vector<std::string> ParticleReplay::GetStandardLogPaths() {
+	return {
+		"Resources/data/replays/rain.prep",
+		"Resources/data/replays/boss_explosions.prep",
+		"Resources/data/replays/rain_and_boss.prep",
+	};
+}
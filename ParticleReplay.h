@@ -0,0 +1,187 @@
+﻿#pragma once
+#include "Vector2.h"
+#include "ParticleEnum.h"
+#include "ParticleStorage.h"
+#include "ParticleEmitterPool.h"
+#include "ParticleTrail.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ParticleManager;
+
+/// <summary>
+/// 記録する操作の種類（値はファイルに書くので並びを変えない。追加は末尾に）
+/// </summary>
+enum class ParticleReplayOp : uint8_t {
+	Update,             // Update(deltaTime)。arg に deltaTime のビット列
+	Emit,               // Emit / EmitWithTarget
+	EmitBatch,          // EmitBatch / EmitBatchWithTarget。arg 個の BatchPoint が続く
+	BatchPoint,         // EmitBatch の1地点
+	QueueEmit,          // QueueEmit / QueueEmitWithTarget
+	FlushEmitQueue,
+	EmitDashGhost,      // 旧形式（全員で1本の軌跡。今は書かず、読んでも無視する）
+	StartContinuous,    // StartContinuousEmit / StartContinuousEmitWithTarget
+	StopContinuous,     // StopContinuousEmit / StopEnvironmentEffect
+	StopAllContinuous,
+	StartEnvironment,   // StartEnvironmentEffect。mode に EmitterFollowMode
+	SetFollowTarget,    // SetFollowTarget。flags に kFlagFollow があれば追従対象あり（位置は TypeFollow で）
+	TypeFollow,         // 種類ごとのエミッターの追従対象の位置（変わったフレームだけ）
+	UpdateFollow,       // UpdateFollowPosition
+	StartEmitter,       // StartEmitter。arg にエミッター番号（記録の中での通し番号）
+	StopEmitter,
+	SetEmitterPosition,
+	SetEmitterFollow,   // SetEmitterFollow。mode に EmitterFollowMode、flags に kFlagFollow があれば追従対象あり
+	EmitterFollow,      // ハンドル版エミッターの追従対象の位置（変わったフレームだけ）
+	SetEmitterTarget,   // SetEmitterTarget
+	Target,             // 直前の操作の Homing ターゲットの位置（flags に kFlagTarget がある操作の直後に付く）
+	SetGroundLevel,     // y に地面の高さ
+	Clear,
+	StartDashTrail,     // EmitDashGhost が軌跡を作った。arg に軌跡番号（記録の中での通し番号）、x に帯の太さ
+	DashTrailPoint,     // EmitDashGhost。x, y に位置、arg に軌跡番号
+	StopDashTrail,      // EmitDashGhost が間の空いた前の軌跡を放した。arg に軌跡番号
+	Count
+};
+
+/// <summary>
+/// 記録1件（20 バイト固定）
+/// frame は記録を始めてから何回目の Update の前か（タイムスタンプ。各フレームの経過時間は Update の記録が持つ）
+/// </summary>
+struct ParticleReplayEvent {
+	static constexpr uint8_t kFlagTarget = 1;  // 直後に Target が付く
+	static constexpr uint8_t kFlagFollow = 2;  // 追従対象あり
+
+	ParticleReplayOp op = ParticleReplayOp::Update;
+	uint8_t type = 0;    // ParticleType
+	uint8_t mode = 0;    // EmitterFollowMode など
+	uint8_t flags = 0;   // kFlagTarget / kFlagFollow
+	uint32_t frame = 0;
+	float x = 0.0f;
+	float y = 0.0f;
+	uint32_t arg = 0;
+};
+static_assert(sizeof(ParticleReplayEvent) == 20, "ParticleReplayEvent is written to disk as-is");
+
+/// <summary>
+/// 記録を始めたときの設定（再生前に同じ状態にする）
+/// </summary>
+struct ParticleReplayHeader {
+	uint64_t seed = 0;
+	float fixedStep = 1.0f / 60.0f;
+	int32_t maxSubSteps = 4;
+	uint32_t poolPolicy = 0;   // ParticlePoolPolicy
+	float groundLevel = 0.0f;
+	uint32_t frameCount = 0;   // 記録した Update の回数
+	float stepAccumulator = 0.0f;           // 固定ステップの端数
+	float flowOffsetX = 0.0f;               // 風の流れ場のずれ
+	float flowOffsetY = 0.0f;
+	uint32_t reserved = 0;
+};
+
+/// <summary>
+/// パーティクル操作の記録（ファイル1つ分）
+/// 形式（リトルエンディアン）：マジック "PREP" → バージョン → ヘッダ → 件数 → 記録の配列
+/// </summary>
+class ParticleReplayLog {
+public:
+	static constexpr uint32_t kMagic = 0x50455250u;  // "PREP"
+	static constexpr uint32_t kVersion = 1;
+
+	bool Save(const std::string& filepath) const;
+	bool Load(const std::string& filepath);
+	// ファイルの中身から読む（壊れていれば false で、中身は変更しない）
+	bool Parse(const uint8_t* data, size_t size);
+
+	void Clear();
+
+	ParticleReplayHeader header;
+	std::vector<ParticleReplayEvent> events;
+};
+
+/// <summary>
+/// ParticleManager の公開 API の呼び出しを記録する（ParticleManager::StartRecording で有効になる）
+/// Homing / 追従の対象はポインタの代わりにその時点の位置を記録する。
+/// パラメータの変更（UpdateEnvironmentParams・JSON の読み直し）と StartTrail 系は記録しない
+/// </summary>
+class ParticleRecorder {
+public:
+	void Start(const ParticleReplayHeader& header);
+	void Stop() { recording_ = false; }
+	bool IsRecording() const { return recording_; }
+
+	const ParticleReplayLog& GetLog() const { return log_; }
+	uint32_t GetFrame() const { return log_.header.frameCount; }
+
+	/// <summary>
+	/// 1件書き込む（target があれば直後に Target を付ける）
+	/// </summary>
+	void Record(ParticleReplayOp op, ParticleType type, const Vector2& pos,
+		uint32_t arg = 0, uint8_t mode = 0, const Vector2* target = nullptr, uint8_t flags = 0);
+	void RecordUpdate(float deltaTime);
+
+	// 追従対象の位置（前回書いた値から変わったときだけ書く）
+	void RecordTypeFollow(ParticleType type, const Vector2& pos);
+	void RecordEmitterFollow(EmitterHandle handle, const Vector2& pos);
+
+	// ハンドル → 記録の中でのエミッター番号（StartEmitter のときに振る。記録前のハンドルは kUnknownEmitter）
+	static constexpr uint32_t kUnknownEmitter = 0xFFFFFFFFu;
+	uint32_t AssignEmitterId(EmitterHandle handle);
+	uint32_t FindEmitterId(EmitterHandle handle) const;
+
+	// ダッシュの軌跡のハンドル → 記録の中での軌跡番号（EmitDashGhost が軌跡を作ったときに振る）
+	static constexpr uint32_t kUnknownTrail = 0xFFFFFFFFu;
+	uint32_t AssignTrailId(TrailHandle handle);
+	uint32_t FindTrailId(TrailHandle handle) const;
+
+	static uint32_t FloatBits(float value);
+
+private:
+	static uint64_t HandleKey(EmitterHandle handle) {
+		return (static_cast<uint64_t>(handle.index) << 32) | handle.generation;
+	}
+	static uint64_t HandleKey(TrailHandle handle) {
+		return (static_cast<uint64_t>(handle.index) << 32) | handle.generation;
+	}
+
+	bool recording_ = false;
+	ParticleReplayLog log_;
+	std::unordered_map<uint64_t, uint32_t> emitterIds_;
+	uint32_t nextEmitterId_ = 0;
+	std::unordered_map<uint64_t, uint32_t> trailIds_;
+	uint32_t nextTrailId_ = 0;
+	std::unordered_map<uint64_t, Vector2> lastFollow_;  // 種類 / エミッター番号 → 最後に書いた追従位置
+};
+
+/// <summary>
+/// 記録を画面に描かずに再生し、1フレームごとの更新・描画準備の時間を測る
+/// 描画は ParticleManager::PrepareDraw までで止める（DrawQuad は呼ばない）。
+/// Homing のターゲットは記録した時点の位置に止まっているものとして扱う
+/// </summary>
+class ParticleReplay {
+public:
+	struct Result {
+		std::string name;
+		int frames = 0;
+		double updateP50Ms = 0.0;
+		double updateP99Ms = 0.0;
+		double drawPrepP50Ms = 0.0;
+		double drawPrepP99Ms = 0.0;
+		double totalMs = 0.0;        // 再生全体（更新 + 描画準備）
+		int peakLive = 0;            // 最大同時生存数
+		unsigned int evicted = 0;    // 満杯で上書きされた粒の数
+		unsigned int dropped = 0;    // 満杯で生成できなかった粒の数
+		uint64_t stateHash = 0;      // 再生し終えた時点の粒の状態のハッシュ（同じ記録なら同じ値になる）
+	};
+
+	/// <summary>
+	/// manager を記録開始時の設定にしてから最後まで再生する
+	/// （始める前と終わった後に粒・エミッターは消え、変えた設定は終わった後に元に戻す。
+	/// 負荷で発生量を絞る調整と設定ファイルの読み直しは、結果が変わらないよう再生中は止める）
+	/// </summary>
+	static Result Run(ParticleManager& manager, const ParticleReplayLog& log, const std::string& name = "");
+
+	// 同梱している標準の記録（雨・ボスの爆発・両方）のパス
+	static std::vector<std::string> GetStandardLogPaths();
+};
@@ -0,0 +1,760 @@
+﻿#include "ParticleStorage.h"
+#include "ParticleTypeTraits.h"
+#include "ParticleFlowField.h"
+#include "ParticleCollisionWorld.h"
+#include "SpriteSheet.h"
+#include <cmath>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PARTICLE_HAS_AVX2 1
+#endif
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_HAS_SSE 1
+#endif
+
+#ifdef min
+#undef min
+#endif
+
+#ifdef max
+#undef max
+#endif
+
+void ParticleStorage::Resize(int capacity) {
+	capacity_ = capacity;
+	count_ = 0;
+	nextSerial_ = 0;
+	const size_t n = static_cast<size_t>(capacity);
+
+	posX.assign(n, 0.0f);
+	posY.assign(n, 0.0f);
+	velX.assign(n, 0.0f);
+	velY.assign(n, 0.0f);
+	accX.assign(n, 0.0f);
+	accY.assign(n, 0.0f);
+	rotation.assign(n, 0.0f);
+	rotationSpeed.assign(n, 0.0f);
+	lifeTimer.assign(n, 0.0f);
+	maxLife.assign(n, 0.0f);
+	scaleStart.assign(n, 1.0f);
+	scaleEnd.assign(n, 1.0f);
+	currentScale.assign(n, 1.0f);
+	colorStart.assign(n, 0xFFFFFFFF);
+	colorEnd.assign(n, 0xFFFFFFFF);
+	currentColor.assign(n, 0xFFFFFFFF);
+	lutBase.assign(n, -1);
+	alive.assign(n, 0u);
+	physicsMask.assign(n, 0u);
+	needsScalarPass.assign(n, 0);
+
+	type.assign(n, ParticleType::Explosion);
+	behavior.assign(n, ParticleBehavior::Physics);
+	textureHandle.assign(n, -1);
+	blendMode.assign(n, kBlendModeNormal);
+	drawSize.assign(n, 0.0f);
+	anim.assign(n, AnimState{});
+	homingTarget.assign(n, nullptr);
+	homingStrength.assign(n, 0.0f);
+	priority.assign(n, 0);
+	spawnSerial.assign(n, 0u);
+}
+
+int ParticleStorage::Spawn(ParticleType particleType, const ParticleSpawnDesc& desc, int spawnPriority) {
+	int index = count_;
+	if (count_ < capacity_) {
+		count_++;
+		stats_.peakCount = std::max(stats_.peakCount, count_);
+	}
+	else {
+		// 満杯：方針に従って上書きするか捨てる
+		index = FindVictim(spawnPriority);
+		if (index < 0) {
+			stats_.dropped++;
+			return -1;
+		}
+		stats_.evicted++;
+	}
+
+	InitSlot(index, particleType, desc, spawnPriority);
+	return index;
+}
+
+int ParticleStorage::SpawnBatch(ParticleType particleType, const ParticleSpawnDesc* descs, int count, int spawnPriority, int* outIndices) {
+	if (count <= 0) return 0;
+
+	// 1. 空きスロットは末尾に連続しているので、入る分をまとめて確保する
+	const int first = count_;
+	const int reserved = std::min(count, capacity_ - count_);
+	count_ += reserved;
+	stats_.peakCount = std::max(stats_.peakCount, count_);
+
+	for (int i = 0; i < reserved; ++i) {
+		InitSlot(first + i, particleType, descs[i], spawnPriority);
+		if (outIndices != nullptr) outIndices[i] = first + i;
+	}
+
+	// 2. 入りきらない分は1粒ずつ（上書きの相手は直前に書いた粒も含めて選ぶ）
+	int spawned = reserved;
+	for (int i = reserved; i < count; ++i) {
+		const int index = Spawn(particleType, descs[i], spawnPriority);
+		if (outIndices != nullptr) outIndices[i] = index;
+		if (index >= 0) spawned++;
+	}
+	return spawned;
+}
+
+void ParticleStorage::InitSlot(int index, ParticleType particleType, const ParticleSpawnDesc& desc, int spawnPriority) {
+	// 基本パラメータ
+	alive[index] = 0xFFFFFFFFu;
+	type[index] = particleType;
+	posX[index] = desc.position.x;
+	posY[index] = desc.position.y;
+	velX[index] = desc.velocity.x;
+	velY[index] = desc.velocity.y;
+	accX[index] = desc.acceleration.x;
+	accY[index] = desc.acceleration.y;
+	lifeTimer[index] = desc.life;
+	maxLife[index] = desc.life;
+	textureHandle[index] = desc.textureHandle;
+	blendMode[index] = desc.blendMode;
+	behavior[index] = ParticleBehavior::Physics;
+
+	// 回転
+	rotation[index] = desc.rotation;
+	rotationSpeed[index] = desc.rotationSpeed;
+
+	// スケール
+	scaleStart[index] = desc.scaleStart;
+	scaleEnd[index] = desc.scaleEnd;
+	currentScale[index] = desc.scaleStart;
+
+	// 色
+	colorStart[index] = desc.colorStart;
+	colorEnd[index] = desc.colorEnd;
+	currentColor[index] = desc.colorStart;
+
+	// 寿命カーブ（登録済みのときだけ。初期値はカーブの先頭）
+	const int base = desc.lifetimeLut * kParticleLutSize;
+	if (desc.lifetimeLut >= 0 && base < static_cast<int>(lutScale_.size())) {
+		lutBase[index] = base;
+		currentScale[index] = lutScale_[base];
+		currentColor[index] = lutColor_[base];
+	}
+	else {
+		lutBase[index] = -1;
+	}
+
+	drawSize[index] = desc.drawSize;
+
+	// アニメーション
+	AnimState& a = anim[index];
+	a.useAnimation = desc.useAnimation;
+	a.sheet = nullptr;
+	if (desc.useAnimation) {
+		a.sheet = desc.spriteSheet != nullptr ? desc.spriteSheet : SpriteSheet::Get(desc.textureHandle, desc.divX, desc.divY);
+	}
+	a.totalFrames = desc.totalFrames;
+	a.animSpeed = desc.animSpeed;
+	a.animTimer = 0.0f;
+	a.currentFrame = 0;
+
+	homingTarget[index] = nullptr;
+	homingStrength[index] = 0.0f;
+	priority[index] = spawnPriority;
+	spawnSerial[index] = nextSerial_++;
+
+	RefreshFlags(index);
+}
+
+int ParticleStorage::FindVictim(int newPriority) const {
+	if (policy_ == ParticlePoolPolicy::DropNew || count_ == 0) {
+		return -1;
+	}
+
+	// 満杯になったときだけ通る経路なので線形探索で十分
+	// （通し番号は差で比べるので桁あふれしても古い順が保たれる）
+	int victim = 0;
+	for (int i = 1; i < count_; ++i) {
+		if (policy_ == ParticlePoolPolicy::EvictLowestPriority) {
+			if (priority[i] < priority[victim]) {
+				victim = i;
+				continue;
+			}
+			if (priority[i] > priority[victim]) continue;
+		}
+		if (static_cast<int32_t>(spawnSerial[i] - spawnSerial[victim]) < 0) {
+			victim = i;
+		}
+	}
+
+	// 新しい粒より優先度の高い粒しか無ければ新しい方を捨てる
+	if (policy_ == ParticlePoolPolicy::EvictLowestPriority && priority[victim] > newPriority) {
+		return -1;
+	}
+	return victim;
+}
+
+void ParticleStorage::Kill(int index) {
+	if (index < 0 || index >= count_) return;
+
+	const int last = count_ - 1;
+	if (index != last) {
+		MoveSlot(last, index);
+	}
+	alive[last] = 0u;
+	count_--;
+}
+
+void ParticleStorage::KillAll() {
+	std::fill(alive.begin(), alive.begin() + count_, 0u);
+	count_ = 0;
+}
+
+void ParticleStorage::ResetStats() {
+	stats_ = ParticlePoolStats{};
+	stats_.peakCount = count_;
+}
+
+void ParticleStorage::MoveSlot(int from, int to) {
+	posX[to] = posX[from];
+	posY[to] = posY[from];
+	velX[to] = velX[from];
+	velY[to] = velY[from];
+	accX[to] = accX[from];
+	accY[to] = accY[from];
+	rotation[to] = rotation[from];
+	rotationSpeed[to] = rotationSpeed[from];
+	lifeTimer[to] = lifeTimer[from];
+	maxLife[to] = maxLife[from];
+	scaleStart[to] = scaleStart[from];
+	scaleEnd[to] = scaleEnd[from];
+	currentScale[to] = currentScale[from];
+	colorStart[to] = colorStart[from];
+	colorEnd[to] = colorEnd[from];
+	currentColor[to] = currentColor[from];
+	lutBase[to] = lutBase[from];
+	alive[to] = alive[from];
+	physicsMask[to] = physicsMask[from];
+	needsScalarPass[to] = needsScalarPass[from];
+
+	type[to] = type[from];
+	behavior[to] = behavior[from];
+	textureHandle[to] = textureHandle[from];
+	blendMode[to] = blendMode[from];
+	drawSize[to] = drawSize[from];
+	anim[to] = anim[from];
+	homingTarget[to] = homingTarget[from];
+	homingStrength[to] = homingStrength[from];
+	priority[to] = priority[from];
+	spawnSerial[to] = spawnSerial[from];
+}
+
+void ParticleStorage::RemoveDead() {
+	// 死んだ粒に末尾の粒を移す（移した粒もまだ見ていないので i は進めない）
+	int i = 0;
+	while (i < count_) {
+		if (alive[i]) {
+			++i;
+			continue;
+		}
+		Kill(i);
+	}
+}
+
+void ParticleStorage::SetBehavior(int index, ParticleBehavior newBehavior) {
+	behavior[index] = newBehavior;
+	RefreshFlags(index);
+}
+
+void ParticleStorage::SetHomingTarget(int index, const Vector2* target, float strength) {
+	homingTarget[index] = target;
+	homingStrength[index] = strength;
+}
+
+void ParticleStorage::SetLifetimeLut(int lutIndex, const ParticleLifetimeLut& lut) {
+	if (lutIndex < 0) return;
+
+	const size_t required = static_cast<size_t>(lutIndex + 1) * kParticleLutSize;
+	if (lutScale_.size() < required) {
+		lutScale_.resize(required, 1.0f);
+		lutColor_.resize(required, 0xFFFFFFFF);
+	}
+
+	const size_t base = static_cast<size_t>(lutIndex) * kParticleLutSize;
+	std::copy(lut.scale.begin(), lut.scale.end(), lutScale_.begin() + base);
+	std::copy(lut.color.begin(), lut.color.end(), lutColor_.begin() + base);
+}
+
+void ParticleStorage::RefreshFlags(int index) {
+	const ParticleBehavior b = behavior[index];
+	const AnimState& a = anim[index];
+
+	physicsMask[index] = (b == ParticleBehavior::Physics) ? 0xFFFFFFFFu : 0u;
+
+	const bool animates = a.useAnimation && a.totalFrames > 1 && a.animSpeed > 0.0f;
+	const bool special = b == ParticleBehavior::Homing || b == ParticleBehavior::Stationary;
+	needsScalarPass[index] = (animates || special) ? 1 : 0;
+}
+
+ParticleSimdLevel ParticleStorage::GetBestSimdLevel() {
+#if defined(PARTICLE_HAS_AVX2)
+	return ParticleSimdLevel::AVX2;
+#elif defined(PARTICLE_HAS_SSE)
+	return ParticleSimdLevel::SSE;
+#else
+	return ParticleSimdLevel::Scalar;
+#endif
+}
+
+// ========================================
+// 更新
+// ========================================
+
+void ParticleStorage::Update(float deltaTime, ParticleSimdLevel simdLevel) {
+	UpdateRange(0, count_, deltaTime, simdLevel);
+	RemoveDead();
+}
+
+void ParticleStorage::UpdateRange(int begin, int end, float deltaTime, ParticleSimdLevel simdLevel) {
+	// スカラーパスは範囲全体が対象（SIMD で処理した分も含む）
+	const int rangeBegin = begin;
+
+#if defined(PARTICLE_HAS_AVX2)
+	if (simdLevel == ParticleSimdLevel::AVX2) {
+		const int vectorEnd = begin + ((end - begin) & ~7);
+		UpdateKernelAVX2(begin, vectorEnd, deltaTime);
+		begin = vectorEnd;
+		simdLevel = ParticleSimdLevel::SSE;
+	}
+#endif
+
+#if defined(PARTICLE_HAS_SSE)
+	if (simdLevel == ParticleSimdLevel::SSE) {
+		const int vectorEnd = begin + ((end - begin) & ~3);
+		UpdateKernelSSE(begin, vectorEnd, deltaTime);
+		begin = vectorEnd;
+	}
+#endif
+
+	// 端数（およびSIMD非対応ビルド）はスカラーで処理
+	UpdateKernelScalar(begin, end, deltaTime);
+
+	UpdateScalarPass(rangeBegin, end, deltaTime);
+}
+
+void ParticleStorage::UpdateKernelScalar(int begin, int end, float deltaTime) {
+	for (int i = begin; i < end; ++i) {
+		if (!alive[i]) continue;
+
+		// 1. 寿命を減算（秒）
+		lifeTimer[i] -= deltaTime;
+		if (lifeTimer[i] <= 0.0f) {
+			alive[i] = 0u;  // 詰めるのは RemoveDead でまとめて行う
+			continue;
+		}
+
+		// 2. 進行度を計算（0.0 ～ 1.0）
+		float t = 1.0f - (lifeTimer[i] / maxLife[i]);
+		t = std::clamp(t, 0.0f, 1.0f);
+
+		// 3. スケールと色を更新（カーブのテーブルがあれば1回読むだけ）
+		if (lutBase[i] >= 0) {
+			const int k = lutBase[i] + ParticleCurve::LutIndex(t);
+			currentScale[i] = lutScale_[k];
+			currentColor[i] = lutColor_[k];
+		}
+		else {
+			currentScale[i] = scaleStart[i] + (scaleEnd[i] - scaleStart[i]) * t;
+			currentColor[i] = ParticleCurve::LerpColor(colorStart[i], colorEnd[i], t);
+		}
+
+		// 4. Physics 挙動の積分
+		if (physicsMask[i]) {
+			velX[i] += accX[i] * deltaTime;
+			velY[i] += accY[i] * deltaTime;
+			posX[i] += velX[i] * deltaTime;
+			posY[i] += velY[i] * deltaTime;
+			rotation[i] += rotationSpeed[i] * deltaTime;
+		}
+	}
+}
+
+#if defined(PARTICLE_HAS_SSE)
+namespace {
+
+	// マスクが立っているレーンだけ newValue を採用（SSE2 には blendv が無いので and/andnot/or）
+	inline __m128 Select(__m128 mask, __m128 newValue, __m128 oldValue) {
+		return _mm_or_ps(_mm_and_ps(mask, newValue), _mm_andnot_ps(mask, oldValue));
+	}
+
+	inline __m128i Select(__m128i mask, __m128i newValue, __m128i oldValue) {
+		return _mm_or_si128(_mm_and_si128(mask, newValue), _mm_andnot_si128(mask, oldValue));
+	}
+
+	// 8bit チャンネルを取り出して float 化
+	inline __m128 Channel(__m128i color, int shift) {
+		const __m128i byteMask = _mm_set1_epi32(0xFF);
+		return _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(color, shift), byteMask));
+	}
+
+	// 補間して切り捨て、元の位置に戻す
+	inline __m128i LerpChannel(__m128i start, __m128i end, __m128 t, int shift) {
+		const __m128 s = Channel(start, shift);
+		const __m128 e = Channel(end, shift);
+		const __m128 v = _mm_add_ps(s, _mm_mul_ps(_mm_sub_ps(e, s), t));
+		return _mm_slli_epi32(_mm_cvttps_epi32(v), shift);
+	}
+}
+#endif
+
+void ParticleStorage::UpdateKernelSSE(int begin, int end, float deltaTime) {
+#if defined(PARTICLE_HAS_SSE)
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128i minusOne = _mm_set1_epi32(-1);
+	const __m128 lutLast = _mm_set1_ps(static_cast<float>(kParticleLutSize - 1));
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	for (int i = begin; i < end; i += 4) {
+		const __m128i aliveMask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&alive[i]));
+		if (_mm_movemask_epi8(aliveMask) == 0) continue;
+
+		// 1. 寿命を減算（生存レーンだけ dt 減らす）
+		__m128 life = _mm_loadu_ps(&lifeTimer[i]);
+		life = _mm_sub_ps(life, _mm_and_ps(_mm_castsi128_ps(aliveMask), dt));
+		_mm_storeu_ps(&lifeTimer[i], life);
+
+		const __m128i stillAliveI = _mm_and_si128(aliveMask, _mm_castps_si128(_mm_cmpgt_ps(life, zero)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&alive[i]), stillAliveI);
+		if (_mm_movemask_epi8(stillAliveI) == 0) continue;
+		const __m128 stillAlive = _mm_castsi128_ps(stillAliveI);
+
+		// 2. 進行度を計算（0.0 ～ 1.0）
+		__m128 t = _mm_sub_ps(one, _mm_div_ps(life, _mm_loadu_ps(&maxLife[i])));
+		t = _mm_min_ps(_mm_max_ps(t, zero), one);
+
+		// 3. スケールと色を更新
+		//    カーブのテーブルを使うレーンは番号を求めて読むだけ。残りのレーンは線形補間
+		//    （同じ種類の粒は並んで生成されるので、4レーンとも片方だけのことが多い）
+		const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&lutBase[i]));
+		const int aliveBits = _mm_movemask_ps(stillAlive);
+		const int lutBits = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(lut, minusOne))) & aliveBits;
+
+		if (lutBits != aliveBits) {
+			const __m128 ss = _mm_loadu_ps(&scaleStart[i]);
+			const __m128 se = _mm_loadu_ps(&scaleEnd[i]);
+			const __m128 scale = _mm_add_ps(ss, _mm_mul_ps(_mm_sub_ps(se, ss), t));
+			_mm_storeu_ps(&currentScale[i], Select(stillAlive, scale, _mm_loadu_ps(&currentScale[i])));
+
+			const __m128i cs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&colorStart[i]));
+			const __m128i ce = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&colorEnd[i]));
+			__m128i color = LerpChannel(cs, ce, t, 24);
+			color = _mm_or_si128(color, LerpChannel(cs, ce, t, 16));
+			color = _mm_or_si128(color, LerpChannel(cs, ce, t, 8));
+			color = _mm_or_si128(color, LerpChannel(cs, ce, t, 0));
+			const __m128i oldColor = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&currentColor[i]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&currentColor[i]), Select(stillAliveI, color, oldColor));
+		}
+
+		if (lutBits != 0) {
+			// SSE2 には gather が無いので番号だけまとめて求め、読むのはレーンごと
+			alignas(16) int32_t flat[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(flat),
+				_mm_add_epi32(lut, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(t, lutLast), half))));
+			for (int k = 0; k < 4; ++k) {
+				if (!(lutBits & (1 << k))) continue;
+				currentScale[i + k] = lutScale_[flat[k]];
+				currentColor[i + k] = lutColor_[flat[k]];
+			}
+		}
+
+		// 4. Physics 挙動の積分
+		const __m128 mask = _mm_and_ps(stillAlive,
+			_mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&physicsMask[i]))));
+		if (_mm_movemask_ps(mask) == 0) continue;
+
+		const __m128 vx = _mm_loadu_ps(&velX[i]);
+		const __m128 vy = _mm_loadu_ps(&velY[i]);
+		const __m128 px = _mm_loadu_ps(&posX[i]);
+		const __m128 py = _mm_loadu_ps(&posY[i]);
+		const __m128 rot = _mm_loadu_ps(&rotation[i]);
+
+		// スカラー版と同じ演算順序（乗算→加算）なので結果はビット単位で一致する
+		const __m128 nvx = _mm_add_ps(vx, _mm_mul_ps(_mm_loadu_ps(&accX[i]), dt));
+		const __m128 nvy = _mm_add_ps(vy, _mm_mul_ps(_mm_loadu_ps(&accY[i]), dt));
+		const __m128 npx = _mm_add_ps(px, _mm_mul_ps(nvx, dt));
+		const __m128 npy = _mm_add_ps(py, _mm_mul_ps(nvy, dt));
+		const __m128 nrot = _mm_add_ps(rot, _mm_mul_ps(_mm_loadu_ps(&rotationSpeed[i]), dt));
+
+		_mm_storeu_ps(&velX[i], Select(mask, nvx, vx));
+		_mm_storeu_ps(&velY[i], Select(mask, nvy, vy));
+		_mm_storeu_ps(&posX[i], Select(mask, npx, px));
+		_mm_storeu_ps(&posY[i], Select(mask, npy, py));
+		_mm_storeu_ps(&rotation[i], Select(mask, nrot, rot));
+	}
+#else
+	UpdateKernelScalar(begin, end, deltaTime);
+#endif
+}
+
+#if defined(PARTICLE_HAS_AVX2)
+namespace {
+
+	inline __m256 Channel8(__m256i color, int shift) {
+		const __m256i byteMask = _mm256_set1_epi32(0xFF);
+		return _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srlv_epi32(color, _mm256_set1_epi32(shift)), byteMask));
+	}
+
+	inline __m256i LerpChannel8(__m256i start, __m256i end, __m256 t, int shift) {
+		const __m256 s = Channel8(start, shift);
+		const __m256 e = Channel8(end, shift);
+		const __m256 v = _mm256_add_ps(s, _mm256_mul_ps(_mm256_sub_ps(e, s), t));
+		return _mm256_sllv_epi32(_mm256_cvttps_epi32(v), _mm256_set1_epi32(shift));
+	}
+}
+#endif
+
+void ParticleStorage::UpdateKernelAVX2(int begin, int end, float deltaTime) {
+#if defined(PARTICLE_HAS_AVX2)
+	const __m256 dt = _mm256_set1_ps(deltaTime);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256i minusOne = _mm256_set1_epi32(-1);
+	const __m256 lutLast = _mm256_set1_ps(static_cast<float>(kParticleLutSize - 1));
+	const __m256 half = _mm256_set1_ps(0.5f);
+
+	for (int i = begin; i < end; i += 8) {
+		const __m256i aliveMask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&alive[i]));
+		if (_mm256_testz_si256(aliveMask, aliveMask)) continue;
+
+		// 1. 寿命を減算（生存レーンだけ dt 減らす）
+		__m256 life = _mm256_loadu_ps(&lifeTimer[i]);
+		life = _mm256_sub_ps(life, _mm256_and_ps(_mm256_castsi256_ps(aliveMask), dt));
+		_mm256_storeu_ps(&lifeTimer[i], life);
+
+		const __m256i stillAliveI = _mm256_and_si256(aliveMask, _mm256_castps_si256(_mm256_cmp_ps(life, zero, _CMP_GT_OQ)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&alive[i]), stillAliveI);
+		if (_mm256_testz_si256(stillAliveI, stillAliveI)) continue;
+		const __m256 stillAlive = _mm256_castsi256_ps(stillAliveI);
+
+		// 2. 進行度を計算（0.0 ～ 1.0）
+		__m256 t = _mm256_sub_ps(one, _mm256_div_ps(life, _mm256_loadu_ps(&maxLife[i])));
+		t = _mm256_min_ps(_mm256_max_ps(t, zero), one);
+
+		// 3. スケールと色を更新（カーブのテーブルを使うレーンは gather で読む）
+		const __m256i lut = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&lutBase[i]));
+		const __m256i lutMask = _mm256_and_si256(stillAliveI, _mm256_cmpgt_epi32(lut, minusOne));
+		const int aliveBits = _mm256_movemask_ps(stillAlive);
+		const int lutBits = _mm256_movemask_ps(_mm256_castsi256_ps(lutMask));
+
+		if (lutBits != aliveBits) {
+			const __m256 ss = _mm256_loadu_ps(&scaleStart[i]);
+			const __m256 se = _mm256_loadu_ps(&scaleEnd[i]);
+			const __m256 scale = _mm256_add_ps(ss, _mm256_mul_ps(_mm256_sub_ps(se, ss), t));
+			_mm256_storeu_ps(&currentScale[i], _mm256_blendv_ps(_mm256_loadu_ps(&currentScale[i]), scale, stillAlive));
+
+			const __m256i cs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&colorStart[i]));
+			const __m256i ce = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&colorEnd[i]));
+			__m256i color = LerpChannel8(cs, ce, t, 24);
+			color = _mm256_or_si256(color, LerpChannel8(cs, ce, t, 16));
+			color = _mm256_or_si256(color, LerpChannel8(cs, ce, t, 8));
+			color = _mm256_or_si256(color, LerpChannel8(cs, ce, t, 0));
+			const __m256i oldColor = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&currentColor[i]));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(&currentColor[i]), _mm256_blendv_epi8(oldColor, color, stillAliveI));
+		}
+
+		if (lutBits != 0) {
+			const __m256i flat = _mm256_add_epi32(lut, _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(t, lutLast), half)));
+			const __m256 scale = _mm256_mask_i32gather_ps(_mm256_loadu_ps(&currentScale[i]),
+				lutScale_.data(), flat, _mm256_castsi256_ps(lutMask), 4);
+			_mm256_storeu_ps(&currentScale[i], scale);
+
+			const __m256i color = _mm256_mask_i32gather_epi32(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&currentColor[i])),
+				reinterpret_cast<const int*>(lutColor_.data()), flat, lutMask, 4);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(&currentColor[i]), color);
+		}
+
+		// 4. Physics 挙動の積分
+		const __m256 mask = _mm256_and_ps(stillAlive,
+			_mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&physicsMask[i]))));
+		if (_mm256_movemask_ps(mask) == 0) continue;
+
+		const __m256 vx = _mm256_loadu_ps(&velX[i]);
+		const __m256 vy = _mm256_loadu_ps(&velY[i]);
+		const __m256 px = _mm256_loadu_ps(&posX[i]);
+		const __m256 py = _mm256_loadu_ps(&posY[i]);
+		const __m256 rot = _mm256_loadu_ps(&rotation[i]);
+
+		const __m256 nvx = _mm256_add_ps(vx, _mm256_mul_ps(_mm256_loadu_ps(&accX[i]), dt));
+		const __m256 nvy = _mm256_add_ps(vy, _mm256_mul_ps(_mm256_loadu_ps(&accY[i]), dt));
+		const __m256 npx = _mm256_add_ps(px, _mm256_mul_ps(nvx, dt));
+		const __m256 npy = _mm256_add_ps(py, _mm256_mul_ps(nvy, dt));
+		const __m256 nrot = _mm256_add_ps(rot, _mm256_mul_ps(_mm256_loadu_ps(&rotationSpeed[i]), dt));
+
+		_mm256_storeu_ps(&velX[i], _mm256_blendv_ps(vx, nvx, mask));
+		_mm256_storeu_ps(&velY[i], _mm256_blendv_ps(vy, nvy, mask));
+		_mm256_storeu_ps(&posX[i], _mm256_blendv_ps(px, npx, mask));
+		_mm256_storeu_ps(&posY[i], _mm256_blendv_ps(py, npy, mask));
+		_mm256_storeu_ps(&rotation[i], _mm256_blendv_ps(rot, nrot, mask));
+	}
+#else
+	UpdateKernelSSE(begin, end, deltaTime);
+#endif
+}
+
+void ParticleStorage::UpdateScalarPass(int begin, int end, float deltaTime) {
+	for (int i = begin; i < end; ++i) {
+		if (!needsScalarPass[i] || !alive[i]) continue;
+
+		// アニメーションフレーム更新
+		AnimState& a = anim[i];
+		if (a.useAnimation && a.totalFrames > 1 && a.animSpeed > 0.0f) {
+			a.animTimer += deltaTime;
+			if (a.animTimer >= a.animSpeed) {
+				a.animTimer -= a.animSpeed;
+				a.currentFrame++;
+				if (a.currentFrame >= a.totalFrames) {
+					a.currentFrame = 0;
+				}
+			}
+		}
+
+		if (behavior[i] == ParticleBehavior::Homing) {
+			if (homingTarget[i] != nullptr) {
+				// ターゲットへの方向ベクトルを計算
+				float dx = homingTarget[i]->x - posX[i];
+				float dy = homingTarget[i]->y - posY[i];
+
+				// 正規化
+				float length = sqrtf(dx * dx + dy * dy);
+				if (length > 0.001f) {
+					dx /= length;
+					dy /= length;
+
+					// ターゲット方向への加速度を追加
+					velX[i] += dx * homingStrength[i] * deltaTime;
+					velY[i] += dy * homingStrength[i] * deltaTime;
+				}
+			}
+
+			velX[i] += accX[i] * deltaTime;
+			velY[i] += accY[i] * deltaTime;
+			posX[i] += velX[i] * deltaTime;
+			posY[i] += velY[i] * deltaTime;
+
+			// 回転を速度方向に向ける
+			if (velX[i] != 0.0f || velY[i] != 0.0f) {
+				rotation[i] = atan2f(velY[i], velX[i]);
+			}
+		}
+		else if (behavior[i] == ParticleBehavior::Stationary) {
+			// その場に留まる
+			rotation[i] += rotationSpeed[i] * deltaTime;
+		}
+		// Ghost：移動しない、フェードのみ
+	}
+}
+
+void ParticleStorage::ApplyWind(int begin, int end, float deltaTime, const float* windStrengthByType,
+	const ParticleFlowField* flowField, const Vector2& flowOffset) {
+	if (windStrengthByType == nullptr || flowField == nullptr || flowField->IsEmpty()) return;
+
+	for (int i = begin; i < end; ++i) {
+		if (!alive[i] || !GetParticleTypeTraits(type[i]).wind) continue;
+
+		const float windStrength = windStrengthByType[static_cast<int>(type[i])];
+		if (windStrength <= 0.0f) continue;
+
+		// 流れ場の速度で流す（速度には足さないので、風が止めば元の動きに戻る）
+		float windX = 0.0f;
+		float windY = 0.0f;
+		flowField->Sample(posX[i] - flowOffset.x, posY[i] - flowOffset.y, windX, windY);
+		posX[i] += windX * windStrength * deltaTime;
+		posY[i] += windY * windStrength * deltaTime;
+	}
+}
+
+void ParticleStorage::ApplyGroundCollision(int begin, int end, float groundY, const ParticleWorldResponse* responseByType,
+	std::vector<ParticleGroundHit>* hits) {
+	for (int i = begin; i < end; ++i) {
+		if (!alive[i]) continue;
+
+		// Yが+で上方向のシステムでは、地面より下 = Y <= groundY
+		if (posY[i] > groundY) continue;
+
+		const GroundResponse response = GetParticleTypeTraits(type[i]).ground;
+		if (response == GroundResponse::None) continue;
+
+		if (hits != nullptr) {
+			hits->push_back({ type[i], { posX[i], groundY } });
+		}
+
+		if (response == GroundResponse::Bounce) {
+			// 跳ね返って、すぐ消える（雨）
+			const float damping = responseByType != nullptr ? responseByType[static_cast<int>(type[i])].bounceDamping : 0.3f;
+			velY[i] *= -damping;
+			posY[i] = groundY;
+			lifeTimer[i] = std::min(lifeTimer[i], kGroundBounceLifeSeconds);
+		}
+		else {
+			// 地面に着いたら消える（雪）
+			alive[i] = 0u;
+		}
+	}
+}
+
+void ParticleStorage::ApplyWorldCollision(int begin, int end, const ParticleCollisionWorld& world,
+	const ParticleWorldResponse* responseByType, std::vector<ParticleGroundHit>* hits) {
+	if (responseByType == nullptr || world.IsEmpty()) return;
+
+	for (int i = begin; i < end; ++i) {
+		if (!alive[i]) continue;
+
+		const ParticleWorldResponse& response = responseByType[static_cast<int>(type[i])];
+		if (!response.collide) continue;
+
+		ParticleCollisionWorld::Contact contact;
+		if (!world.Query(posX[i], posY[i], contact)) continue;
+
+		if (hits != nullptr) {
+			hits->push_back({ type[i], contact.position });
+		}
+
+		if (response.killOnHit) {
+			alive[i] = 0u;
+			continue;
+		}
+
+		// 表面まで戻して、法線方向の速度だけ反転・減衰させる（離れていく向きなら変えない）
+		posX[i] = contact.position.x;
+		posY[i] = contact.position.y;
+		const float normalSpeed = velX[i] * contact.normal.x + velY[i] * contact.normal.y;
+		if (normalSpeed < 0.0f) {
+			const float impulse = -(1.0f + response.bounceDamping) * normalSpeed;
+			velX[i] += impulse * contact.normal.x;
+			velY[i] += impulse * contact.normal.y;
+		}
+	}
+}
+
+void ParticleStorage::StepRange(int begin, int end, const ParticleStepContext& context, std::vector<ParticleGroundHit>* hits) {
+	UpdateRange(begin, end, context.deltaTime, context.simdLevel);
+	ApplyWind(begin, end, context.deltaTime, context.windStrengthByType, context.flowField, context.flowOffset);
+	if (context.world != nullptr) {
+		ApplyWorldCollision(begin, end, *context.world, context.worldResponseByType, hits);
+	}
+	ApplyGroundCollision(begin, end, context.groundY, context.worldResponseByType, hits);
+}
+
+void ParticleStorage::AccumulateBounds(int begin, int end, ParticleBounds* boundsByType) const {
+	for (int i = begin; i < end; ++i) {
+		if (!alive[i]) continue;
+		boundsByType[static_cast<int>(type[i])].Expand(posX[i], posY[i]);
+	}
+}
@@ -0,0 +1,285 @@
+﻿#pragma once
+#include "Vector2.h"
+#include "ParticleEnum.h"
+#include "Novice.h"
+#include "ParticleCurve.h"
+#include <vector>
+#include <cstdint>
+#include <cfloat>
+#include <algorithm>
+
+#ifdef min
+#undef min
+#endif
+
+#ifdef max
+#undef max
+#endif
+
+class ParticleFlowField;
+class ParticleCollisionWorld;
+class SpriteSheet;
+
+/// <summary>
+/// 更新カーネルの命令セット
+/// </summary>
+enum class ParticleSimdLevel {
+	Scalar, // スカラー版（フォールバック・検証用）
+	SSE,    // SSE2（x64なら常に使用可能）
+	AVX2    // AVX2（/arch:AVX2 でビルドした場合のみ）
+};
+
+/// <summary>
+/// プールが満杯のときの方針
+/// </summary>
+enum class ParticlePoolPolicy {
+	DropNew,             // 新しい粒を捨てる
+	EvictOldest,         // 最も古い粒を上書き
+	EvictLowestPriority  // 優先度が最も低い粒を上書き（同じなら古い方）
+};
+
+/// <summary>
+/// プールの統計
+/// </summary>
+struct ParticlePoolStats {
+	int peakCount = 0;          // 最大同時生存数
+	unsigned int evicted = 0;   // 上書きで消された粒の数
+	unsigned int dropped = 0;   // 満杯で生成できなかった粒の数
+};
+
+/// <summary>
+/// 地面・地形に触れた粒の記録（発生処理は同期点でまとめて行う）
+/// </summary>
+struct ParticleGroundHit {
+	ParticleType type;
+	Vector2 position;
+};
+
+/// <summary>
+/// 粒の位置の外接矩形（ワールド座標、粒の大きさは含まない）
+/// </summary>
+struct ParticleBounds {
+	float minX = FLT_MAX;
+	float minY = FLT_MAX;
+	float maxX = -FLT_MAX;
+	float maxY = -FLT_MAX;
+
+	bool IsEmpty() const { return minX > maxX; }
+
+	void Expand(float x, float y) {
+		minX = std::min(minX, x);
+		minY = std::min(minY, y);
+		maxX = std::max(maxX, x);
+		maxY = std::max(maxY, y);
+	}
+
+	void Merge(const ParticleBounds& other) {
+		minX = std::min(minX, other.minX);
+		minY = std::min(minY, other.minY);
+		maxX = std::max(maxX, other.maxX);
+		maxY = std::max(maxY, other.maxY);
+	}
+};
+
+/// <summary>
+/// 地面・地形（ParticleCollisionWorld）に触れたときの、種類ごとの反応
+/// </summary>
+struct ParticleWorldResponse {
+	bool collide = false;        // 地形と判定する（地面は ParticleTypeTraits::ground に従う）
+	bool killOnHit = false;      // 地形に当たったら消える（false なら跳ね返る）
+	float bounceDamping = 0.3f;  // 跳ね返り係数（地面の Bounce にも使う）
+};
+
+/// <summary>
+/// 1ステップ分の更新設定（StepRange に渡す）。寿命も deltaTime で減る
+/// </summary>
+struct ParticleStepContext {
+	float deltaTime = 0.0f;
+	float groundY = 0.0f;
+	const float* windStrengthByType = nullptr;  // ParticleType ごとの風の強さ（nullptr なら無し）
+	const ParticleFlowField* flowField = nullptr; // 風の流れ場（nullptr・空なら無し）
+	Vector2 flowOffset = { 0.0f, 0.0f };        // 流れ場をずらす量（風が流れて見えるよう毎ステップ進める）
+	const ParticleCollisionWorld* world = nullptr;                // 地形（nullptr・空なら判定しない）
+	const ParticleWorldResponse* worldResponseByType = nullptr;   // ParticleType ごとの反応（nullptr なら地形判定なし・反発係数0.3）
+	ParticleSimdLevel simdLevel = ParticleSimdLevel::Scalar;
+};
+
+/// <summary>
+/// 1粒分の初期化データ（旧 Particle::Initialize の引数と同じ内容）
+/// </summary>
+struct ParticleSpawnDesc {
+	Vector2 position = { 0.0f, 0.0f };
+	Vector2 velocity = { 0.0f, 0.0f };
+	Vector2 acceleration = { 0.0f, 0.0f };
+	float life = 0.0f;  // 寿命（秒）
+	int textureHandle = -1;
+	float scaleStart = 1.0f;
+	float scaleEnd = 1.0f;
+	unsigned int colorStart = 0xFFFFFFFF;
+	unsigned int colorEnd = 0xFFFFFFFF;
+	float rotation = 0.0f;
+	float rotationSpeed = 0.0f;
+	BlendMode blendMode = kBlendModeNormal;
+	float drawSize = 0.0f;
+	bool useAnimation = false;
+	const SpriteSheet* spriteSheet = nullptr;  // 分割済みのシート（nullptr なら textureHandle と divX / divY から引く）
+	int divX = 1;
+	int divY = 1;
+	int totalFrames = 1;
+	float animSpeed = 0.0f;
+	int lifetimeLut = -1;  // SetLifetimeLut で登録した番号（-1 なら scale/color の Start → End を線形補間）
+};
+
+/// <summary>
+/// パーティクルの SoA（Structure of Arrays）ストレージ
+/// 毎フレーム触るストリーム（位置・速度・加速度・寿命・スケール・色）を別配列に分け、
+/// 寿命・補間・Physics 挙動の積分を1パスの SIMD カーネルでまとめて処理する。
+/// アニメーションと Homing / Stationary は該当する粒だけスカラーで処理する。
+/// 演算順序はスカラー版と同じなので、1粒ごとの結果は旧 Particle::Update とビット単位で一致する。
+/// 生存中の粒は常に [0, GetCount()) に詰めて保持し、消滅時は末尾と入れ替えて削除する。
+/// そのため更新・描画のコストは生存数に比例する（インデックスは削除のたびに変わりうる）。
+/// </summary>
+class ParticleStorage {
+public:
+	void Resize(int capacity);
+	int GetCapacity() const { return capacity_; }
+	int GetCount() const { return count_; }
+
+	/// <summary>
+	/// 粒を1つ生成する（挙動は Physics）
+	/// </summary>
+	/// <param name="priority">EvictLowestPriority で使う優先度（大きいほど残る）</param>
+	/// <returns>生成したインデックス（満杯で捨てた場合は -1）</returns>
+	int Spawn(ParticleType type, const ParticleSpawnDesc& desc, int priority = 0);
+
+	/// <summary>
+	/// 同じ種類・優先度の粒をまとめて生成する（空きスロットは1回で確保する）
+	/// descs の順に Spawn を呼んだのと同じ結果になる（満杯時の上書きも同じ順で行う）
+	/// </summary>
+	/// <param name="outIndices">生成したインデックス（count 個、捨てた粒は -1。nullptr 可）</param>
+	/// <returns>生成できた粒の数</returns>
+	int SpawnBatch(ParticleType type, const ParticleSpawnDesc* descs, int count, int priority, int* outIndices);
+
+	// 末尾と入れ替えて削除する（末尾にあった粒のインデックスが index に変わる）
+	void Kill(int index);
+	void KillAll();
+
+	void SetPolicy(ParticlePoolPolicy policy) { policy_ = policy; }
+	ParticlePoolPolicy GetPolicy() const { return policy_; }
+	const ParticlePoolStats& GetStats() const { return stats_; }
+	void ResetStats();
+
+	void SetBehavior(int index, ParticleBehavior behavior);
+	void SetHomingTarget(int index, const Vector2* target, float strength);
+
+	/// <summary>
+	/// 寿命カーブのテーブルを登録する（同じ番号なら上書き、生存中の粒にも次の更新から反映）
+	/// 更新中に呼ばないこと
+	/// </summary>
+	void SetLifetimeLut(int lutIndex, const ParticleLifetimeLut& lut);
+
+	/// <summary>
+	/// 生存中の粒を1フレーム分更新し、寿命が尽きた粒を取り除く
+	/// </summary>
+	/// <param name="deltaTime">経過時間（秒）</param>
+	/// <param name="simdLevel">積分カーネルの命令セット</param>
+	void Update(float deltaTime, ParticleSimdLevel simdLevel = GetBestSimdLevel());
+
+	// ========================================
+	// 範囲単位の更新（重ならない範囲なら別スレッドから同時に呼んでよい）
+	// 消えた粒は alive = 0 にするだけなので、最後に RemoveDead で詰める
+	// ========================================
+
+	// 寿命・補間・積分・アニメーション・挙動
+	void UpdateRange(int begin, int end, float deltaTime, ParticleSimdLevel simdLevel = GetBestSimdLevel());
+	// 流れ場の風で流す（ParticleTypeTraits::wind の種類のみ。位置 - flowOffset で場を引く）
+	void ApplyWind(int begin, int end, float deltaTime, const float* windStrengthByType,
+		const ParticleFlowField* flowField, const Vector2& flowOffset);
+	// 地面衝突判定（ParticleTypeTraits::ground に従って跳ね返る / 消える）。触れた粒を hits に積む
+	void ApplyGroundCollision(int begin, int end, float groundY, const ParticleWorldResponse* responseByType,
+		std::vector<ParticleGroundHit>* hits);
+	// 地形との衝突判定（responseByType[type].collide の種類のみ）。触れた粒を hits に積む
+	void ApplyWorldCollision(int begin, int end, const ParticleCollisionWorld& world,
+		const ParticleWorldResponse* responseByType, std::vector<ParticleGroundHit>* hits);
+	// 上の4つをまとめて行う（ParticleManager の更新1チャンク分）
+	void StepRange(int begin, int end, const ParticleStepContext& context, std::vector<ParticleGroundHit>* hits);
+
+	// 生存中の粒の位置を種類ごとの外接矩形に加える（boundsByType は kParticleTypeCount 個）
+	void AccumulateBounds(int begin, int end, ParticleBounds* boundsByType) const;
+
+	// alive == 0 になった粒を詰める（範囲更新の後、1スレッドで呼ぶ）
+	void RemoveDead();
+
+	// このビルドで使える最速の命令セット
+	static ParticleSimdLevel GetBestSimdLevel();
+
+	// ========================================
+	// ホットストリーム（更新で毎フレーム触る）
+	// ========================================
+	std::vector<float> posX, posY;
+	std::vector<float> velX, velY;
+	std::vector<float> accX, accY;
+	std::vector<float> rotation, rotationSpeed;
+	std::vector<float> lifeTimer, maxLife;  // 残り寿命・寿命（秒）
+	std::vector<float> scaleStart, scaleEnd, currentScale;
+	std::vector<unsigned int> colorStart, colorEnd, currentColor;
+	std::vector<int32_t> lutBase;  // 寿命カーブテーブルの先頭位置（-1 なら Start → End の線形補間）
+
+	// SIMD 用のレーンマスク（真なら全ビット1）
+	std::vector<uint32_t> alive;        // 生存中（更新中に寿命が尽きた粒だけが 0 になる）
+	std::vector<uint32_t> physicsMask;  // 挙動が Physics
+	// アニメーション / Homing / Stationary のいずれかでスカラー処理が必要
+	std::vector<uint8_t> needsScalarPass;
+
+	// ========================================
+	// コールドデータ（生成時・描画時のみ）
+	// ========================================
+	struct AnimState {
+		bool useAnimation = false;
+		const SpriteSheet* sheet = nullptr;  // useAnimation のときのフレーム矩形表（共有、解放されない）
+		int totalFrames = 1;
+		float animSpeed = 0.0f;
+		float animTimer = 0.0f;
+		int currentFrame = 0;
+	};
+
+	std::vector<ParticleType> type;
+	std::vector<ParticleBehavior> behavior;
+	std::vector<int> textureHandle;
+	std::vector<BlendMode> blendMode;
+	std::vector<float> drawSize;
+	std::vector<AnimState> anim;
+	std::vector<const Vector2*> homingTarget;
+	std::vector<float> homingStrength;
+	std::vector<int> priority;
+	std::vector<uint32_t> spawnSerial;  // 生成順の通し番号（古さの比較用）
+
+private:
+	int capacity_ = 0;
+	int count_ = 0;
+	uint32_t nextSerial_ = 0;
+
+	ParticlePoolPolicy policy_ = ParticlePoolPolicy::EvictOldest;
+	ParticlePoolStats stats_;
+
+	// 寿命カーブのテーブル（kParticleLutSize 個ずつ連続で並べる。AVX2 ではまとめて gather する）
+	std::vector<float> lutScale_;
+	std::vector<unsigned int> lutColor_;
+
+	// 確保済みのスロットに粒の全データを書く
+	void InitSlot(int index, ParticleType type, const ParticleSpawnDesc& desc, int priority);
+
+	// 満杯時に上書きするスロットを選ぶ（-1 なら新しい粒を捨てる）
+	int FindVictim(int newPriority) const;
+	// スロットの全データを移す
+	void MoveSlot(int from, int to);
+
+	// 寿命・スケール・色・Physics 積分（[begin, end) を処理）
+	void UpdateKernelScalar(int begin, int end, float deltaTime);
+	void UpdateKernelSSE(int begin, int end, float deltaTime);
+	void UpdateKernelAVX2(int begin, int end, float deltaTime);
+	// アニメーション・Homing・Stationary（該当する粒のみ）
+	void UpdateScalarPass(int begin, int end, float deltaTime);
+
+	void RefreshFlags(int index);
+};
@@ -0,0 +1,260 @@
+﻿#include "ParticleTrail.h"
+#include "ParticleCurve.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef min
+#undef min
+#endif
+
+#ifdef max
+#undef max
+#endif
+
+// ========================================
+// ParticleTrail
+// ========================================
+
+void ParticleTrail::Reset(const ParticleTrailSettings& settings) {
+	settings_ = settings;
+	settings_.maxPoints = std::max(2, settings_.maxPoints);
+	settings_.pointLifetime = std::max(0.001f, settings_.pointLifetime);
+	settings_.minSegmentLength = std::max(0.0f, settings_.minSegmentLength);
+
+	capacity_ = settings_.maxPoints;
+	points_.resize(capacity_);
+	leftEdge_.resize(capacity_);
+	rightEdge_.resize(capacity_);
+	segmentColor_.resize(capacity_);
+
+	textureWidth_ = 0;
+	textureHeight_ = 0;
+	if (settings_.textureHandle >= 0) {
+		Novice::GetTextureSize(settings_.textureHandle, &textureWidth_, &textureHeight_);
+	}
+
+	Clear();
+}
+
+void ParticleTrail::Clear() {
+	head_ = 0;
+	count_ = 0;
+	timeSincePush_ = 0.0f;
+	builtSegments_ = 0;
+}
+
+void ParticleTrail::Push(const Vector2& position) {
+	timeSincePush_ = 0.0f;
+	if (capacity_ == 0) return;
+
+	// 直前に打った点からまだ近ければ、先頭の点を今の位置に動かすだけ
+	if (count_ >= 2) {
+		const Vector2& previous = GetPoint(1);
+		const float dx = position.x - previous.x;
+		const float dy = position.y - previous.y;
+		if (dx * dx + dy * dy < settings_.minSegmentLength * settings_.minSegmentLength) {
+			Point& p = points_[head_];
+			p.position = position;
+			p.age = 0.0f;
+			return;
+		}
+	}
+
+	// 新しい点を打つ（いっぱいなら一番古い点を上書き）
+	head_ = count_ == 0 ? 0 : (head_ + 1) % capacity_;
+	points_[head_] = { position, 0.0f };
+	count_ = std::min(count_ + 1, capacity_);
+}
+
+void ParticleTrail::Update(float deltaTime) {
+	timeSincePush_ += deltaTime;
+
+	for (int i = 0; i < count_; ++i) {
+		points_[Slot(i)].age += deltaTime;
+	}
+
+	// 古い点は末尾に並んでいるので、末尾から寿命切れを落とす
+	while (count_ > 0 && points_[Slot(count_ - 1)].age >= settings_.pointLifetime) {
+		--count_;
+	}
+}
+
+float ParticleTrail::Progress(int i) const {
+	// 止まった軌跡も全体が消えていくよう古さを使い、容量で末尾が切れる場合も
+	// 末尾で widthEnd / colorEnd になるよう並び順とも比べる
+	const float byAge = points_[Slot(i)].age / settings_.pointLifetime;
+	const float byOrder = count_ > 1 ? static_cast<float>(i) / static_cast<float>(count_ - 1) : 0.0f;
+	return std::clamp(std::max(byAge, byOrder), 0.0f, 1.0f);
+}
+
+int ParticleTrail::Build(const Matrix3x3& vpMatrix, const ParticleTrailMask* mask) {
+	builtSegments_ = 0;
+	if (count_ < 2 || settings_.textureHandle < 0) return 0;
+
+	// 点ごとに、前後の点を結ぶ向きの法線方向へ太さの半分ずつ広げた左右の端を求める
+	// （区間ごとではなく点ごとに求めるので、隣の区間と角がつながる）
+	Vector2 normal = { 0.0f, 1.0f };
+	for (int i = 0; i < count_; ++i) {
+		const Vector2& p = GetPoint(i);
+		const Vector2& newer = GetPoint(std::max(i - 1, 0));
+		const Vector2& older = GetPoint(std::min(i + 1, count_ - 1));
+		const float dx = newer.x - older.x;
+		const float dy = newer.y - older.y;
+		const float length = std::sqrt(dx * dx + dy * dy);
+		if (length > 1e-4f) {
+			normal = { -dy / length, dx / length };  // 重なった点では直前の法線を使い続ける
+		}
+
+		const float t = Progress(i);
+		const float halfWidth = (settings_.widthStart + (settings_.widthEnd - settings_.widthStart) * t) * 0.5f;
+		leftEdge_[i] = Matrix3x3::Transform({ p.x + normal.x * halfWidth, p.y + normal.y * halfWidth }, vpMatrix);
+		rightEdge_[i] = Matrix3x3::Transform({ p.x - normal.x * halfWidth, p.y - normal.y * halfWidth }, vpMatrix);
+	}
+
+	int visible = 0;
+	builtSegments_ = count_ - 1;
+	for (int i = 0; i < builtSegments_; ++i) {
+		segmentColor_[i] = 0;
+
+		if (mask != nullptr) {
+			const Vector2& a = GetPoint(i);
+			const Vector2& b = GetPoint(i + 1);
+			const float mx = (a.x + b.x) * 0.5f - mask->center.x;
+			const float my = (a.y + b.y) * 0.5f - mask->center.y;
+			const bool inside = mx * mx + my * my <= mask->radius * mask->radius;
+			if (inside != mask->keepInside) continue;
+		}
+
+		const float t = (Progress(i) + Progress(i + 1)) * 0.5f;
+		const unsigned int color = ParticleCurve::LerpColor(settings_.colorStart, settings_.colorEnd, t);
+		if ((color & 0xFF) == 0) continue;  // 完全に透明な区間は描かない
+
+		segmentColor_[i] = color;
+		++visible;
+	}
+	return visible;
+}
+
+void ParticleTrail::Submit() const {
+	if (builtSegments_ == 0) return;
+
+	// テクスチャは中央の1列だけを使い、帯の幅方向にだけ濃淡がつくようにする
+	const int srcX = textureWidth_ / 2;
+	const int srcH = std::max(1, textureHeight_);
+
+	Novice::SetBlendMode(settings_.blendMode);
+
+	for (int i = 0; i < builtSegments_; ++i) {
+		if (segmentColor_[i] == 0) continue;
+
+		Novice::DrawQuad(
+			static_cast<int>(leftEdge_[i].x), static_cast<int>(leftEdge_[i].y),           // 左上（新しい側）
+			static_cast<int>(leftEdge_[i + 1].x), static_cast<int>(leftEdge_[i + 1].y),   // 右上（古い側）
+			static_cast<int>(rightEdge_[i].x), static_cast<int>(rightEdge_[i].y),         // 左下
+			static_cast<int>(rightEdge_[i + 1].x), static_cast<int>(rightEdge_[i + 1].y), // 右下
+			srcX, 0, 1, srcH,
+			settings_.textureHandle,
+			segmentColor_[i]
+		);
+	}
+
+	// デフォルトに戻す
+	Novice::SetBlendMode(kBlendModeNormal);
+}
+
+int ParticleTrail::Draw(const Matrix3x3& vpMatrix, const ParticleTrailMask* mask) {
+	const int drawn = Build(vpMatrix, mask);
+	Submit();
+	return drawn;
+}
+
+// ========================================
+// ParticleTrailPool
+// ========================================
+
+TrailHandle ParticleTrailPool::Create(const ParticleTrailSettings& settings) {
+	uint32_t index;
+	if (!freeSlots_.empty()) {
+		index = freeSlots_.back();
+		freeSlots_.pop_back();
+	}
+	else {
+		index = static_cast<uint32_t>(entries_.size());
+		entries_.emplace_back();
+	}
+
+	Entry& entry = entries_[index];
+	entry.trail.Reset(settings);
+	entry.inUse = true;
+	entry.released = false;
+	++activeCount_;
+
+	return { index, entry.generation };
+}
+
+bool ParticleTrailPool::Release(TrailHandle handle) {
+	if (Get(handle) == nullptr) return false;
+	entries_[handle.index].released = true;
+	return true;
+}
+
+void ParticleTrailPool::Clear() {
+	for (uint32_t i = 0; i < entries_.size(); ++i) {
+		Entry& entry = entries_[i];
+		if (!entry.inUse) continue;
+		entry.inUse = false;
+		++entry.generation;
+		freeSlots_.push_back(i);
+	}
+	activeCount_ = 0;
+}
+
+ParticleTrail* ParticleTrailPool::Get(TrailHandle handle) {
+	if (handle.index >= entries_.size()) return nullptr;
+	Entry& entry = entries_[handle.index];
+	if (!entry.inUse || entry.released || entry.generation != handle.generation) return nullptr;
+	return &entry.trail;
+}
+
+const ParticleTrail* ParticleTrailPool::Get(TrailHandle handle) const {
+	return const_cast<ParticleTrailPool*>(this)->Get(handle);
+}
+
+void ParticleTrailPool::Update(float deltaTime) {
+	for (uint32_t i = 0; i < entries_.size(); ++i) {
+		Entry& entry = entries_[i];
+		if (!entry.inUse) continue;
+
+		entry.trail.Update(deltaTime);
+
+		// 手放された軌跡は消えきったらスロットを空ける（ハンドルは世代で無効になる）
+		if (entry.released && entry.trail.IsEmpty()) {
+			entry.inUse = false;
+			++entry.generation;
+			freeSlots_.push_back(i);
+			--activeCount_;
+		}
+	}
+}
+
+int ParticleTrailPool::Build(const Matrix3x3& vpMatrix) {
+	lastQuadCount_ = 0;
+	for (Entry& entry : entries_) {
+		if (!entry.inUse) continue;
+		lastQuadCount_ += entry.trail.Build(vpMatrix);
+	}
+	return lastQuadCount_;
+}
+
+void ParticleTrailPool::Submit() const {
+	for (const Entry& entry : entries_) {
+		if (!entry.inUse) continue;
+		entry.trail.Submit();
+	}
+}
+
+int ParticleTrailPool::Draw(const Matrix3x3& vpMatrix) {
+	const int drawn = Build(vpMatrix);
+	Submit();
+	return drawn;
+}
@@ -0,0 +1,179 @@
+﻿#pragma once
+#include "Vector2.h"
+#include "Matrix3x3.h"
+#include "Novice.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 軌跡（リボン）の見た目の設定
+/// </summary>
+struct ParticleTrailSettings {
+	int textureHandle = -1;                 // 帯に貼るテクスチャ（中央の1列を縦に使う）
+	BlendMode blendMode = kBlendModeAdd;
+	int maxPoints = 32;                     // 点のリングバッファの容量（いっぱいなら古い点から上書き）
+	float pointLifetime = 0.3f;             // 点が残る時間（秒）
+	float minSegmentLength = 4.0f;          // 直前の点からこれ以上離れたら新しい点を打つ（それまでは先頭の点を動かす）
+	float widthStart = 8.0f;                // 先頭の太さ（ワールド長）
+	float widthEnd = 0.0f;                  // 末尾の太さ
+	unsigned int colorStart = 0xFFFFFFFF;   // 先頭の色
+	unsigned int colorEnd = 0xFFFFFF00;     // 末尾の色
+};
+
+/// <summary>
+/// 描画する区間を円の内側（または外側）に限る（望遠鏡のレンズなど、ステンシルの代わり）
+/// 判定は変換前の座標で、区間の中点を使う
+/// </summary>
+struct ParticleTrailMask {
+	Vector2 center = { 0.0f, 0.0f };
+	float radius = 0.0f;
+	bool keepInside = true;  // true なら円の内側だけ、false なら外側だけ描く
+};
+
+/// <summary>
+/// 軌跡（リボン）1本
+/// 動く物体の位置を毎フレーム Push すると点をリングバッファに溜め、隣り合う点を
+/// つないだ帯を区間ごとに1枚の DrawQuad で描く。太さと色は先頭から末尾に向かって
+/// （点の古さと並び順の遅い方で）widthStart → widthEnd / colorStart → colorEnd に変わる。
+/// 一定間隔で小さな粒を撒く方式に比べ、描く枚数は点の数 - 1 で済む
+/// </summary>
+class ParticleTrail {
+public:
+	ParticleTrail() = default;
+	explicit ParticleTrail(const ParticleTrailSettings& settings) { Reset(settings); }
+
+	/// <summary>
+	/// 設定し直して点を全て消す（バッファは容量が足りていれば使い回す）
+	/// </summary>
+	void Reset(const ParticleTrailSettings& settings);
+
+	// 点を全て消す（設定はそのまま）
+	void Clear();
+
+	/// <summary>
+	/// 先頭の位置を渡す（動く物体の位置を毎フレーム）
+	/// 直前に打った点から minSegmentLength 未満なら先頭の点を動かすだけ
+	/// </summary>
+	void Push(const Vector2& position);
+
+	/// <summary>
+	/// 点の古さを進め、寿命を過ぎた点を末尾から消す
+	/// </summary>
+	void Update(float deltaTime);
+
+	/// <summary>
+	/// 帯の頂点と区間ごとの色を求める（DrawQuad の直前まで）
+	/// </summary>
+	/// <param name="vpMatrix">ワールド → スクリーンの変換</param>
+	/// <param name="mask">描く範囲（nullptr なら全て）</param>
+	/// <returns>描く DrawQuad の枚数（範囲外・完全に透明な区間は除く）</returns>
+	int Build(const Matrix3x3& vpMatrix, const ParticleTrailMask* mask = nullptr);
+
+	// Build した帯を DrawQuad で描く（ブレンドモードは描いたあと Normal に戻す）
+	void Submit() const;
+
+	// Build + Submit。描いた枚数を返す
+	int Draw(const Matrix3x3& vpMatrix, const ParticleTrailMask* mask = nullptr);
+
+	/// <summary>
+	/// 描くはずの枚数（点の数 - 1、点が1つ以下なら 0）
+	/// </summary>
+	int GetSegmentCount() const { return count_ > 1 ? count_ - 1 : 0; }
+	int GetPointCount() const { return count_; }
+	bool IsEmpty() const { return count_ == 0; }
+
+	// 新しい順に i 番目の点（0 が先頭）
+	const Vector2& GetPoint(int i) const { return points_[Slot(i)].position; }
+
+	// 最後に Push してからの時間（秒）
+	float GetTimeSincePush() const { return timeSincePush_; }
+
+	const ParticleTrailSettings& GetSettings() const { return settings_; }
+
+private:
+	struct Point {
+		Vector2 position;
+		float age;  // 打ってからの時間（秒）
+	};
+
+	// 新しい順の番号 → バッファ上の番号
+	int Slot(int i) const {
+		int s = head_ - i;
+		return s < 0 ? s + capacity_ : s;
+	}
+
+	// 新しい順に i 番目の点の、先頭からの進み具合（0 〜 1）
+	float Progress(int i) const;
+
+	ParticleTrailSettings settings_;
+	std::vector<Point> points_;  // リングバッファ
+	int capacity_ = 0;
+	int head_ = 0;               // 先頭（最新）の点の位置
+	int count_ = 0;
+	float timeSincePush_ = 0.0f;
+
+	int textureWidth_ = 0;
+	int textureHeight_ = 0;
+
+	// Build の結果（点ごとの帯の左右の端はスクリーン座標、区間の色は描かないなら 0）
+	std::vector<Vector2> leftEdge_;
+	std::vector<Vector2> rightEdge_;
+	std::vector<unsigned int> segmentColor_;
+	int builtSegments_ = 0;
+};
+
+/// <summary>
+/// 軌跡のハンドル（スロット番号と世代。解放済みの軌跡のハンドルは無効のまま）
+/// </summary>
+struct TrailHandle {
+	static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+	uint32_t index = kInvalidIndex;
+	uint32_t generation = 0;
+
+	bool IsValid() const { return index != kInvalidIndex; }
+
+	bool operator==(const TrailHandle& other) const = default;
+};
+
+/// <summary>
+/// 軌跡のプール（ParticleManager が持つ。エミッター1つにつき軌跡1本）
+/// Release した軌跡は点を追加しなくなり、残った点が全て消えた時点でスロットを空ける
+/// </summary>
+class ParticleTrailPool {
+public:
+	TrailHandle Create(const ParticleTrailSettings& settings);
+
+	/// <summary>
+	/// 先頭の追加をやめる（残りはそのまま消えていく）。無効なハンドルなら false
+	/// </summary>
+	bool Release(TrailHandle handle);
+	void Clear();
+
+	// 生きている（Release していない）軌跡を引く（無効なら nullptr）
+	ParticleTrail* Get(TrailHandle handle);
+	const ParticleTrail* Get(TrailHandle handle) const;
+	bool IsAlive(TrailHandle handle) const { return Get(handle) != nullptr; }
+
+	void Update(float deltaTime);
+	// 全ての軌跡を Build する（描く枚数を返す）。Submit で DrawQuad まで行う
+	int Build(const Matrix3x3& vpMatrix);
+	void Submit() const;
+	int Draw(const Matrix3x3& vpMatrix);
+
+	int GetCount() const { return activeCount_; }       // 使用中のスロット（Release 後に消えていく途中も含む）
+	int GetLastQuadCount() const { return lastQuadCount_; }
+
+private:
+	struct Entry {
+		ParticleTrail trail;
+		uint32_t generation = 1;  // 0 は既定のハンドルと区別するため使わない
+		bool inUse = false;
+		bool released = false;
+	};
+
+	std::vector<Entry> entries_;
+	std::vector<uint32_t> freeSlots_;
+	int activeCount_ = 0;
+	int lastQuadCount_ = 0;
+};
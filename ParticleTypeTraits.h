@@ -0,0 +1,96 @@
+﻿#pragma once
+#include "ParticleEnum.h"
+#include <array>
+#include <cstddef>
+
+// ParticleType の種類数（enum の末尾 + 1）
+constexpr int kParticleTypeCount = static_cast<int>(ParticleType::SmokeCloud) + 1;
+
+constexpr bool IsValidParticleType(ParticleType type) {
+	return static_cast<int>(type) >= 0 && static_cast<int>(type) < kParticleTypeCount;
+}
+
+/// <summary>
+/// 地面に触れたときの反応
+/// </summary>
+enum class GroundResponse {
+	None,    // 判定しない
+	Bounce,  // 跳ね返ってすぐ消える（雨）
+	Kill     // その場で消える（雪）
+};
+
+// 地面で跳ね返った粒の残り寿命の上限（秒）
+constexpr float kGroundBounceLifeSeconds = 10.0f / 60.0f;
+
+/// <summary>
+/// 種類ごとの固定の性質（コンパイル時に決まる）
+/// 調整用の数値は ParticleParam 側、ここは「その種類がどう振る舞うか」だけを持つ
+/// </summary>
+struct ParticleTypeTraits {
+	GroundResponse ground = GroundResponse::None;
+	bool wind = false;              // 流れ場の風で流される（windStrength）
+	bool homing = false;            // ターゲット追従できる（useHoming と併用）
+	bool stationary = false;        // 生成時に Stationary 挙動にする
+	bool spawnFromScreenTop = false;// FollowTarget のとき画面上端から発生
+};
+
+namespace ParticleTraitsDetail {
+	constexpr ParticleTypeTraits Make(GroundResponse ground, bool wind, bool homing, bool stationary, bool spawnFromScreenTop) {
+		ParticleTypeTraits t;
+		t.ground = ground;
+		t.wind = wind;
+		t.homing = homing;
+		t.stationary = stationary;
+		t.spawnFromScreenTop = spawnFromScreenTop;
+		return t;
+	}
+
+	using G = GroundResponse;
+
+	// ParticleType の並び順と一致させること
+	constexpr std::array<ParticleTypeTraits, kParticleTypeCount> kTable = { {
+		//    ground      wind   homing stationary screenTop
+		Make(G::None,   false, false, false, false),  // Explosion
+		Make(G::None,   false, false, false, false),  // Debris
+		Make(G::None,   false, false, false, false),  // Hit
+		Make(G::None,   false, false, false, false),  // Dust
+		Make(G::None,   false, false, false, false),  // MuzzleFlash
+		Make(G::Bounce, true,  false, false, true),   // Rain
+		Make(G::Kill,   true,  false, false, true),   // Snow
+		Make(G::None,   true,  false, true,  false),  // Orb
+		Make(G::None,   false, true,  false, false),  // Charge
+		Make(G::None,   false, false, false, false),  // Glow
+		Make(G::None,   false, false, false, false),  // Shockwave
+		Make(G::None,   false, false, false, false),  // Sparkle
+		Make(G::None,   false, false, false, false),  // Slash
+		Make(G::None,   true,  false, false, false),  // SmokeCloud
+	} };
+}
+
+constexpr const ParticleTypeTraits& GetParticleTypeTraits(ParticleType type) {
+	return ParticleTraitsDetail::kTable[static_cast<size_t>(type)];
+}
+
+static_assert(GetParticleTypeTraits(ParticleType::Rain).ground == GroundResponse::Bounce, "traits table is out of order");
+static_assert(GetParticleTypeTraits(ParticleType::Snow).wind, "traits table is out of order");
+static_assert(GetParticleTypeTraits(ParticleType::Charge).homing, "traits table is out of order");
+
+/// <summary>
+/// ParticleType で直接引ける固定長テーブル
+/// </summary>
+template <typename T>
+class ParticleTypeTable {
+public:
+	T& operator[](ParticleType type) { return values_[static_cast<size_t>(type)]; }
+	const T& operator[](ParticleType type) const { return values_[static_cast<size_t>(type)]; }
+
+	static constexpr int size() { return kParticleTypeCount; }
+
+	auto begin() { return values_.begin(); }
+	auto end() { return values_.end(); }
+	auto begin() const { return values_.begin(); }
+	auto end() const { return values_.end(); }
+
+private:
+	std::array<T, kParticleTypeCount> values_{};
+};
@@ -1,5 +1,6 @@
 ﻿#include "Scrap.h"
 #include <Novice.h>
+#include <algorithm>
 #include <cmath>
 
 #ifdef max
@@ -17,44 +18,28 @@ void Scrap::Initialize(ScrapType type, ScrapTrait trait, const Vector2& position
 	velocity_ = initialVelocity;
 	state_ = ScrapState::Free;
 	isActive_ = true;
+	isSleeping_ = false;
+	restFrames_ = 0;
 	angle_ = 0.0f;
 	orbitAngle_ = 0.0f;
 	lifetimeTimer_ = 0;
 
 	// タイプに応じた半径設定
-	switch (type_) {
-	case ScrapType::Small:
-		radius_ = kSmallRadius;
-		break;
-	case ScrapType::Medium:
-		radius_ = kMediumRadius;
-		break;
-	case ScrapType::Large:
-		radius_ = kLargeRadius;
-		break;
-	}
+	radius_ = GetTypeRadius(type_);
+
+	// 見た目は種類ごとの共有データを指すだけ（テクスチャの読み込みは最初の1回だけ）
+	renderDesc_ = &ScrapRenderDesc::Get(type_);
+	breakTimer_ = 0.0f;
+	breakFrame_ = 0;
+}
 
-	width_ = radius_ * 2.0f;
-	height_ = radius_ * 2.0f;
-
-	// 描画コンポーネントの初期化
-	drawComponent_ = DrawComponent2D(
-		position_, width_, height_,
-		Novice::LoadTexture("./NoviceResources/white1x1.png"),
-		1, 1, 1, 1, 0.0f, false
-	);
-
-	// ヒット時の破壊エフェクト用コンポーネント
-	drawCompBreak_ = DrawComponent2D(
-		position_, width_ * 2.0f, height_ * 2.0f,
-		Novice::LoadTexture("./Resources/images/tomo/scrap_break_ver1.png"),
-		64, 64, 4, 4, 0.1f, false
-	);
-
-	drawComponent_.StopAnimation();
-	drawComponent_.PlayAnimation();
-	drawCompBreak_.StopAnimation();
-	drawCompBreak_.PlayAnimation();
+float Scrap::GetTypeRadius(ScrapType type) {
+	switch (type) {
+	case ScrapType::Small:  return kSmallRadius;
+	case ScrapType::Medium: return kMediumRadius;
+	case ScrapType::Large:  return kLargeRadius;
+	default: return kSmallRadius;
+	}
 }
 
 float Scrap::GetWeight() const {
@@ -79,11 +64,27 @@ float Scrap::GetCollisionRadius() const {
 }
 
 void Scrap::Update(float dt) {
+	// 眠っている間は位置も角度も変わらない
+	if (isSleeping_) {
+		return;
+	}
 
 	switch (state_) {
 	case ScrapState::Free:
 		// 摩擦による減速
 		velocity_ *= kFriction;
+
+		// 遅い状態が続いたら止めて眠る
+		if (sleepEnabled_ && velocity_.x * velocity_.x + velocity_.y * velocity_.y < kSleepSpeed * kSleepSpeed) {
+			if (++restFrames_ >= kSleepFrames) {
+				velocity_ = { 0.0f, 0.0f };
+				isSleeping_ = true;
+				return;
+			}
+		}
+		else {
+			restFrames_ = 0;
+		}
 		break;
 
 	case ScrapState::BeingSucked:
@@ -96,10 +97,6 @@ void Scrap::Update(float dt) {
 		break;
 
 	case ScrapState::Fired:
-
-		// 破壊アニメーションの位置更新
-		drawCompBreak_.position_ = position_;
-
 		// 発射後は直進
 		lifetimeTimer_++;
 		if (lifetimeTimer_ > kFiredLifetime) {
@@ -107,14 +104,20 @@ void Scrap::Update(float dt) {
 		}
 		break;
 
-	case ScrapState::Hit:
-		// ヒット後はアニメーション更新のみ
-		drawCompBreak_.UpdateAnimation(dt, position_, angle_, scale_);
-		if (drawCompBreak_.animation_->GetCurrentFrame() >= drawCompBreak_.animation_->GetTotalFrames() - 1) {
+	case ScrapState::Hit: {
+		// ヒット後はアニメーション更新のみ（最後のフレームに着いたら消える）
+		const ScrapBreakClip* clip = renderDesc_ != nullptr ? renderDesc_->breakClip : nullptr;
+		const int lastFrame = clip != nullptr ? clip->frameCount - 1 : 0;
+		breakTimer_ += dt;
+		if (clip != nullptr && clip->frameDuration > 0.0f) {
+			breakFrame_ = std::min(static_cast<int>(breakTimer_ / clip->frameDuration), lastFrame);
+		}
+		if (breakFrame_ >= lastFrame) {
 			isActive_ = false;
 		}
 		return; // 位置更新しない
 	}
+	}
 
 	// 位置更新
 	if (state_ != ScrapState::Hit) {
@@ -123,10 +126,6 @@ void Scrap::Update(float dt) {
 
 	// 回転アニメーション
 	angle_ += 2.0f * dt;
-
-	// 描画コンポーネントの更新
-	drawComponent_.position_ = position_;
-	drawComponent_.angle_ = angle_;
 }
 
 void Scrap::ApplySuction(const Vector2& vaccumPos, float vaccumRadius, float dt) {
@@ -181,9 +180,6 @@ void Scrap::UpdateHeldPosition(const Vector2& vaccumPos, float orbitRadius, floa
 		vaccumPos.x + std::cos(orbitAngle_) * orbitRadius,
 		vaccumPos.y + std::sin(orbitAngle_) * orbitRadius
 	};
-
-	// 描画コンポーネントの位置も更新
-	drawComponent_.position_ = position_;
 }
 
 void Scrap::Fire(const Vector2& direction, float speed) {
@@ -220,16 +216,20 @@ void Scrap::Draw(const Vector2& scrollOffset) {
 	case ScrapState::Fired:       color = 0xFF0000FF; break;
 	}
 
-	// タイプに応じた色調整
-	switch (type_) {
-	case ScrapType::Small:  color = (color & 0xFFFFFF00) | 0xAAu; break;
-	case ScrapType::Medium: color = (color & 0xFFFFFF00) | 0xCCu; break;
-	case ScrapType::Large:  color = (color & 0xFFFFFF00) | 0xFFu; break;
+	if (renderDesc_ == nullptr) {
+		return;
 	}
 
-	drawComponent_.DrawAnimationScreen(color);
+	// タイプに応じた色調整
+	color = (color & 0xFFFFFF00) | renderDesc_->bodyAlpha;
+
+	ScrapRenderDesc::DrawRotatedQuad(drawPos, renderDesc_->bodySize, angle_,
+		0, 0, 1, 1, renderDesc_->bodyTexture, color);
 
-	if (state_ == ScrapState::Hit) {
-		drawCompBreak_.DrawAnimationScreen();
+	if (state_ == ScrapState::Hit && renderDesc_->breakClip != nullptr) {
+		const SpriteSheet* sheet = renderDesc_->breakClip->sheet;
+		const SpriteFrameRect& frame = sheet->GetFrame(breakFrame_);
+		ScrapRenderDesc::DrawRotatedQuad(drawPos, renderDesc_->breakSize, angle_,
+			frame.x, frame.y, frame.w, frame.h, sheet->GetTextureHandle(), 0xFFFFFFFF);
 	}
 }
\ No newline at end of file
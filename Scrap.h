@@ -1,6 +1,6 @@
 ﻿#pragma once
 #include "Vector2.h"
-#include "DrawComponent2D.h"
+#include "ScrapRenderDesc.h"
 
 enum class ScrapType {
 	Small,
@@ -23,6 +23,9 @@ enum class ScrapTrait {
 };
 
 class Scrap {
+	// 状態は ScrapManager が状態ごとの集合と一緒に書き換える（ScrapManager::SetScrapState）
+	friend class ScrapManager;
+	friend class ScrapBenchmark;
 public:
 	Scrap() = default;
 	~Scrap() = default;
@@ -39,11 +42,12 @@ public:
 	float GetRadius() const { return radius_; }
 	float GetCollisionRadius() const; // 状態に応じた当たり判定半径
 	float GetWeight() const;
+	static float GetTypeRadius(ScrapType type); // 種類ごとの半径
 	bool IsActive() const { return isActive_; }
+	bool IsSleeping() const { return isSleeping_; } // 止まっていて更新を止めているか（Free のときだけ）
 	float GetOrbitAngle() const { return orbitAngle_; } // 保持中の角度
 
 	// Setter
-	void SetState(ScrapState state) { state_ = state; }
 	void SetActive(bool active) { isActive_ = active; }
 	void SetVelocity(const Vector2& vel) { velocity_ = vel; }
 	void AddVelocity(const Vector2& vel) { velocity_ += vel; }
@@ -56,30 +60,38 @@ public:
 	// 保持中の位置更新（vaccumPos周辺で回転）
 	void UpdateHeldPosition(const Vector2& vaccumPos, float orbitRadius, float dt);
 
-	// 発射処理
+private:
+	void SetState(ScrapState state) { state_ = state; }
+
+	// 眠りから起こす（状態を変えるとき・衝撃を受けたときに ScrapManager が呼ぶ）
+	void WakeUp() { isSleeping_ = false; restFrames_ = 0; }
+
+	// 発射処理（状態も Fired にするので ScrapManager からだけ呼ぶ）
 	void Fire(const Vector2& direction, float speed);
 
-private:
 	ScrapType type_ = ScrapType::Small;
 	ScrapTrait trait_ = ScrapTrait::Normal;
 	ScrapState state_ = ScrapState::Free;
 
-	Vector2 scale_{ 1.0f, 1.0f };
 	Vector2 position_{};
 	Vector2 velocity_{};
 	float angle_ = 0.0f;
 	float orbitAngle_ = 0.0f; // 保持中の公転角度
 	float radius_ = 0.0f;
-	float width_ = 0.0f;
-	float height_ = 0.0f;
 
 	float weight_ = 0.0f; // 重量（タイプに応じて設定）
 
 	int lifetimeTimer_ = 0;
 	bool isActive_ = true;
 
-	DrawComponent2D drawComponent_;
-	DrawComponent2D drawCompBreak_;
+	// Free で遅い状態が続いたら眠らせる（眠っている間は Update しない）
+	bool isSleeping_ = false;
+	int restFrames_ = 0;
+
+	// 見た目は種類ごとに共有し、個体は壊れるアニメーションの進み具合だけを持つ
+	const ScrapRenderDesc* renderDesc_ = nullptr;
+	float breakTimer_ = 0.0f;
+	int breakFrame_ = 0;
 
 private: // 定数
 	// サイズ定数
@@ -105,6 +117,8 @@ private: // 定数
 	constexpr static float kSuctionAcceleration = 500.0f;
 	constexpr static int kFiredLifetime = 180;
 	constexpr static float kOrbitRotationSpeed = 2.0f;     // 保持中の回転速度
+	constexpr static float kSleepSpeed = 5.0f;             // これより遅ければ止まりかけとみなす（px/秒）
+	constexpr static int kSleepFrames = 30;                // 止まりかけがこのフレーム数続いたら眠る
 
 
 public:
@@ -115,6 +129,10 @@ public:
 	static void SetDamageMultiplier(float multiplier) { kDamageMultiplier_ = multiplier; }
 	static float GetDamageMultiplier() { return kDamageMultiplier_; }
 
+	// 眠り状態を使うか（計測・デバッグ用。false にしても既に眠っているものは起きない）
+	static void SetSleepEnabled(bool enabled) { sleepEnabled_ = enabled; }
+	static bool IsSleepEnabled() { return sleepEnabled_; }
+
 private:
 	// ========================================
 	// ダメージ定数
@@ -124,4 +142,5 @@ private:
 	static constexpr int kMaxDamage_ = 100;               // 最大ダメージ
 
 	static inline float kDamageMultiplier_ = 1.0f;        // ダメージ倍率（調整用）
+	static inline bool sleepEnabled_ = true;
 };
\ No newline at end of file
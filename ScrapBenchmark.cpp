@@ -0,0 +1,525 @@
+﻿#include "ScrapBenchmark.h"
+#include "ScrapManager.h"
+#include "ScrapRenderDesc.h"
+#include "ScrapSpawnPlacer.h"
+#include "DrawComponent2D.h"
+#include "FastRandom.h"
+#include <Novice.h>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <utility>
+
+namespace {
+
+	// 旧 Scrap::Initialize が1個ごとに作っていた見た目
+	struct LegacyScrapVisual {
+		DrawComponent2D body;
+		DrawComponent2D breakEffect;
+	};
+
+	LegacyScrapVisual MakeLegacyVisual() {
+		LegacyScrapVisual visual{
+			DrawComponent2D(Novice::LoadTexture("./NoviceResources/white1x1.png"), 1, 1, 1, 0.0f, false),
+			DrawComponent2D(Novice::LoadTexture("./Resources/images/tomo/scrap_break_ver1.png"), 4, 1, 4, 0.1f, false)
+		};
+		visual.body.StopAnimation();
+		visual.body.PlayAnimation();
+		visual.breakEffect.StopAnimation();
+		visual.breakEffect.PlayAnimation();
+		return visual;
+	}
+
+	template <typename Func>
+	double MeasureUs(int repeats, Func&& func) {
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int r = 0; r < repeats; ++r) {
+			func();
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::micro>(end - start).count() / repeats;
+	}
+
+	// 吸引口のまわりに count 個を詰めて並べる（状態は outStates に返す。外側の1割は吸引中、残りは保持中）
+	std::vector<Scrap> MakeHeldCluster(int count, std::vector<ScrapState>& outStates) {
+		std::mt19937 engine(12345);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		const ScrapType kTypes[] = { ScrapType::Small, ScrapType::Medium, ScrapType::Large };
+		const Vector2 center{ 640.0f, 360.0f };
+		// 1個あたり 20px 四方くらいの密度（保持中の判定半径なら大半が隣と重なる）
+		const float clusterRadius = std::sqrt(static_cast<float>(count) * 400.0f / 3.14159265f);
+
+		std::vector<Scrap> scraps(count);
+		outStates.assign(count, ScrapState::Held);
+		for (int i = 0; i < count; ++i) {
+			const float r = clusterRadius * std::sqrt(unit(engine));
+			const float angle = unit(engine) * 2.0f * 3.14159265f;
+			scraps[i].Initialize(kTypes[i % 3], ScrapTrait::Normal,
+				{ center.x + std::cos(angle) * r, center.y + std::sin(angle) * r }, { 0.0f, 0.0f });
+			outStates[i] = r > clusterRadius * 0.95f ? ScrapState::BeingSucked : ScrapState::Held;
+		}
+		return scraps;
+	}
+
+	// 円どうしが gap を空けずに重なっている組の数
+	int CountOverlaps(const std::vector<Vector2>& positions, const std::vector<float>& radii, float gap) {
+		int overlaps = 0;
+		for (size_t i = 0; i < positions.size(); ++i) {
+			for (size_t j = i + 1; j < positions.size(); ++j) {
+				const float dx = positions[j].x - positions[i].x;
+				const float dy = positions[j].y - positions[i].y;
+				const float minDistance = radii[i] + radii[j] + gap;
+				if (dx * dx + dy * dy < minDistance * minDistance * 0.999f) {
+					overlaps++;
+				}
+			}
+		}
+		return overlaps;
+	}
+
+	// 保持中を含む組に残った重なりの合計（吸引中どうしは押し出さないので数えない）
+	float SumOverlap(const std::vector<Scrap>& scraps) {
+		float total = 0.0f;
+		for (size_t i = 0; i < scraps.size(); ++i) {
+			for (size_t j = i + 1; j < scraps.size(); ++j) {
+				if (scraps[i].GetState() == ScrapState::BeingSucked && scraps[j].GetState() == ScrapState::BeingSucked) {
+					continue;
+				}
+				const Vector2 a = scraps[i].GetPosition();
+				const Vector2 b = scraps[j].GetPosition();
+				const float distance = std::sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+				const float minDistance = scraps[i].GetCollisionRadius() + scraps[j].GetCollisionRadius();
+				if (distance < minDistance) {
+					total += minDistance - distance;
+				}
+			}
+		}
+		return total;
+	}
+}
+
+std::vector<ScrapBenchmark::SpawnBurstResult> ScrapBenchmark::RunSpawnBurstBenchmark(int repeats) {
+	const int kBurstCounts[] = { 50, 200, 500 };
+	const ScrapType kTypes[] = { ScrapType::Small, ScrapType::Medium, ScrapType::Large };
+
+	if (repeats < 1) repeats = 1;
+
+	std::vector<SpawnBurstResult> results;
+	for (int count : kBurstCounts) {
+		SpawnBurstResult result;
+		result.burstCount = count;
+
+		// 旧方式: 生成ごとにテクスチャを引き、Animation を new する
+		std::vector<LegacyScrapVisual> legacy;
+		legacy.reserve(count);
+		const double legacyUs = MeasureUs(repeats, [&]() {
+			legacy.clear();
+			for (int i = 0; i < count; ++i) {
+				legacy.push_back(MakeLegacyVisual());
+			}
+		});
+		result.legacyUsPerSpawn = legacyUs / count;
+		result.legacyTextureLoads = count * 2;
+
+		// 共有方式: 最初の1体でテクスチャを読み込み、以降は同じ ScrapRenderDesc を指す
+		ScrapRenderDesc::Reset();
+		const int loadsBefore = ScrapRenderDesc::GetTextureLoadCount();
+		ScrapManager manager;
+		manager.SetRandomSeed(12345);
+		const double flyweightUs = MeasureUs(repeats, [&]() {
+			manager.ClearAll();
+			for (int i = 0; i < count; ++i) {
+				const Vector2 position{ static_cast<float>(i % 40) * 32.0f, static_cast<float>(i / 40) * 32.0f };
+				manager.SpawnScrap(kTypes[i % 3], position, { 0.0f, 0.0f });
+			}
+		});
+		result.flyweightUsPerSpawn = flyweightUs / count;
+		result.flyweightTextureLoads = ScrapRenderDesc::GetTextureLoadCount() - loadsBefore;
+
+		// 旧 Scrap は今の Scrap に DrawComponent2D 2つと、それぞれが持つ Animation を足した大きさ
+		result.legacyBytesPerScrap = static_cast<int>(sizeof(Scrap) + 2 * (sizeof(DrawComponent2D) + sizeof(Animation)));
+		result.flyweightBytesPerScrap = static_cast<int>(sizeof(Scrap));
+
+		results.push_back(result);
+	}
+	return results;
+}
+
+void ScrapBenchmark::PrintSpawnBurstResults(const std::vector<SpawnBurstResult>& results) {
+	Novice::ConsolePrintf("=== Scrap Spawn Burst Benchmark (us/spawn) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("%4d: Legacy %.3f / Flyweight %.3f  bytes %d -> %d  LoadTexture %d -> %d\n",
+			r.burstCount, r.legacyUsPerSpawn, r.flyweightUsPerSpawn,
+			r.legacyBytesPerScrap, r.flyweightBytesPerScrap,
+			r.legacyTextureLoads, r.flyweightTextureLoads);
+	}
+}
+
+std::vector<ScrapBenchmark::CollisionResult> ScrapBenchmark::RunCollisionBenchmark(int frames) {
+	const int kHeldCounts[] = { 10, 50, 100, 250, 500, 1000, 2000 };
+
+	if (frames < 1) frames = 1;
+
+	// 旧 ResolveCollisions の本体（組ごとに平方根を取る全組み合わせ）
+	auto resolveAllPairs = [](const std::vector<Scrap*>& activeScraps) {
+		const int iterations = 3;
+		for (int iter = 0; iter < iterations; ++iter) {
+			for (size_t i = 0; i < activeScraps.size(); ++i) {
+				for (size_t j = i + 1; j < activeScraps.size(); ++j) {
+					Scrap* a = activeScraps[i];
+					Scrap* b = activeScraps[j];
+					if (a->GetState() == ScrapState::BeingSucked && b->GetState() == ScrapState::BeingSucked) {
+						continue;
+					}
+
+					Vector2 diff = { b->GetPosition().x - a->GetPosition().x, b->GetPosition().y - a->GetPosition().y };
+					float distance = std::sqrt(diff.x * diff.x + diff.y * diff.y);
+					float minDistance = a->GetCollisionRadius() + b->GetCollisionRadius();
+					if (distance < minDistance && distance > 0.01f) {
+						ScrapManager::ResolveCollisionPair(*a, *b);
+					}
+				}
+			}
+		}
+	};
+
+	std::vector<CollisionResult> results;
+	ScrapManager manager;
+
+	for (int count : kHeldCounts) {
+		std::vector<ScrapState> states;
+		std::vector<Scrap> initial = MakeHeldCluster(count, states);
+		for (int i = 0; i < count; ++i) {
+			initial[i].SetState(states[i]);
+		}
+
+		std::vector<Scrap> work;
+		std::vector<Scrap*> pointers(count);
+		auto reset = [&]() {
+			work = initial;
+			for (int i = 0; i < count; ++i) {
+				pointers[i] = &work[i];
+			}
+		};
+
+		// 毎フレーム同じ配置に戻し、解決の時間だけを足す
+		auto measureMs = [&](auto&& resolve) {
+			double totalMs = 0.0;
+			for (int f = 0; f < frames; ++f) {
+				reset();
+				auto start = std::chrono::high_resolution_clock::now();
+				resolve(pointers);
+				auto end = std::chrono::high_resolution_clock::now();
+				totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+			}
+			return totalMs / frames;
+		};
+
+		CollisionResult result;
+		result.heldCount = count;
+		result.allPairsMs = measureMs(resolveAllPairs);
+		const std::vector<Scrap> allPairsState = work;
+		result.gridMs = measureMs([&](const std::vector<Scrap*>& scraps) { manager.ResolveCollisionsInGrid(scraps); });
+
+		result.allPairsOverlap = SumOverlap(allPairsState);
+		result.gridOverlap = SumOverlap(work);
+
+		results.push_back(result);
+	}
+	return results;
+}
+
+void ScrapBenchmark::PrintCollisionResults(const std::vector<CollisionResult>& results) {
+	Novice::ConsolePrintf("=== Scrap Collision Benchmark (ms/frame) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("%5d: AllPairs %.3f / Grid %.3f  overlap %.1f / %.1f px\n",
+			r.heldCount, r.allPairsMs, r.gridMs, r.allPairsOverlap, r.gridOverlap);
+	}
+}
+
+std::vector<ScrapBenchmark::PlacementResult> ScrapBenchmark::RunPlacementBenchmark() {
+	const int kSpawnCounts[] = { 50, 200, 500, 1000, 2000 };
+	const int kFieldCount = 100;
+	const Vector2 center{ 640.0f, 360.0f };
+	const float maxRadius = 300.0f;
+	const float searchRadius = maxRadius * 0.3f;
+	const float gap = 4.0f;  // ScrapManager::kMinSpawnDistance
+	const float radius = Scrap::GetTypeRadius(ScrapType::Medium);
+	const ScrapType kTypes[] = { ScrapType::Small, ScrapType::Medium, ScrapType::Large };
+
+	// フィールドに出ているスクラップ（旧方式はこれを見ない）
+	std::vector<Vector2> fieldPositions;
+	std::vector<float> fieldRadii;
+	FastRandom fieldRandom(54321);
+	for (int i = 0; i < kFieldCount; ++i) {
+		fieldPositions.push_back({ fieldRandom.RandomFloat(0.0f, 1280.0f), fieldRandom.RandomFloat(0.0f, 720.0f) });
+		fieldRadii.push_back(Scrap::GetTypeRadius(kTypes[i % 3]));
+	}
+
+	// 希望の位置（SpawnScrapRandom と同じく、中心からの角度と距離を一様に選ぶ）
+	auto makeDesired = [&](int count) {
+		FastRandom random(12345);
+		std::vector<Vector2> desired(count);
+		for (auto& p : desired) {
+			const float angle = random.RandomFloat(0.0f, 2.0f * 3.14159265f);
+			const float r = random.RandomFloat(0.0f, maxRadius);
+			p = { center.x + std::cos(angle) * r, center.y + std::sin(angle) * r };
+		}
+		return desired;
+	};
+
+	std::vector<PlacementResult> results;
+	for (int count : kSpawnCounts) {
+		const std::vector<Vector2> desired = makeDesired(count);
+		PlacementResult result;
+		result.spawnCount = count;
+
+		// 旧方式
+		std::vector<Vector2> legacyPositions;
+		{
+			FastRandom random(777);
+			std::vector<float> radii;
+			auto start = std::chrono::high_resolution_clock::now();
+			for (const Vector2& base : desired) {
+				Vector2 placed = base;
+				for (int attempt = 0; attempt < 30; ++attempt) {
+					Vector2 candidate = base;
+					if (attempt > 0) {
+						const float angle = random.RandomFloat(0.0f, 2.0f * 3.14159265f);
+						const float dist = random.RandomFloat(0.0f, searchRadius);
+						candidate.x += std::cos(angle) * dist;
+						candidate.y += std::sin(angle) * dist;
+					}
+
+					bool overlapping = false;
+					for (size_t i = 0; i < legacyPositions.size(); ++i) {
+						const Vector2 diff = { candidate.x - legacyPositions[i].x, candidate.y - legacyPositions[i].y };
+						if (std::sqrt(diff.x * diff.x + diff.y * diff.y) < radius + radii[i] + gap) {
+							overlapping = true;
+							break;
+						}
+					}
+					if (!overlapping) {
+						placed = candidate;
+						break;
+					}
+				}
+				legacyPositions.push_back(placed);
+				radii.push_back(radius);
+			}
+			auto end = std::chrono::high_resolution_clock::now();
+			result.legacyMs = std::chrono::duration<double, std::milli>(end - start).count();
+		}
+
+		// ScrapSpawnPlacer
+		std::vector<Vector2> placerPositions;
+		{
+			FastRandom random(777);
+			ScrapSpawnPlacer placer;
+			auto start = std::chrono::high_resolution_clock::now();
+			placer.Begin(center, maxRadius + searchRadius, Scrap::GetTypeRadius(ScrapType::Large), gap, count);
+			for (int i = 0; i < kFieldCount; ++i) {
+				placer.AddObstacle(fieldPositions[i], fieldRadii[i]);
+			}
+			for (const Vector2& base : desired) {
+				placerPositions.push_back(placer.Place(base, radius, searchRadius, random));
+			}
+			auto end = std::chrono::high_resolution_clock::now();
+			result.placerMs = std::chrono::duration<double, std::milli>(end - start).count();
+		}
+
+		// フィールドのスクラップも含めて重なりを数える
+		auto countWithField = [&](const std::vector<Vector2>& placed) {
+			std::vector<Vector2> positions = fieldPositions;
+			std::vector<float> radii = fieldRadii;
+			positions.insert(positions.end(), placed.begin(), placed.end());
+			radii.insert(radii.end(), placed.size(), radius);
+			return CountOverlaps(positions, radii, gap) - CountOverlaps(fieldPositions, fieldRadii, gap);
+		};
+		result.legacyOverlaps = countWithField(legacyPositions);
+		result.placerOverlaps = countWithField(placerPositions);
+
+		results.push_back(result);
+	}
+	return results;
+}
+
+void ScrapBenchmark::PrintPlacementResults(const std::vector<PlacementResult>& results) {
+	Novice::ConsolePrintf("=== Scrap Spawn Placement Benchmark (ms/spawn call) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("%5d: Legacy %.3f / Placer %.3f  overlaps %d / %d\n",
+			r.spawnCount, r.legacyMs, r.placerMs, r.legacyOverlaps, r.placerOverlaps);
+	}
+}
+
+std::vector<ScrapBenchmark::ArenaResult> ScrapBenchmark::RunArenaBenchmark(int frames) {
+	const float dt = 1.0f / 60.0f;
+	const int kSettleFrames = 60;
+	const Vector2 kFarVaccum{ -10000.0f, -10000.0f };  // 吸引はしない
+	const Vector2 kBurstCenters[] = {
+		{ 200.0f, 150.0f }, { 640.0f, 150.0f }, { 1080.0f, 150.0f },
+		{ 200.0f, 570.0f }, { 640.0f, 570.0f }, { 1080.0f, 570.0f },
+	};
+
+	if (frames < 1) frames = 1;
+	const bool previousSleepEnabled = Scrap::IsSleepEnabled();
+
+	std::vector<ArenaResult> results;
+	for (bool sleepEnabled : { false, true }) {
+		Scrap::SetSleepEnabled(sleepEnabled);
+
+		ScrapManager manager;
+		manager.SetRandomSeed(12345);
+		for (const Vector2& center : kBurstCenters) {
+			manager.SpawnScrapExplosion(center, 84, ScrapType::Small, 200.0f);  // 6 × 84 = 504（500 で止まる）
+		}
+
+		for (int f = 0; f < kSettleFrames; ++f) {
+			manager.Update(dt, kFarVaccum, false);
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int f = 0; f < frames; ++f) {
+			manager.Update(dt, kFarVaccum, false);
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+
+		ArenaResult result;
+		result.sleepEnabled = sleepEnabled;
+		result.updateMs = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+		result.activeCount = manager.GetActiveScrapsCount();
+		result.sleepingCount = manager.GetSleepingScrapsCount();
+		result.awakeCount = manager.GetAwakeScrapsCount();
+		results.push_back(result);
+	}
+
+	Scrap::SetSleepEnabled(previousSleepEnabled);
+	return results;
+}
+
+void ScrapBenchmark::PrintArenaResults(const std::vector<ArenaResult>& results) {
+	Novice::ConsolePrintf("=== Scrap Arena Benchmark (ms/frame) ===\n");
+	for (const auto& r : results) {
+		Novice::ConsolePrintf("Sleep %-3s: Update %.4f  active %d (sleeping %d / awake %d)\n",
+			r.sleepEnabled ? "on" : "off", r.updateMs, r.activeCount, r.sleepingCount, r.awakeCount);
+	}
+}
+
+ScrapBenchmark::CheckResult ScrapBenchmark::RunStateSetCheck(int frames) {
+	const float dt = 1.0f / 60.0f;
+	constexpr int kStateCount = static_cast<int>(ScrapState::Hit) + 1;
+
+	ScrapManager manager;
+	manager.SetRandomSeed(7);
+	CheckResult result;
+
+	auto compare = [&]() {
+		int scanned[kStateCount] = {};
+		int active = 0;
+		for (Scrap& scrap : manager.GetScraps()) {
+			if (!scrap.IsActive()) continue;
+			++active;
+			++scanned[static_cast<int>(scrap.GetState())];
+		}
+		for (int i = 0; i < kStateCount; ++i) {
+			++result.checks;
+			if (scanned[i] != manager.GetStateCount(static_cast<ScrapState>(i))) ++result.mismatches;
+		}
+		++result.checks;
+		if (active != manager.GetActiveScrapsCount()) ++result.mismatches;
+	};
+
+	for (int f = 0; f < frames; ++f) {
+		if (f % 50 == 0) {
+			const Vector2 center{ 200.0f + static_cast<float>((f * 37) % 900), 100.0f + static_cast<float>((f * 53) % 500) };
+			manager.SpawnScrapRandom(center, 40, 10.0f, 200.0f, static_cast<ScrapType>(f % 3));
+		}
+
+		// 300 フレーム周期：200 フレーム吸って、発射して、吸いかけを放す
+		const bool isSucking = (f % 300) < 200;
+		const Vector2 vaccum{ 640.0f + 200.0f * std::cos(f * 0.01f), 360.0f + 150.0f * std::sin(f * 0.013f) };
+		if (isSucking) {
+			manager.ProcessSuction(vaccum, 250.0f, manager.GetHeldWeight(), 200.0f);
+		}
+		else if (f % 300 == 200) {
+			manager.FireAllHeldScraps({ 1.0f, 0.0f }, 600.0f, 30.0f);
+		}
+		else if (f % 300 == 201) {
+			manager.ReleaseBeingSuckedScraps();
+		}
+		manager.Update(dt, vaccum, isSucking);
+		compare();
+
+		// 敵に当たった扱いの遷移も混ぜる
+		if (f % 97 == 0) {
+			for (Scrap& scrap : manager.GetScraps()) {
+				if (scrap.GetState() == ScrapState::Fired) {
+					manager.SetScrapState(scrap, ScrapState::Hit);
+					break;
+				}
+			}
+		}
+		++result.frames;
+	}
+
+	manager.ClearAll();
+	compare();
+	return result;
+}
+
+ScrapBenchmark::CheckResult ScrapBenchmark::RunSuctionCheck(int frames) {
+	const float dt = 1.0f / 60.0f;
+	const float kVaccumRadius = 250.0f;
+
+	ScrapManager manager;
+	manager.SetRandomSeed(11);
+	CheckResult result;
+
+	// 吸う前の Free のスクラップと、吸引範囲に入っているか（全走査で求める）
+	std::vector<std::pair<const Scrap*, bool>> expected;
+
+	for (int f = 0; f < frames; ++f) {
+		if (f % 40 == 0) {
+			const Vector2 center{ 100.0f + static_cast<float>((f * 37) % 1100), 80.0f + static_cast<float>((f * 53) % 560) };
+			manager.SpawnScrapRandom(center, 30, 10.0f, 250.0f, static_cast<ScrapType>(f % 3));
+		}
+		manager.SpawnBossScrapMove(true, { 640.0f + 300.0f * std::sin(f * 0.02f), 360.0f }, 160.0f, 10, 3, 80.0f);
+
+		const bool isSucking = (f % 300) < 200;
+		const Vector2 vaccum{ 640.0f + 300.0f * std::cos(f * 0.01f), 360.0f + 200.0f * std::sin(f * 0.013f) };
+		if (isSucking) {
+			expected.clear();
+			for (Scrap& scrap : manager.GetScraps()) {
+				if (!scrap.IsActive() || scrap.GetState() != ScrapState::Free) continue;
+				const Vector2 diff = vaccum - scrap.GetPosition();
+				expected.push_back({ &scrap, std::sqrt(diff.x * diff.x + diff.y * diff.y) <= kVaccumRadius });
+			}
+
+			// 重さの上限は十分大きくして、範囲内は全て吸う
+			manager.ProcessSuction(vaccum, kVaccumRadius, manager.GetHeldWeight(), 1000.0f);
+
+			for (const auto& [scrap, inRange] : expected) {
+				++result.checks;
+				const ScrapState expectedState = inRange ? ScrapState::BeingSucked : ScrapState::Free;
+				if (scrap->GetState() != expectedState) ++result.mismatches;
+			}
+		}
+		else if (f % 300 == 200) {
+			manager.FireAllHeldScraps({ 1.0f, 0.0f }, 600.0f, 30.0f);
+		}
+		else if (f % 300 == 201) {
+			manager.ReleaseBeingSuckedScraps();
+		}
+		manager.Update(dt, vaccum, isSucking);
+
+		++result.checks;
+		if (manager.freeGrid_.GetCount() != manager.GetFreeScrapsCount()) ++result.mismatches;
+		++result.frames;
+	}
+	return result;
+}
+
+void ScrapBenchmark::PrintCheckResult(const char* name, const CheckResult& result) {
+	Novice::ConsolePrintf("=== Scrap %s Check ===\n%d frames  %d checks  %d mismatches [%s]\n",
+		name, result.frames, result.checks, result.mismatches, result.mismatches == 0 ? "OK" : "MISMATCH");
+}
@@ -0,0 +1,98 @@
+﻿#pragma once
+#include <vector>
+
+/// <summary>
+/// スクラップのベンチマーク
+/// デバッグウィンドウの「Scrap Benchmark」から実行する（描画は行わない）
+/// </summary>
+class ScrapBenchmark {
+public:
+	struct SpawnBurstResult {
+		int burstCount = 0;             // 1回のバーストで生成する数
+		double legacyUsPerSpawn = 0.0;  // 旧方式（生成ごとに LoadTexture ×2 と DrawComponent2D ×2）
+		double flyweightUsPerSpawn = 0.0; // ScrapManager::SpawnScrap（ScrapRenderDesc を共有）
+		int legacyBytesPerScrap = 0;    // 旧 Scrap 1個ぶん（DrawComponent2D と Animation を含む）
+		int flyweightBytesPerScrap = 0; // sizeof(Scrap)
+		int legacyTextureLoads = 0;     // バースト1回で呼んだ LoadTexture の回数
+		int flyweightTextureLoads = 0;
+	};
+
+	/// <summary>
+	/// 50 / 200 / 500 個のバーストを旧方式と共有方式で生成し、1個あたりの時間・メモリ・テクスチャ読み込み回数を比べる
+	/// </summary>
+	/// <param name="repeats">バーストを繰り返す回数（時間はその平均）</param>
+	static std::vector<SpawnBurstResult> RunSpawnBurstBenchmark(int repeats = 20);
+
+	static void PrintSpawnBurstResults(const std::vector<SpawnBurstResult>& results);
+
+	struct CollisionResult {
+		int heldCount = 0;
+		double allPairsMs = 0.0;     // 旧 ResolveCollisions（全組み合わせ、組ごとに sqrt）
+		double gridMs = 0.0;         // ScrapManager::ResolveCollisionsInGrid
+		// 1フレーム解決した後に残った重なりの合計（px）。押し出しの順が違うので値は一致しないが、同じくらいに収まること
+		float allPairsOverlap = 0.0f;
+		float gridOverlap = 0.0f;
+	};
+
+	/// <summary>
+	/// 保持数 10〜2000 個で、吸引中・保持中の衝突解決（3回反復）を全組み合わせ版とグリッド版で比べる
+	/// スクラップはプールを使わず自前の配列に並べる（kMaxScraps を超える数も測るため）
+	/// </summary>
+	/// <param name="frames">計測フレーム数（毎フレーム同じ初期配置から解決する）</param>
+	static std::vector<CollisionResult> RunCollisionBenchmark(int frames = 20);
+
+	static void PrintCollisionResults(const std::vector<CollisionResult>& results);
+
+	struct PlacementResult {
+		int spawnCount = 0;
+		double legacyMs = 0.0;       // 旧 FindNonOverlappingPosition（30回試行、置いた数に比例する重なり判定）
+		double placerMs = 0.0;       // ScrapSpawnPlacer（グリッド + Bridson）
+		int legacyOverlaps = 0;      // 重なった組の数（フィールドに出ていたスクラップとの組も含む）
+		int placerOverlaps = 0;
+	};
+
+	/// <summary>
+	/// フィールドに 100 個出ている状態で 50〜2000 個をランダム生成（SpawnScrapRandom と同じ置き方）し、
+	/// 位置決めにかかる時間と重なりの数を比べる
+	/// </summary>
+	static std::vector<PlacementResult> RunPlacementBenchmark();
+
+	static void PrintPlacementResults(const std::vector<PlacementResult>& results);
+
+	struct ArenaResult {
+		bool sleepEnabled = false;
+		double updateMs = 0.0;     // ScrapManager::Update（落ち着いた後の1フレーム平均）
+		int activeCount = 0;
+		int sleepingCount = 0;     // 計測終了時点
+		int awakeCount = 0;
+	};
+
+	/// <summary>
+	/// 爆発生成でスクラップを撒き散らした場（プールいっぱいの 500 個）を、眠り状態なし・ありで更新して比べる
+	/// Scrap::SetSleepEnabled は元に戻す
+	/// </summary>
+	/// <param name="frames">計測フレーム数（撒いてから落ち着くまでの 60 フレームは含めない）</param>
+	static std::vector<ArenaResult> RunArenaBenchmark(int frames = 240);
+
+	static void PrintArenaResults(const std::vector<ArenaResult>& results);
+
+	struct CheckResult {
+		int frames = 0;
+		int checks = 0;       // 比べた回数
+		int mismatches = 0;   // 食い違った回数（0 であること）
+	};
+
+	/// <summary>
+	/// 生成・吸引・発射・解放を決まった手順で繰り返し、毎フレーム状態ごとの数（ScrapStateSets）と
+	/// 全スクラップを走査して数えた値が一致するか確かめる
+	/// </summary>
+	static CheckResult RunStateSetCheck(int frames = 2000);
+
+	/// <summary>
+	/// 生成・ボスの移動生成・吸引・発射・解放を繰り返し、ProcessSuction が吸い始めたスクラップが
+	/// 全スクラップを走査して求めた範囲内の Free のスクラップと一致するか、Free グリッドの数が Free の数と一致するか確かめる
+	/// </summary>
+	static CheckResult RunSuctionCheck(int frames = 3000);
+
+	static void PrintCheckResult(const char* name, const CheckResult& result);
+};
@@ -0,0 +1,66 @@
+﻿#include "ScrapCollisionGrid.h"
+#include <algorithm>
+
+#ifdef max
+#undef max
+#endif
+
+#ifdef min
+#undef min
+#endif
+
+int ScrapCollisionGrid::CellX(float x) const {
+	return std::clamp(static_cast<int>((x - gridMinX_) * invCellSize_), 0, gridWidth_ - 1);
+}
+
+int ScrapCollisionGrid::CellY(float y) const {
+	return std::clamp(static_cast<int>((y - gridMinY_) * invCellSize_), 0, gridHeight_ - 1);
+}
+
+void ScrapCollisionGrid::Build(const std::vector<Vector2>& positions, float cellSize) {
+	gridWidth_ = 0;
+	gridHeight_ = 0;
+	cellEntries_.clear();
+	if (positions.empty()) return;
+
+	// 1. 全点の外接矩形
+	float minX = positions[0].x, minY = positions[0].y;
+	float maxX = minX, maxY = minY;
+	for (const Vector2& p : positions) {
+		minX = std::min(minX, p.x);
+		minY = std::min(minY, p.y);
+		maxX = std::max(maxX, p.x);
+		maxY = std::max(maxY, p.y);
+	}
+
+	// 2. セル数が上限を超えるならセルを大きくする（大きくする分には取りこぼさない）
+	cellSize = std::max(1.0f, cellSize);
+	const float extent = std::max(maxX - minX, maxY - minY);
+	cellSize = std::max(cellSize, extent / static_cast<float>(kMaxGridCells));
+	cellSize_ = cellSize;
+	invCellSize_ = 1.0f / cellSize;
+	gridMinX_ = minX;
+	gridMinY_ = minY;
+	gridWidth_ = std::clamp(static_cast<int>((maxX - minX) * invCellSize_) + 1, 1, kMaxGridCells);
+	gridHeight_ = std::clamp(static_cast<int>((maxY - minY) * invCellSize_) + 1, 1, kMaxGridCells);
+
+	// 3. 数えて先頭位置を決め、詰めて書き込む（番号順を保つ）
+	const int count = static_cast<int>(positions.size());
+	const int cellCount = gridWidth_ * gridHeight_;
+	cellStart_.assign(cellCount + 1, 0);
+	entryCell_.resize(count);
+	for (int i = 0; i < count; ++i) {
+		const int cell = CellY(positions[i].y) * gridWidth_ + CellX(positions[i].x);
+		entryCell_[i] = cell;
+		cellStart_[cell + 1]++;
+	}
+	for (int c = 0; c < cellCount; ++c) {
+		cellStart_[c + 1] += cellStart_[c];
+	}
+
+	cellEntries_.resize(count);
+	cursor_.assign(cellStart_.begin(), cellStart_.end() - 1);
+	for (int i = 0; i < count; ++i) {
+		cellEntries_[cursor_[entryCell_[i]]++] = i;
+	}
+}
@@ -0,0 +1,79 @@
+﻿#pragma once
+#include "Vector2.h"
+#include <vector>
+
+/// <summary>
+/// スクラップ同士の当たり判定の広域判定用の一様グリッド
+/// セルの一辺を「2つの当たり判定半径の和の最大値」以上にしておけば、
+/// 重なりうる相手は自分のセルと周囲8セルにしかいない。
+/// バッファは使い回すので、毎フレーム Build し直しても確保は最初の数回だけ
+/// </summary>
+class ScrapCollisionGrid {
+public:
+	// グリッドの1辺の最大セル数（散らばりすぎたときはセルを大きくして収める）
+	static constexpr int kMaxGridCells = 128;
+
+	/// <summary>
+	/// positions[i] を i 番としてグリッドに登録し直す（セル内は番号の小さい順）
+	/// </summary>
+	/// <param name="positions">登録する位置</param>
+	/// <param name="cellSize">セルの一辺（当たり判定半径の最大値 × 2 以上）</param>
+	void Build(const std::vector<Vector2>& positions, float cellSize);
+
+	/// <summary>
+	/// 同じセルか隣り合うセルにいる組 (i, j) を1回ずつ func に渡す
+	/// セルは左下から行ごとに回り、隣は右・左上・上・右上の4方向だけ見る（反対側は相手のセルから見る）
+	/// </summary>
+	template <typename Func>
+	void ForEachNearPair(Func&& func) const {
+		for (int y = 0; y < gridHeight_; ++y) {
+			for (int x = 0; x < gridWidth_; ++x) {
+				const int cell = y * gridWidth_ + x;
+				const int begin = cellStart_[cell];
+				const int end = cellStart_[cell + 1];
+				if (begin == end) continue;
+
+				// セルの中の組
+				for (int a = begin; a < end; ++a) {
+					for (int b = a + 1; b < end; ++b) {
+						func(cellEntries_[a], cellEntries_[b]);
+					}
+				}
+
+				// 隣のセルとの組
+				const int kOffsets[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+				for (const auto& offset : kOffsets) {
+					const int nx = x + offset[0];
+					const int ny = y + offset[1];
+					if (nx < 0 || nx >= gridWidth_ || ny >= gridHeight_) continue;
+
+					const int neighbor = ny * gridWidth_ + nx;
+					for (int a = begin; a < end; ++a) {
+						for (int b = cellStart_[neighbor]; b < cellStart_[neighbor + 1]; ++b) {
+							func(cellEntries_[a], cellEntries_[b]);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	float GetCellSize() const { return cellSize_; }
+	int GetGridWidth() const { return gridWidth_; }
+	int GetGridHeight() const { return gridHeight_; }
+
+private:
+	int CellX(float x) const;
+	int CellY(float y) const;
+
+	float cellSize_ = 1.0f;
+	float invCellSize_ = 1.0f;
+	float gridMinX_ = 0.0f;
+	float gridMinY_ = 0.0f;
+	int gridWidth_ = 0;
+	int gridHeight_ = 0;
+	std::vector<int> cellStart_;    // セル c の番号は cellEntries_[cellStart_[c], cellStart_[c + 1])
+	std::vector<int> cellEntries_;
+	std::vector<int> entryCell_;    // 番号ごとのセル（詰めるときに計算し直さないため）
+	std::vector<int> cursor_;
+};
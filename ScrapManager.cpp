@@ -1,4 +1,5 @@
 ﻿#include "ScrapManager.h"
+#include <Novice.h>
 #include <cmath>
 #include <algorithm>
 #include <chrono>
@@ -12,33 +13,70 @@
 #endif
 
 ScrapManager::ScrapManager() {
-	auto seed = static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count());
-	randomEngine_.seed(seed);
+	stateSets_.Resize(scraps_.GetCapacity());
+	freeGrid_.Initialize({ -kOutOfBoundsMargin, -kOutOfBoundsMargin },
+		{ kFieldWidth + kOutOfBoundsMargin, kFieldHeight + kOutOfBoundsMargin },
+		kFreeGridCellSize, scraps_.GetCapacity());
+
+	// 既定では起動ごとに変える（計測や再現が必要なときは SetRandomSeed で固定する）
+	auto seed = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+	randomEngine_.Seed(seed);
+}
+
+void ScrapManager::SetRandomSeed(uint64_t seed) {
+	randomEngine_.Seed(seed);
 }
 
 void ScrapManager::Initialize() {
-	scraps_.clear();
-	scraps_.reserve(kMaxScraps);
+	scraps_.Clear();
+	stateSets_.Clear();
+	freeGrid_.Clear();
 	heldWeight_ = 0.0f;
 	heldCount_ = 0;
 }
 
 void ScrapManager::Update(float dt, const Vector2& vaccumPos, bool isSucking) {
+	// 起きているスクラップだけを更新する（眠っている Free は集合が別なので触らない）
+	// 眠ると Free の集合から外れて末尾の番号が今の位置に入るので、末尾から回す
+	const ScrapState kUpdatedStates[] = {
+		ScrapState::Free, ScrapState::BeingSucked, ScrapState::Held, ScrapState::Fired, ScrapState::Hit
+	};
+	for (ScrapState state : kUpdatedStates) {
+		const std::vector<uint32_t>& slots = stateSets_.Get(state);
+		for (size_t i = slots.size(); i > 0; --i) {
+			const uint32_t slot = slots[i - 1];
+			Scrap& scrap = scraps_.At(slot);
+			if (!scrap.IsActive()) {
+				continue;
+			}
 
-	// 保持中のスクラップ数と重量を計算
-	heldWeight_ = 0.0f;
-	heldCount_ = 0;
+			scrap.Update(dt);
 
-	for (auto& scrap : scraps_) {
-		if (!scrap->IsActive()) {
-			continue;
+			// 眠ったら最後の位置をグリッドに残して、眠っている集合へ移す
+			if (scrap.IsSleeping()) {
+				freeGrid_.Relocate(slot, scrap.GetPosition());
+				stateSets_.SetSleeping(slot, true);
+			}
 		}
+	}
 
-		scrap->Update(dt);
+	// 動いた Free のスクラップをグリッド上でも動かす（止まっているものは位置が変わらないので飛ばす）
+	for (uint32_t slot : stateSets_.Get(ScrapState::Free)) {
+		const Scrap& scrap = scraps_.At(slot);
+		const Vector2 velocity = scrap.GetVelocity();
+		if (velocity.x != 0.0f || velocity.y != 0.0f) {
+			freeGrid_.Relocate(slot, scrap.GetPosition());
+		}
+	}
+
+	// 保持中のスクラップ数と重量を計算（保持中の集合だけを見る）
+	heldWeight_ = 0.0f;
+	heldCount_ = 0;
 
-		// 保持中のスクラップを集計
-		if (scrap->GetState() == ScrapState::Held) {
-			heldWeight_ += scrap->GetWeight();
+	for (uint32_t slot : stateSets_.Get(ScrapState::Held)) {
+		const Scrap& scrap = scraps_.At(slot);
+		if (scrap.IsActive()) {
+			heldWeight_ += scrap.GetWeight();
 			heldCount_++;
 		}
 	}
@@ -54,13 +92,13 @@ void ScrapManager::Update(float dt, const Vector2& vaccumPos, bool isSucking) {
 	}
 
 	// 画面外のスクラップを削除
-	RemoveOutOfBoundsScraps({ 1280.0f, 720.0f }, kOutOfBoundsMargin);
+	RemoveOutOfBoundsScraps({ kFieldWidth, kFieldHeight }, kOutOfBoundsMargin);
 }
 
 void ScrapManager::Draw(const Vector2& scrollOffset) {
 	for (auto& scrap : scraps_) {
-		if (scrap->IsActive()) {
-			scrap->Draw(scrollOffset);
+		if (scrap.IsActive()) {
+			scrap.Draw(scrollOffset);
 		}
 	}
 }
@@ -70,49 +108,82 @@ void ScrapManager::Draw(const Vector2& scrollOffset) {
 // ========================================
 
 Scrap* ScrapManager::CreateScrap(ScrapType type, ScrapTrait trait, const Vector2& position, const Vector2& velocity) {
-	if (scraps_.size() >= kMaxScraps) {
+	// 空きスロットを使う（満杯なら生成しない）
+	const ScrapHandle handle = scraps_.Create();
+	Scrap* scrap = scraps_.Get(handle);
+	if (scrap == nullptr) {
 		return nullptr;
 	}
 
-	auto scrap = std::make_unique<Scrap>();
+	// Initialize で自由状態になるので Free の集合に入れる
 	scrap->Initialize(type, trait, position, velocity);
+	stateSets_.Insert(handle.index, ScrapState::Free);
+	freeGrid_.Insert(handle.index, position);
+	return scrap;
+}
+
+void ScrapManager::SetScrapState(Scrap& scrap, ScrapState state) {
+	const ScrapHandle handle = scraps_.GetHandle(&scrap);
+	if (!handle.IsValid()) {
+		return;
+	}
+	SetScrapState(handle.index, state);
+}
+
+void ScrapManager::SetScrapState(uint32_t slot, ScrapState state) {
+	Scrap& scrap = scraps_.At(slot);
+
+	// 状態が変わるときは必ず起こす（眠っている集合からは Move で外れる）
+	scrap.WakeUp();
 
-	Scrap* ptr = scrap.get();
-	scraps_.push_back(std::move(scrap));
+	// Free のグリッドは Free に入るとき・出るときだけ書き換える
+	if (state == ScrapState::Free) {
+		freeGrid_.Insert(slot, scrap.GetPosition());
+	}
+	else {
+		freeGrid_.Erase(slot);
+	}
 
-	return ptr;
+	scrap.SetState(state);
+	stateSets_.Move(slot, state);
 }
 
-// 指定位置にスクラップを生成（ボスの供給ポイント用）
-void ScrapManager::SpawnScrap(ScrapType type, const Vector2& position, const Vector2& initialVelocity) {
-	// 非アクティブなスクラップを探す
-	for (auto& scrap : scraps_) {
-		if (!scrap->IsActive()) {
-			// スクラップを初期化して使用
-			scrap->Initialize(type, ScrapTrait::Normal, position, initialVelocity);
-			scrap->SetState(ScrapState::Free);  // 自由落下状態で生成
-			return;
+void ScrapManager::WakeScrap(Scrap& scrap) {
+	if (!scrap.IsSleeping()) {
+		return;
+	}
+	const ScrapHandle handle = scraps_.GetHandle(&scrap);
+	if (!handle.IsValid()) {
+		return;
+	}
+	scrap.WakeUp();
+	stateSets_.SetSleeping(handle.index, false);
+}
+
+void ScrapManager::WakeScrapsInRadius(const Vector2& center, float radius) {
+	gridQueryResult_.clear();
+	freeGrid_.QueryCircle(center, radius, gridQueryResult_);
+
+	for (uint32_t slot : gridQueryResult_) {
+		Scrap& scrap = scraps_.At(slot);
+		if (!scrap.IsActive() || !scrap.IsSleeping()) {
+			continue;
 		}
+		scrap.WakeUp();
+		stateSets_.SetSleeping(slot, false);
 	}
+}
 
-	// 全て使用中の場合は新規作成
-	auto newScrap = std::make_unique<Scrap>();
-	newScrap->Initialize(type, ScrapTrait::Normal, position, initialVelocity);
-	newScrap->SetState(ScrapState::Free);
-	scraps_.push_back(std::move(newScrap));
+// 指定位置にスクラップを生成（ボスの供給ポイント用）
+void ScrapManager::SpawnScrap(ScrapType type, const Vector2& position, const Vector2& initialVelocity) {
+	// 空きスロットはプールが持っているので探さない（Initialize で自由落下状態になる）
+	CreateScrap(type, ScrapTrait::Normal, position, initialVelocity);
 }
 
 // 円形にスクラップを生成
 void ScrapManager::SpawnScrapCircle(const Vector2& center, int count, float radius, ScrapType type, float spreadSpeed) {
-	std::vector<Vector2> positions;
-	std::vector<float> radii;
-
-	float scrapRadius = 16.0f;
-	switch (type) {
-	case ScrapType::Small:  scrapRadius = 16.0f; break;
-	case ScrapType::Medium: scrapRadius = 24.0f; break;
-	case ScrapType::Large:  scrapRadius = 32.0f; break;
-	}
+	const float scrapRadius = Scrap::GetTypeRadius(type);
+	BeginSpawnPlacement(center, radius * 1.5f, count);
 
 	for (int i = 0; i < count; ++i) {
 		float angle = (2.0f * 3.14159265f * i) / count;
@@ -121,7 +192,7 @@ void ScrapManager::SpawnScrapCircle(const Vector2& center, int count, float radi
 			center.y + std::sin(angle) * radius
 		};
 
-		position = FindNonOverlappingPosition(position, scrapRadius, radius * 0.5f, positions, radii);
+		position = spawnPlacer_.Place(position, scrapRadius, radius * 0.5f, randomEngine_);
 
 		Vector2 direction = {
 			std::cos(angle),
@@ -132,26 +203,20 @@ void ScrapManager::SpawnScrapCircle(const Vector2& center, int count, float radi
 			direction.y * spreadSpeed
 		};
 
-		CreateScrap(type, ScrapTrait::Normal, position, velocity);
-		positions.push_back(position);
-		radii.push_back(scrapRadius);
+		// プールが満杯になったら残りは置かない
+		if (CreateScrap(type, ScrapTrait::Normal, position, velocity) == nullptr) {
+			break;
+		}
 	}
 }
 
 // ランダム位置にスクラップを生成
 void ScrapManager::SpawnScrapRandom(const Vector2& center, int count, float minRadius, float maxRadius, ScrapType type) {
-	std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159265f);
-	std::uniform_real_distribution<float> radiusDist(minRadius, maxRadius);
+	FastRandom::FloatDistribution angleDist(0.0f, 2.0f * 3.14159265f);
+	FastRandom::FloatDistribution radiusDist(minRadius, maxRadius);
 
-	std::vector<Vector2> positions;
-	std::vector<float> radii;
-
-	float scrapRadius = 16.0f;
-	switch (type) {
-	case ScrapType::Small:  scrapRadius = 16.0f; break;
-	case ScrapType::Medium: scrapRadius = 24.0f; break;
-	case ScrapType::Large:  scrapRadius = 32.0f; break;
-	}
+	const float scrapRadius = Scrap::GetTypeRadius(type);
+	BeginSpawnPlacement(center, maxRadius * 1.3f, count);
 
 	for (int i = 0; i < count; ++i) {
 		float angle = angleDist(randomEngine_);
@@ -162,18 +227,21 @@ void ScrapManager::SpawnScrapRandom(const Vector2& center, int count, float minR
 			center.y + std::sin(angle) * r
 		};
 
-		position = FindNonOverlappingPosition(position, scrapRadius, maxRadius * 0.3f, positions, radii);
+		position = spawnPlacer_.Place(position, scrapRadius, maxRadius * 0.3f, randomEngine_);
 
-		CreateScrap(type, ScrapTrait::Normal, position, { 0.0f, 0.0f });
-		positions.push_back(position);
-		radii.push_back(scrapRadius);
+		if (CreateScrap(type, ScrapTrait::Normal, position, { 0.0f, 0.0f }) == nullptr) {
+			break;
+		}
 	}
 }
 
 // 爆発的にスクラップを生成
 void ScrapManager::SpawnScrapExplosion(const Vector2& center, int count, ScrapType type, float explosionForce) {
-	std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159265f);
-	std::uniform_real_distribution<float> forceDist(explosionForce * 0.7f, explosionForce * 1.3f);
+	// 近くで眠っているスクラップを起こす（押し出しはしない）
+	WakeScrapsInRadius(center, kExplosionWakeRadius);
+
+	FastRandom::FloatDistribution angleDist(0.0f, 2.0f * 3.14159265f);
+	FastRandom::FloatDistribution forceDist(explosionForce * 0.7f, explosionForce * 1.3f);
 
 	for (int i = 0; i < count; ++i) {
 		float angle = angleDist(randomEngine_);
@@ -195,8 +263,11 @@ void ScrapManager::SpawnScrapExplosion(const Vector2& center, int count, ScrapTy
 
 // 大小混合スクラップ生成
 void ScrapManager::SpawnScrapExplosionKinds(const Vector2& center, int maxCount, int bigSizeCount, ScrapGenerateSize generateSize, float explosionForce, int midSizeCount) {
-	std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159265f);
-	std::uniform_real_distribution<float> forceDist(explosionForce * 0.7f, explosionForce * 1.3f);
+	// 近くで眠っているスクラップを起こす（押し出しはしない）
+	WakeScrapsInRadius(center, kExplosionWakeRadius);
+
+	FastRandom::FloatDistribution angleDist(0.0f, 2.0f * 3.14159265f);
+	FastRandom::FloatDistribution forceDist(explosionForce * 0.7f, explosionForce * 1.3f);
 
 	switch (generateSize) {
 	case ScrapGenerateSize::SmallAndMedium:
@@ -397,85 +468,101 @@ void ScrapManager::ProcessSuction(const Vector2& vaccumPos, float vaccumRadius,
 	}
 
 	// 吸引中のスクラップが範囲外に出た場合のチェック
-	for (auto& scrap : scraps_) {
-		if (!scrap->IsActive()) {
+	// （集合から外すと末尾の番号が今の位置に入るので、末尾から回す）
+	const std::vector<uint32_t>& beingSucked = stateSets_.Get(ScrapState::BeingSucked);
+	for (size_t i = beingSucked.size(); i > 0; --i) {
+		const uint32_t slot = beingSucked[i - 1];
+		Scrap& scrap = scraps_.At(slot);
+		if (!scrap.IsActive()) {
 			continue;
 		}
 
-		if (scrap->GetState() == ScrapState::BeingSucked) {
-			Vector2 toVaccum = vaccumPos - scrap->GetPosition();
-			float distance = std::sqrt(toVaccum.x * toVaccum.x + toVaccum.y * toVaccum.y);
-
-			// 保持移行判定（動的距離を使用）
-			if (distance < holdTransitionRadius) {
-				scrap->SetState(ScrapState::Held);
-				scrap->SetVelocity({ 0.0f, 0.0f });
-				continue;
-			}
-
-			// 吸引範囲外に出た場合、Free状態に戻す
-			if (distance > vaccumRadius) {
-				scrap->SetState(ScrapState::Free);
-				// 速度を大幅に減衰させる
-				Vector2 currentVel = scrap->GetVelocity();
-				scrap->SetVelocity({ currentVel.x * 0.1f, currentVel.y * 0.1f });
-			}
-		}
-	}
+		Vector2 toVaccum = vaccumPos - scrap.GetPosition();
+		float distance = std::sqrt(toVaccum.x * toVaccum.x + toVaccum.y * toVaccum.y);
 
-	// Free状態のスクラップを吸引範囲内に入れる
-	for (auto& scrap : scraps_) {
-		if (!scrap->IsActive()) {
+		// 保持移行判定（動的距離を使用）
+		if (distance < holdTransitionRadius) {
+			SetScrapState(slot, ScrapState::Held);
+			scrap.SetVelocity({ 0.0f, 0.0f });
 			continue;
 		}
 
-		if (scrap->GetState() != ScrapState::Free) {
-			continue;
+		// 吸引範囲外に出た場合、Free状態に戻す
+		if (distance > vaccumRadius) {
+			SetScrapState(slot, ScrapState::Free);
+			// 速度を大幅に減衰させる
+			Vector2 currentVel = scrap.GetVelocity();
+			scrap.SetVelocity({ currentVel.x * 0.1f, currentVel.y * 0.1f });
 		}
+	}
 
-		if (playerWeight >= maxWeight) {
-			break;
-		}
+	// Free状態のスクラップを吸引範囲内に入れる（吸引範囲にかかるセルのものだけを調べる）
+	if (playerWeight < maxWeight) {
+		// 判定は従来どおり実際の位置との距離で行う。グリッドで拾う範囲は丸め誤差のぶん少し広げる
+		gridQueryResult_.clear();
+		freeGrid_.QueryCircle(vaccumPos, vaccumRadius + 1.0f, gridQueryResult_);
 
-		Vector2 toVaccum = vaccumPos - scrap->GetPosition();
-		float distance = std::sqrt(toVaccum.x * toVaccum.x + toVaccum.y * toVaccum.y);
+		for (uint32_t slot : gridQueryResult_) {
+			const Scrap& scrap = scraps_.At(slot);
+			if (!scrap.IsActive()) {
+				continue;
+			}
 
-		if (distance <= vaccumRadius) {
-			scrap->SetState(ScrapState::BeingSucked);
+			Vector2 toVaccum = vaccumPos - scrap.GetPosition();
+			float distance = std::sqrt(toVaccum.x * toVaccum.x + toVaccum.y * toVaccum.y);
+
+			if (distance <= vaccumRadius) {
+				SetScrapState(slot, ScrapState::BeingSucked);
+			}
 		}
 	}
 
 	// 吸引中のスクラップに吸引力を適用
-	for (auto& scrap : scraps_) {
-		if (scrap->GetState() == ScrapState::BeingSucked) {
-			scrap->ApplySuction(vaccumPos, vaccumRadius, 1.0f / 60.0f);
-		}
+	for (uint32_t slot : stateSets_.Get(ScrapState::BeingSucked)) {
+		scraps_.At(slot).ApplySuction(vaccumPos, vaccumRadius, 1.0f / 60.0f);
 	}
 }
 
 // 吸引停止時の処理
 void ScrapManager::ReleaseBeingSuckedScraps() {
-	for (auto& scrap : scraps_) {
-		if (!scrap->IsActive()) {
+	const std::vector<uint32_t>& beingSucked = stateSets_.Get(ScrapState::BeingSucked);
+	for (size_t i = beingSucked.size(); i > 0; --i) {
+		const uint32_t slot = beingSucked[i - 1];
+		Scrap& scrap = scraps_.At(slot);
+		if (!scrap.IsActive()) {
 			continue;
 		}
 
 		// BeingSucked状態のスクラップをFreeに戻す
-		if (scrap->GetState() == ScrapState::BeingSucked) {
-			scrap->SetState(ScrapState::Free);
-			// 速度を大幅に減衰させる
-			Vector2 currentVel = scrap->GetVelocity();
-			scrap->SetVelocity({ currentVel.x * 0.2f, currentVel.y * 0.2f });
-		}
+		SetScrapState(slot, ScrapState::Free);
+		// 速度を大幅に減衰させる
+		Vector2 currentVel = scrap.GetVelocity();
+		scrap.SetVelocity({ currentVel.x * 0.2f, currentVel.y * 0.2f });
 	}
 }
 
 std::vector<Scrap*> ScrapManager::GetHeldScraps() {
 	std::vector<Scrap*> heldScraps;
+	heldScraps.reserve(stateSets_.GetCount(ScrapState::Held));
 
-	for (auto& scrap : scraps_) {
-		if (scrap->IsActive() && scrap->GetState() == ScrapState::Held) {
-			heldScraps.push_back(scrap.get());
+	for (uint32_t slot : stateSets_.Get(ScrapState::Held)) {
+		Scrap& scrap = scraps_.At(slot);
+		if (scrap.IsActive()) {
+			heldScraps.push_back(&scrap);
+		}
+	}
+
+	return heldScraps;
+}
+
+std::vector<ScrapHandle> ScrapManager::GetHeldScrapHandles() const {
+	std::vector<ScrapHandle> heldScraps;
+	heldScraps.reserve(stateSets_.GetCount(ScrapState::Held));
+
+	for (uint32_t slot : stateSets_.Get(ScrapState::Held)) {
+		const Scrap& scrap = scraps_.At(slot);
+		if (scrap.IsActive()) {
+			heldScraps.push_back(scraps_.GetHandle(&scrap));
 		}
 	}
 
@@ -492,28 +579,35 @@ void ScrapManager::FireAllHeldScraps(const Vector2& fireDirection, float fireSpe
 		return;
 	}
 
-	std::uniform_real_distribution<float> angleDist(-spreadAngle / 2.0f, spreadAngle / 2.0f);
+	FastRandom::FloatDistribution angleDist(-spreadAngle / 2.0f, spreadAngle / 2.0f);
 
-	for (auto& scrap : scraps_) {
-		if (!scrap || !scrap->IsActive()) continue;
+	// 保持中のスクラップを発射
+	const std::vector<uint32_t>& held = stateSets_.Get(ScrapState::Held);
+	for (size_t i = held.size(); i > 0; --i) {
+		const uint32_t slot = held[i - 1];
+		Scrap& scrap = scraps_.At(slot);
+		if (!scrap.IsActive()) continue;
 
-		if (scrap->GetState() == ScrapState::Held) {
-			// 保持中のスクラップを発射
-			float angleOffset = angleDist(randomEngine_);
-			float rad = (std::atan2(fireDirection.y, fireDirection.x) + angleOffset * 3.14159f / 180.0f);
+		float angleOffset = angleDist(randomEngine_);
+		float rad = (std::atan2(fireDirection.y, fireDirection.x) + angleOffset * 3.14159f / 180.0f);
 
-			scrap->SetVelocity({
-				std::cos(rad) * fireSpeed,
-				std::sin(rad) * fireSpeed
-				});
+		scrap.SetVelocity({
+			std::cos(rad) * fireSpeed,
+			std::sin(rad) * fireSpeed
+			});
 
-			scrap->SetState(ScrapState::Fired);
-		}
-		else if (scrap->GetState() == ScrapState::BeingSucked) {
-			// 吸引中だが保持されていないスクラップは通常状態に戻す
-			scrap->SetState(ScrapState::Free);
-			scrap->SetVelocity({ 0.0f, 0.0f });
-		}
+		SetScrapState(slot, ScrapState::Fired);
+	}
+
+	// 吸引中だが保持されていないスクラップは通常状態に戻す
+	const std::vector<uint32_t>& beingSucked = stateSets_.Get(ScrapState::BeingSucked);
+	for (size_t i = beingSucked.size(); i > 0; --i) {
+		const uint32_t slot = beingSucked[i - 1];
+		Scrap& scrap = scraps_.At(slot);
+		if (!scrap.IsActive()) continue;
+
+		SetScrapState(slot, ScrapState::Free);
+		scrap.SetVelocity({ 0.0f, 0.0f });
 	}
 
 	heldWeight_ = 0.0f;
@@ -523,7 +617,9 @@ void ScrapManager::FireAllHeldScraps(const Vector2& fireDirection, float fireSpe
 // クリア
 // ========================================
 void ScrapManager::ClearAll() {
-	scraps_.clear();
+	scraps_.Clear();
+	stateSets_.Clear();
+	freeGrid_.Clear();
 	heldWeight_ = 0.0f;
 	heldCount_ = 0;
 }
@@ -532,40 +628,44 @@ void ScrapManager::ClearAll() {
 // 非アクティブなスクラップを配列から削除
 // ========================================
 void ScrapManager::ClearInactive() {
-	scraps_.erase(
-		std::remove_if(scraps_.begin(), scraps_.end(),
-			[](const std::unique_ptr<Scrap>& scrap) {
-				return !scrap->IsActive();
-			}),
-		scraps_.end()
-	);
+	// スロットを空きに戻すだけ（解放・再確保はしない）。空いたスロットは状態の集合からも外す
+	freedSlots_.clear();
+	scraps_.CollectInactive(&freedSlots_);
+	for (uint32_t slot : freedSlots_) {
+		stateSets_.Erase(slot);
+		freeGrid_.Erase(slot);
+	}
 }
 
 // ========================================
 // 画面外のスクラップを削除
 // ========================================
 void ScrapManager::RemoveOutOfBoundsScraps(const Vector2& screenSize, float margin) {
-	for (auto& scrap : scraps_) {
-		if (!scrap->IsActive()) {
-			continue;
-		}
-
-		// Held状態のスクラップは削除しない
-		if (scrap->GetState() == ScrapState::Held || scrap->GetState() == ScrapState::BeingSucked) {
-			continue;
-		}
+	// Held・BeingSucked 状態のスクラップは削除しないので、それ以外の集合だけを見る
+	// （眠っているものも、範囲が変えられたときのために見る。位置を比べるだけなので軽い）
+	const std::vector<uint32_t>* removableSets[] = {
+		&stateSets_.Get(ScrapState::Free), &stateSets_.GetSleeping(),
+		&stateSets_.Get(ScrapState::Fired), &stateSets_.Get(ScrapState::Hit)
+	};
+	for (const std::vector<uint32_t>* slots : removableSets) {
+		for (uint32_t slot : *slots) {
+			Scrap& scrap = scraps_.At(slot);
+			if (!scrap.IsActive()) {
+				continue;
+			}
 
-		Vector2 pos = scrap->GetPosition();
+			Vector2 pos = scrap.GetPosition();
 
-		// 画面外判定（マージン付き）
-		bool outOfBounds =
-			pos.x < -margin ||
-			pos.x > screenSize.x + margin ||
-			pos.y < -margin ||
-			pos.y > screenSize.y + margin;
+			// 画面外判定（マージン付き）
+			bool outOfBounds =
+				pos.x < -margin ||
+				pos.x > screenSize.x + margin ||
+				pos.y < -margin ||
+				pos.y > screenSize.y + margin;
 
-		if (outOfBounds) {
-			scrap->SetActive(false);
+			if (outOfBounds) {
+				scrap.SetActive(false);
+			}
 		}
 	}
 
@@ -577,61 +677,40 @@ void ScrapManager::RemoveOutOfBoundsScraps(const Vector2& screenSize, float marg
 // デバッグ用
 // ========================================
 int ScrapManager::GetActiveScrapsCount() const {
-	return static_cast<int>(std::count_if(scraps_.begin(), scraps_.end(),
-		[](const std::unique_ptr<Scrap>& scrap) {
-			return scrap->IsActive();
-		}));
+	// 非アクティブなものは Update の最後に回収されるので、プールの数がそのままアクティブ数
+	return scraps_.GetCount();
 }
 
 int ScrapManager::GetFreeScrapsCount() const {
-	return static_cast<int>(std::count_if(scraps_.begin(), scraps_.end(),
-		[](const std::unique_ptr<Scrap>& scrap) {
-			return scrap->IsActive() && scrap->GetState() == ScrapState::Free;
-		}));
+	return GetStateCount(ScrapState::Free);
 }
 
-// ========================================
-// 重複回避処理
-// ========================================
-bool ScrapManager::IsOverlapping(const Vector2& position, float radius,
-	const std::vector<Vector2>& existingPositions, const std::vector<float>& existingRadii) {
-
-	for (size_t i = 0; i < existingPositions.size(); ++i) {
-		Vector2 diff = { position.x - existingPositions[i].x, position.y - existingPositions[i].y };
-		float distance = std::sqrt(diff.x * diff.x + diff.y * diff.y);
-		float minDistance = radius + existingRadii[i] + kMinSpawnDistance;
-
-		if (distance < minDistance) {
-			return true;
-		}
-	}
-
-	return false;
+int ScrapManager::GetStateCount(ScrapState state) const {
+	// Free は眠っているものも含める
+	const int count = stateSets_.GetCount(state);
+	return state == ScrapState::Free ? count + stateSets_.GetSleepingCount() : count;
 }
 
-// 重複しない位置を探索
-Vector2 ScrapManager::FindNonOverlappingPosition(const Vector2& basePosition, float radius, float searchRadius,
-	const std::vector<Vector2>& existingPositions, const std::vector<float>& existingRadii, int maxAttempts) {
-
-	std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159265f);
-	std::uniform_real_distribution<float> distDist(0.0f, searchRadius);
+int ScrapManager::GetSleepingScrapsCount() const {
+	return stateSets_.GetSleepingCount();
+}
 
-	for (int attempt = 0; attempt < maxAttempts; ++attempt) {
-		Vector2 candidate = basePosition;
+int ScrapManager::GetAwakeScrapsCount() const {
+	return GetActiveScrapsCount() - GetSleepingScrapsCount();
+}
 
-		if (attempt > 0) {
-			float angle = angleDist(randomEngine_);
-			float dist = distDist(randomEngine_);
-			candidate.x += std::cos(angle) * dist;
-			candidate.y += std::sin(angle) * dist;
-		}
+// ========================================
+// 重複回避処理
+// ========================================
 
-		if (!IsOverlapping(candidate, radius, existingPositions, existingRadii)) {
-			return candidate;
+// 生成位置の探索を始める（フィールドに出ているスクラップも障害物として登録する）
+void ScrapManager::BeginSpawnPlacement(const Vector2& center, float extent, int count) {
+	spawnPlacer_.Begin(center, extent, Scrap::GetTypeRadius(ScrapType::Large), kMinSpawnDistance, count);
+	for (const Scrap& scrap : scraps_) {
+		if (scrap.IsActive()) {
+			spawnPlacer_.AddObstacle(scrap.GetPosition(), scrap.GetRadius());
 		}
 	}
-
-	return basePosition;
 }
 
 // ========================================
@@ -642,72 +721,99 @@ Vector2 ScrapManager::FindNonOverlappingPosition(const Vector2& basePosition, fl
 void ScrapManager::ResolveCollisions(const Vector2& vaccumPos) {
 	vaccumPos; // 未使用パラメータ対策
 
-	std::vector<Scrap*> activeScraps;
-
-	// 吸引中・保持中のスクラップを収集
-	for (auto& scrap : scraps_) {
-		if (!scrap->IsActive()) {
-			continue;
+	// 吸引中・保持中のスクラップを収集（バッファは使い回す）
+	collisionScraps_.clear();
+	for (ScrapState state : { ScrapState::BeingSucked, ScrapState::Held }) {
+		for (uint32_t slot : stateSets_.Get(state)) {
+			Scrap& scrap = scraps_.At(slot);
+			if (scrap.IsActive()) {
+				collisionScraps_.push_back(&scrap);
+			}
 		}
+	}
 
-		ScrapState state = scrap->GetState();
-		if (state == ScrapState::BeingSucked || state == ScrapState::Held) {
-			activeScraps.push_back(scrap.get());
-		}
+	ResolveCollisionsInGrid(collisionScraps_);
+}
+
+void ScrapManager::ResolveCollisionsInGrid(const std::vector<Scrap*>& scraps) {
+	const int count = static_cast<int>(scraps.size());
+	if (count < 2) {
+		return;
+	}
+
+	// 重なりうる距離は半径の和まで。一番大きい半径の2倍をセルにすれば隣のセルまで見れば足りる
+	float maxRadius = 0.0f;
+	for (const Scrap* scrap : scraps) {
+		maxRadius = std::max(maxRadius, scrap->GetCollisionRadius());
 	}
+	const float cellSize = maxRadius * 2.0f;
 
 	const int iterations = 3;
 	for (int iter = 0; iter < iterations; ++iter) {
-		for (size_t i = 0; i < activeScraps.size(); ++i) {
-			for (size_t j = i + 1; j < activeScraps.size(); ++j) {
-				Scrap* a = activeScraps[i];
-				Scrap* b = activeScraps[j];
-
-				// 両方とも吸引中の場合はスキップ
-				if (a->GetState() == ScrapState::BeingSucked &&
-					b->GetState() == ScrapState::BeingSucked) {
-					continue;
-				}
-
-				Vector2 posA = a->GetPosition();
-				Vector2 posB = b->GetPosition();
-
-				Vector2 diff = { posB.x - posA.x, posB.y - posA.y };
-				float distance = std::sqrt(diff.x * diff.x + diff.y * diff.y);
-
-				float radiusA = a->GetCollisionRadius();
-				float radiusB = b->GetCollisionRadius();
-				float minDistance = radiusA + radiusB;
-
-				if (distance < minDistance && distance > 0.01f) {
-					Vector2 normal = { diff.x / distance, diff.y / distance };
-
-					float overlap = minDistance - distance;
-					Vector2 push = { normal.x * overlap * 0.5f, normal.y * overlap * 0.5f };
-
-					// 吸引中が含まれる場合は軽い反発
-					bool hasBeingSucked = (a->GetState() == ScrapState::BeingSucked ||
-						b->GetState() == ScrapState::BeingSucked);
-					float pushScale = hasBeingSucked ? 0.3f : 1.0f;
-
-					if (a->GetState() == ScrapState::Held) {
-						a->SetPosition({ posA.x - push.x * pushScale, posA.y - push.y * pushScale });
-					}
-					else {
-						a->AddVelocity({ -push.x * kCollisionPushForce * pushScale,
-										 -push.y * kCollisionPushForce * pushScale });
-					}
-
-					if (b->GetState() == ScrapState::Held) {
-						b->SetPosition({ posB.x + push.x * pushScale, posB.y + push.y * pushScale });
-					}
-					else {
-						b->AddVelocity({ push.x * kCollisionPushForce * pushScale,
-										 push.y * kCollisionPushForce * pushScale });
-					}
-				}
-			}
+		// 保持中は押し出しで位置が動くので、反復ごとに登録し直す
+		collisionPositions_.resize(count);
+		for (int i = 0; i < count; ++i) {
+			collisionPositions_[i] = scraps[i]->GetPosition();
 		}
+		collisionGrid_.Build(collisionPositions_, cellSize);
+
+		collisionGrid_.ForEachNearPair([&scraps](int i, int j) {
+			ResolveCollisionPair(*scraps[i], *scraps[j]);
+		});
+	}
+}
+
+void ScrapManager::ResolveCollisionPair(Scrap& a, Scrap& b) {
+	// 両方とも吸引中の場合はスキップ
+	if (a.GetState() == ScrapState::BeingSucked &&
+		b.GetState() == ScrapState::BeingSucked) {
+		return;
+	}
+
+	Vector2 posA = a.GetPosition();
+	Vector2 posB = b.GetPosition();
+
+	Vector2 diff = { posB.x - posA.x, posB.y - posA.y };
+	float distanceSq = diff.x * diff.x + diff.y * diff.y;
+
+	float radiusA = a.GetCollisionRadius();
+	float radiusB = b.GetCollisionRadius();
+	float minDistance = radiusA + radiusB;
+
+	// 重なっていない組は平方根を取らずに抜ける
+	if (distanceSq >= minDistance * minDistance) {
+		return;
+	}
+
+	float distance = std::sqrt(distanceSq);
+	if (distance <= 0.01f) {
+		return;
+	}
+
+	Vector2 normal = { diff.x / distance, diff.y / distance };
+
+	float overlap = minDistance - distance;
+	Vector2 push = { normal.x * overlap * 0.5f, normal.y * overlap * 0.5f };
+
+	// 吸引中が含まれる場合は軽い反発
+	bool hasBeingSucked = (a.GetState() == ScrapState::BeingSucked ||
+		b.GetState() == ScrapState::BeingSucked);
+	float pushScale = hasBeingSucked ? 0.3f : 1.0f;
+
+	if (a.GetState() == ScrapState::Held) {
+		a.SetPosition({ posA.x - push.x * pushScale, posA.y - push.y * pushScale });
+	}
+	else {
+		a.AddVelocity({ -push.x * kCollisionPushForce * pushScale,
+						 -push.y * kCollisionPushForce * pushScale });
+	}
+
+	if (b.GetState() == ScrapState::Held) {
+		b.SetPosition({ posB.x + push.x * pushScale, posB.y + push.y * pushScale });
+	}
+	else {
+		b.AddVelocity({ push.x * kCollisionPushForce * pushScale,
+						 push.y * kCollisionPushForce * pushScale });
 	}
 }
 
@@ -889,8 +995,8 @@ void ScrapManager::SpawnBossScrapMove(
 	bossMoveSpawnFrameCounter_ = 0;
 
 	// ランダム生成用の分布
-	std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159265f);
-	std::uniform_real_distribution<float> radiusDist(0.0f, bossRadius);
+	FastRandom::FloatDistribution angleDist(0.0f, 2.0f * 3.14159265f);
+	FastRandom::FloatDistribution radiusDist(0.0f, bossRadius);
 
 	// 指定個数のスクラップを生成
 	for (int i = 0; i < spawnCountPerInterval; ++i) {
@@ -917,7 +1023,7 @@ void ScrapManager::SpawnBossScrapMove(
 		}
 
 		// 外側への初速度を設定（少しランダム性を加える）
-		std::uniform_real_distribution<float> speedVariation(0.8f, 1.2f);
+		FastRandom::FloatDistribution speedVariation(0.8f, 1.2f);
 		float speedMultiplier = speedVariation(randomEngine_);
 
 		Vector2 velocity = {
@@ -986,10 +1092,10 @@ void ScrapManager::SpawnBossScrapBeam(
 	float segmentLength = beamLength / maxCount;
 
 	// ランダム生成用の分布
-	std::uniform_real_distribution<float> widthDist(-width * 0.5f, width * 0.5f);
-	std::uniform_real_distribution<float> offsetDist(-segmentLength * 0.3f, segmentLength * 0.3f);
-	std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159265f);
-	std::uniform_real_distribution<float> velocityDist(randomVelocityRange * 0.5f, randomVelocityRange);
+	FastRandom::FloatDistribution widthDist(-width * 0.5f, width * 0.5f);
+	FastRandom::FloatDistribution offsetDist(-segmentLength * 0.3f, segmentLength * 0.3f);
+	FastRandom::FloatDistribution angleDist(0.0f, 2.0f * 3.14159265f);
+	FastRandom::FloatDistribution velocityDist(randomVelocityRange * 0.5f, randomVelocityRange);
 
 	// サイズごとのスクラップ数を計算
 	int smallCount = 0, mediumCount = 0, largeCount = 0;
@@ -1023,7 +1129,7 @@ void ScrapManager::SpawnBossScrapBeam(
 	for (int i = 0; i < largeCount; ++i) scrapTypes.push_back(ScrapType::Large);
 
 	// シャッフルしてランダムに配置
-	std::shuffle(scrapTypes.begin(), scrapTypes.end(), randomEngine_);
+	randomEngine_.Shuffle(scrapTypes.begin(), scrapTypes.end());
 
 	// 各区画にスクラップを配置
 	for (int i = 0; i < maxCount; ++i) {
@@ -1,8 +1,13 @@
 ﻿#pragma once
 #include "Scrap.h"
+#include "ScrapPool.h"
+#include "ScrapCollisionGrid.h"
+#include "ScrapStateSets.h"
+#include "ScrapSpatialGrid.h"
+#include "ScrapSpawnPlacer.h"
 #include <vector>
 #include <memory>
-#include <random>
+#include "FastRandom.h"
 
 class Player;
 
@@ -22,11 +27,15 @@ enum class ScrapGenerateSize {
 
 class ScrapManager {
 	friend class DebugWindow;
+	friend class ScrapBenchmark;
 public:
 	ScrapManager();
 	~ScrapManager() = default;
 
 	void Initialize();
+
+	// 乱数のシードを固定する（同じシード・同じ操作なら同じ結果になる）
+	void SetRandomSeed(uint64_t seed);
 	void Update(float dt, const Vector2& vaccumPos, bool isSucking);
 	void Draw(const Vector2& scrollOffset);
 
@@ -131,8 +140,10 @@ public:
 	// 吸引停止時に BeingSucked 状態のスクラップを解放
 	void ReleaseBeingSuckedScraps();
 
-	// 保持中のスクラップを取得
+	// 保持中のスクラップを取得（ポインタは次の ClearInactive まで有効）
 	std::vector<Scrap*> GetHeldScraps();
+	// 保持中のスクラップのハンドル（フレームをまたいで持つ場合はこちら。GetScrap で引き直す）
+	std::vector<ScrapHandle> GetHeldScrapHandles() const;
 	float GetHeldWeight() const { return heldWeight_; }
 	int GetHeldCount() const { return heldCount_; }
 
@@ -151,8 +162,32 @@ public:
 	// 画面外判定
 	void RemoveOutOfBoundsScraps(const Vector2& screenSize, float margin = 200.0f);
 
-	// スクラップ配列を取得
-	std::vector<std::unique_ptr<Scrap>>& GetScraps() { return scraps_; }
+	// 生きているスクラップを生成順に回す範囲（for (Scrap& scrap : GetScraps())）
+	ScrapPool::View GetScraps() { return ScrapPool::View(scraps_); }
+
+	/// <summary>
+	/// スクラップの状態を変える（状態ごとの集合も一緒に更新するので、状態は必ずここから変える）
+	/// プールの外・回収済みのスクラップには何もしない
+	/// </summary>
+	void SetScrapState(Scrap& scrap, ScrapState state);
+
+	// 状態ごとの数（O(1)。非アクティブになって未回収のものも含む。Free は眠っているものも含む）
+	int GetStateCount(ScrapState state) const;
+
+	// 眠っているスクラップを起こす（ゲーム側の当たり判定で Free のスクラップに何か当たったとき用）
+	void WakeScrap(Scrap& scrap);
+
+	/// <summary>
+	/// center から radius 以内で眠っている Free のスクラップを起こす（速度は変えない）
+	/// </summary>
+	/// <param name="center">衝撃の中心</param>
+	/// <param name="radius">届く距離</param>
+	void WakeScrapsInRadius(const Vector2& center, float radius);
+
+	// ハンドルからスクラップを引く（消えていれば nullptr）
+	Scrap* GetScrap(ScrapHandle handle) { return scraps_.Get(handle); }
+	// 当たり判定の owner などに渡した Scrap* をハンドルに変換する（消えていれば無効なハンドル）
+	ScrapHandle GetScrapHandle(const Scrap* scrap) const { return scraps_.GetHandle(scrap); }
 
 	// ========================================
 	// デバッグ用
@@ -160,6 +195,8 @@ public:
 
 	int GetActiveScrapsCount() const;
 	int GetFreeScrapsCount() const;
+	int GetSleepingScrapsCount() const;  // 止まっていて更新していない Free の数
+	int GetAwakeScrapsCount() const;     // 毎フレーム更新している数
 
 	/// <summary>
 	/// デバッグ入力処理（マウスクリックでスクラップ生成など）
@@ -187,27 +224,49 @@ public:
 	};
 
 private:
-	// スクラップ配列
-	std::vector<std::unique_ptr<Scrap>> scraps_;
-	// 乱数生成器
-	std::mt19937 randomEngine_;
+	// スクラップのプール（容量 kMaxScraps の連続した配列。生成順に回せる）
+	ScrapPool scraps_{ kMaxScraps };
+	// 生きているスクラップのスロット番号を状態ごとに分けた集合
+	ScrapStateSets stateSets_;
+	std::vector<uint32_t> freedSlots_;  // ClearInactive の作業用
+
+	// Free のスクラップだけを入れた位置のグリッド（吸引範囲に入ったものを近くのセルだけで探す）
+	ScrapSpatialGrid freeGrid_;
+	std::vector<uint32_t> gridQueryResult_;
+
+	// 生成位置の探索（SpawnScrapCircle / SpawnScrapRandom ごとに作り直す）
+	ScrapSpawnPlacer spawnPlacer_;
+
+	// 乱数生成器（シードが同じならどの環境でも同じ列）
+	FastRandom randomEngine_;
 
 	// 保持中のスクラップ情報
 	float heldWeight_ = 0.0f;
 	int heldCount_ = 0;
 
+	// 衝突処理の作業用（毎フレーム確保し直さないよう持っておく）
+	std::vector<Scrap*> collisionScraps_;
+	std::vector<Vector2> collisionPositions_;
+	ScrapCollisionGrid collisionGrid_;
+
+	// スロット番号で状態を変える（Scrap と集合を同時に書き換える）
+	void SetScrapState(uint32_t slot, ScrapState state);
+
 	// スクラップ生成の内部処理
 	Scrap* CreateScrap(ScrapType type, ScrapTrait trait, const Vector2& position, const Vector2& velocity);
 
-	// 重複回避処理
-	bool IsOverlapping(const Vector2& position, float radius, const std::vector<Vector2>& existingPositions, const std::vector<float>& existingRadii);
-
-	// 重複しない位置を探索
-	Vector2 FindNonOverlappingPosition(const Vector2& basePosition, float radius, float searchRadius, const std::vector<Vector2>& existingPositions, const std::vector<float>& existingRadii, int maxAttempts = 30);
+	// 重複しない生成位置の探索を始める（extent は中心から候補が出うる距離、count は置く数）
+	void BeginSpawnPlacement(const Vector2& center, float extent, int count);
 
 	// 吸引中・保持中の衝突処理
 	void ResolveCollisions(const Vector2& vaccumPos);
 
+	// scraps 同士の押し出しを一様グリッドで近くの組だけ調べて解決する（3回反復）
+	void ResolveCollisionsInGrid(const std::vector<Scrap*>& scraps);
+
+	// 1組の押し出し（保持中は位置、それ以外は速度を動かす）
+	static void ResolveCollisionPair(Scrap& a, Scrap& b);
+
 	// 保持中のスクラップを整列
 	void ArrangeHeldScraps(const Vector2& vaccumPos);
 
@@ -243,4 +302,8 @@ private: // 定数
 	constexpr static float kHeldOrbitRadiusStep = 15.0f;  // 層ごとの半径増加量
 
 	constexpr static float kOutOfBoundsMargin = 200.0f;  // 画面外判定のマージン
+	constexpr static float kFieldWidth = 1280.0f;        // スクラップが残れる範囲（画面サイズ + マージン）
+	constexpr static float kFieldHeight = 720.0f;
+	constexpr static float kFreeGridCellSize = 64.0f;    // Free グリッドのセルの一辺
+	constexpr static float kExplosionWakeRadius = 150.0f; // 爆発生成で近くの眠っているスクラップを起こす範囲
 };
\ No newline at end of file
@@ -0,0 +1,88 @@
+﻿#include "ScrapPool.h"
+#include <algorithm>
+#include <functional>
+
+#ifdef max
+#undef max
+#endif
+
+#ifdef min
+#undef min
+#endif
+
+ScrapPool::ScrapPool(int capacity) {
+	const size_t size = static_cast<size_t>(std::max(0, capacity));
+	scraps_.resize(size);
+	generations_.assign(size, 1);
+	inUse_.assign(size, 0);
+	live_.reserve(size);
+
+	// 若い番号から使うよう、末尾に 0 が来る順で積む
+	freeSlots_.reserve(size);
+	for (size_t i = size; i > 0; --i) {
+		freeSlots_.push_back(static_cast<uint32_t>(i - 1));
+	}
+}
+
+ScrapHandle ScrapPool::Create() {
+	if (freeSlots_.empty()) {
+		return ScrapHandle{};
+	}
+
+	const uint32_t index = freeSlots_.back();
+	freeSlots_.pop_back();
+	inUse_[index] = 1;
+	live_.push_back(index);
+	return { index, generations_[index] };
+}
+
+void ScrapPool::CollectInactive(std::vector<uint32_t>* outFreedSlots) {
+	// 生成順を保ったまま、非アクティブなものを詰める（動くのはスロット番号だけで Scrap は動かない）
+	size_t write = 0;
+	for (size_t read = 0; read < live_.size(); ++read) {
+		const uint32_t index = live_[read];
+		if (scraps_[index].IsActive()) {
+			live_[write++] = index;
+			continue;
+		}
+
+		// 世代を進めて古いハンドルを無効にする
+		inUse_[index] = 0;
+		generations_[index] = (generations_[index] + 1 == 0) ? 1 : generations_[index] + 1;
+		freeSlots_.push_back(index);
+		if (outFreedSlots != nullptr) {
+			outFreedSlots->push_back(index);
+		}
+	}
+	live_.resize(write);
+}
+
+void ScrapPool::Clear() {
+	for (uint32_t index : live_) {
+		scraps_[index].SetActive(false);
+	}
+	CollectInactive();
+}
+
+Scrap* ScrapPool::Get(ScrapHandle handle) {
+	if (handle.index >= scraps_.size()) return nullptr;
+	if (!inUse_[handle.index] || generations_[handle.index] != handle.generation) return nullptr;
+	return &scraps_[handle.index];
+}
+
+const Scrap* ScrapPool::Get(ScrapHandle handle) const {
+	return const_cast<ScrapPool*>(this)->Get(handle);
+}
+
+ScrapHandle ScrapPool::GetHandle(const Scrap* scrap) const {
+	if (scrap == nullptr || scraps_.empty()) return ScrapHandle{};
+
+	// 配列の外のポインタとも比べられるよう std::less で比べる
+	const Scrap* first = scraps_.data();
+	const Scrap* last = first + scraps_.size();
+	if (std::less<const Scrap*>{}(scrap, first) || !std::less<const Scrap*>{}(scrap, last)) return ScrapHandle{};
+
+	const uint32_t index = static_cast<uint32_t>(scrap - first);
+	if (!inUse_[index]) return ScrapHandle{};
+	return { index, generations_[index] };
+}
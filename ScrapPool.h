@@ -0,0 +1,110 @@
+﻿#pragma once
+#include "Scrap.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// スクラップのハンドル
+/// スロット番号と世代の組で、消えたスクラップのハンドルは同じスロットが再利用されても無効のまま
+/// </summary>
+struct ScrapHandle {
+	static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+	uint32_t index = kInvalidIndex;
+	uint32_t generation = 0;
+
+	// 一度でも発行されたハンドルか（生きているかは ScrapPool::IsAlive で確認する）
+	bool IsValid() const { return index != kInvalidIndex; }
+
+	bool operator==(const ScrapHandle& other) const = default;
+};
+
+/// <summary>
+/// スクラップのプール（容量固定、1本の連続した配列）
+/// Scrap は作った時点でスロットに固定され、生きている間に動くことはない（Scrap* は消えるまで有効）。
+/// 空きスロットはスタックで持ち、生成・回収とも O(1)。
+/// 生きているスクラップのスロット番号を生成順に並べた列も持ち、範囲 for はその順に回る
+/// </summary>
+class ScrapPool {
+public:
+	explicit ScrapPool(int capacity);
+
+	/// <summary>
+	/// 空きスロットを1つ使う（満杯なら無効なハンドル）
+	/// 中身は前に使っていたときのままなので、呼び出し側で Scrap::Initialize すること
+	/// </summary>
+	ScrapHandle Create();
+
+	/// <summary>
+	/// IsActive() が false になったスクラップのスロットを空ける（残りの生成順は保つ）
+	/// 空けたスロットのハンドルは無効になる。outFreedSlots があれば空けたスロット番号を末尾に足す
+	/// </summary>
+	void CollectInactive(std::vector<uint32_t>* outFreedSlots = nullptr);
+	void Clear();
+
+	// ハンドルから引く（無効・回収済みなら nullptr）
+	Scrap* Get(ScrapHandle handle);
+	const Scrap* Get(ScrapHandle handle) const;
+	bool IsAlive(ScrapHandle handle) const { return Get(handle) != nullptr; }
+
+	// スロット番号で直接引く（生きているスロットの番号だけを渡すこと）
+	Scrap& At(uint32_t index) { return scraps_[index]; }
+	const Scrap& At(uint32_t index) const { return scraps_[index]; }
+
+	// プール内の Scrap* からハンドルを引く（プールの外・回収済みなら無効なハンドル）
+	ScrapHandle GetHandle(const Scrap* scrap) const;
+
+	int GetCount() const { return static_cast<int>(live_.size()); }
+	int GetCapacity() const { return static_cast<int>(scraps_.size()); }
+	bool IsFull() const { return freeSlots_.empty(); }
+
+	/// <summary>
+	/// 生きているスクラップを生成順に回すイテレータ（参照を返す）
+	/// </summary>
+	template <typename PoolT, typename ScrapT>
+	class BasicIterator {
+	public:
+		BasicIterator(PoolT* pool, size_t position) : pool_(pool), position_(position) {}
+
+		ScrapT& operator*() const { return pool_->scraps_[pool_->live_[position_]]; }
+		ScrapT* operator->() const { return &**this; }
+		BasicIterator& operator++() { ++position_; return *this; }
+		bool operator==(const BasicIterator& other) const { return position_ == other.position_; }
+		bool operator!=(const BasicIterator& other) const { return position_ != other.position_; }
+
+	private:
+		PoolT* pool_;
+		size_t position_;
+	};
+	using Iterator = BasicIterator<ScrapPool, Scrap>;
+	using ConstIterator = BasicIterator<const ScrapPool, const Scrap>;
+
+	Iterator begin() { return Iterator(this, 0); }
+	Iterator end() { return Iterator(this, live_.size()); }
+	ConstIterator begin() const { return ConstIterator(this, 0); }
+	ConstIterator end() const { return ConstIterator(this, live_.size()); }
+
+	/// <summary>
+	/// 外に渡す用の見るだけの範囲（生成・回収はできない）
+	/// </summary>
+	class View {
+	public:
+		explicit View(ScrapPool& pool) : pool_(&pool) {}
+
+		Iterator begin() const { return pool_->begin(); }
+		Iterator end() const { return pool_->end(); }
+		int size() const { return pool_->GetCount(); }
+		bool empty() const { return pool_->GetCount() == 0; }
+
+	private:
+		ScrapPool* pool_;
+	};
+
+private:
+	std::vector<Scrap> scraps_;            // 容量ぶんを最初に確保し、以後は大きさを変えない
+	std::vector<uint32_t> generations_;    // スロットごとの世代（0 は既定のハンドルと区別するため使わない）
+	std::vector<uint8_t> inUse_;
+	std::vector<uint32_t> freeSlots_;      // 空きスロット（末尾から使う）
+	std::vector<uint32_t> live_;           // 生きているスロット（生成順）
+};
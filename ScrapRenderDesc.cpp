@@ -0,0 +1,93 @@
+﻿#include "ScrapRenderDesc.h"
+#include "Scrap.h"
+#include <Novice.h>
+#include <array>
+#include <cmath>
+
+namespace {
+
+	constexpr const char* kBodyTexturePath = "./NoviceResources/white1x1.png";
+	constexpr const char* kBreakTexturePath = "./Resources/images/tomo/scrap_break_ver1.png";
+
+	// 壊れるアニメーションのシート（64x64 を横に4枚）
+	constexpr int kBreakFrameSize = 64;
+	constexpr int kBreakFrameCount = 4;
+	constexpr float kBreakFrameDuration = 0.1f;
+
+	struct RenderTable {
+		bool loaded = false;
+		ScrapBreakClip breakClip;
+		std::array<ScrapRenderDesc, 3> descs;  // ScrapType の順
+		int loadCount = 0;
+	};
+
+	RenderTable& Table() {
+		static RenderTable table;
+		return table;
+	}
+
+	void Load(RenderTable& table) {
+		const int bodyTexture = Novice::LoadTexture(kBodyTexturePath);
+		const int breakTexture = Novice::LoadTexture(kBreakTexturePath);
+		table.loadCount += 2;
+
+		table.breakClip.sheet = SpriteSheet::GetWithFrameSize(breakTexture, kBreakFrameSize, kBreakFrameSize, kBreakFrameCount, 1);
+		table.breakClip.frameCount = kBreakFrameCount;
+		table.breakClip.frameDuration = kBreakFrameDuration;
+
+		const ScrapType types[] = { ScrapType::Small, ScrapType::Medium, ScrapType::Large };
+		const unsigned int alphas[] = { 0xAA, 0xCC, 0xFF };
+		for (int i = 0; i < 3; ++i) {
+			ScrapRenderDesc& desc = table.descs[i];
+			desc.bodyTexture = bodyTexture;
+			desc.bodySize = Scrap::GetTypeRadius(types[i]) * 2.0f;
+			desc.bodyAlpha = alphas[i];
+			desc.breakClip = &table.breakClip;
+			desc.breakSize = desc.bodySize * 2.0f;
+		}
+		table.loaded = true;
+	}
+}
+
+const ScrapRenderDesc& ScrapRenderDesc::Get(ScrapType type) {
+	RenderTable& table = Table();
+	if (!table.loaded) {
+		Load(table);
+	}
+
+	const int index = static_cast<int>(type);
+	return table.descs[index >= 0 && index < 3 ? index : 0];
+}
+
+void ScrapRenderDesc::Reset() {
+	Table().loaded = false;
+}
+
+int ScrapRenderDesc::GetTextureLoadCount() {
+	return Table().loadCount;
+}
+
+void ScrapRenderDesc::DrawRotatedQuad(const Vector2& center, float size, float angle,
+	int srcX, int srcY, int srcW, int srcH, int textureHandle, unsigned int color) {
+	const float half = size * 0.5f;
+	const float c = std::cos(angle);
+	const float s = std::sin(angle);
+
+	// 中心からの (±half, ±half) を回転させた4隅
+	auto corner = [&](float x, float y) {
+		return Vector2{ center.x + x * c - y * s, center.y + x * s + y * c };
+	};
+	const Vector2 lt = corner(-half, -half);
+	const Vector2 rt = corner(half, -half);
+	const Vector2 lb = corner(-half, half);
+	const Vector2 rb = corner(half, half);
+
+	Novice::DrawQuad(
+		static_cast<int>(lt.x), static_cast<int>(lt.y),
+		static_cast<int>(rt.x), static_cast<int>(rt.y),
+		static_cast<int>(lb.x), static_cast<int>(lb.y),
+		static_cast<int>(rb.x), static_cast<int>(rb.y),
+		srcX, srcY, srcW, srcH,
+		textureHandle, color
+	);
+}
@@ -0,0 +1,43 @@
+﻿#pragma once
+#include "Vector2.h"
+#include "SpriteSheet.h"
+
+enum class ScrapType;
+
+/// <summary>
+/// スクラップが壊れるときのアニメーション（全スクラップで1つを共有する）
+/// </summary>
+struct ScrapBreakClip {
+	const SpriteSheet* sheet = nullptr;  // 64x64 × 4 フレーム
+	int frameCount = 1;
+	float frameDuration = 0.1f;          // 1フレームの秒数（ループしない）
+};
+
+/// <summary>
+/// ScrapType ごとの見た目（同じ種類のスクラップは全て同じものを指す）
+/// テクスチャは最初に Get したときに1回だけ読み込み、以後は使い回す
+/// </summary>
+struct ScrapRenderDesc {
+	int bodyTexture = -1;              // 本体（white1x1 を色で塗る）
+	float bodySize = 0.0f;             // 本体の一辺（半径 × 2）
+	unsigned int bodyAlpha = 0xFF;     // 種類ごとの不透明度
+	const ScrapBreakClip* breakClip = nullptr;
+	float breakSize = 0.0f;            // 壊れるアニメーションの一辺（本体の2倍）
+
+	/// <summary>
+	/// 種類の見た目を取得する（初回だけテクスチャを読み込む）
+	/// </summary>
+	static const ScrapRenderDesc& Get(ScrapType type);
+
+	// 読み込み済みのテクスチャを捨てて、次の Get で読み直させる（計測用）
+	static void Reset();
+
+	// これまでに LoadTexture を呼んだ回数（計測・デバッグ表示用）
+	static int GetTextureLoadCount();
+
+	/// <summary>
+	/// center を中心に size 四方、angle 回転した矩形を DrawQuad で描く
+	/// </summary>
+	static void DrawRotatedQuad(const Vector2& center, float size, float angle,
+		int srcX, int srcY, int srcW, int srcH, int textureHandle, unsigned int color);
+};
@@ -0,0 +1,118 @@
+﻿#include "ScrapSpatialGrid.h"
+#include <algorithm>
+
+#ifdef max
+#undef max
+#endif
+
+#ifdef min
+#undef min
+#endif
+
+void ScrapSpatialGrid::Initialize(const Vector2& min, const Vector2& max, float cellSize, int capacity) {
+	min_ = min;
+	cellSize_ = std::max(1.0f, cellSize);
+	invCellSize_ = 1.0f / cellSize_;
+	gridWidth_ = std::max(1, static_cast<int>((max.x - min.x) * invCellSize_) + 1);
+	gridHeight_ = std::max(1, static_cast<int>((max.y - min.y) * invCellSize_) + 1);
+	cells_.assign(static_cast<size_t>(gridWidth_) * gridHeight_, {});
+
+	const size_t size = capacity > 0 ? static_cast<size_t>(capacity) : 0;
+	slotCell_.assign(size, -1);
+	slotIndexInCell_.assign(size, 0);
+	slotPosition_.assign(size, Vector2{ 0.0f, 0.0f });
+	count_ = 0;
+}
+
+int ScrapSpatialGrid::CellX(float x) const {
+	return std::clamp(static_cast<int>((x - min_.x) * invCellSize_), 0, gridWidth_ - 1);
+}
+
+int ScrapSpatialGrid::CellY(float y) const {
+	return std::clamp(static_cast<int>((y - min_.y) * invCellSize_), 0, gridHeight_ - 1);
+}
+
+void ScrapSpatialGrid::AddToCell(uint32_t slot, int cell) {
+	slotCell_[slot] = cell;
+	slotIndexInCell_[slot] = static_cast<uint32_t>(cells_[cell].size());
+	cells_[cell].push_back(slot);
+}
+
+void ScrapSpatialGrid::RemoveFromCell(uint32_t slot) {
+	// 末尾の番号を空いた位置へ入れて詰める
+	std::vector<uint32_t>& cell = cells_[slotCell_[slot]];
+	const uint32_t index = slotIndexInCell_[slot];
+	const uint32_t last = cell.back();
+	cell[index] = last;
+	slotIndexInCell_[last] = index;
+	cell.pop_back();
+	slotCell_[slot] = -1;
+}
+
+void ScrapSpatialGrid::Insert(uint32_t slot, const Vector2& position) {
+	if (slot >= slotCell_.size() || cells_.empty()) {
+		return;
+	}
+	if (slotCell_[slot] >= 0) {
+		Relocate(slot, position);
+		return;
+	}
+
+	slotPosition_[slot] = position;
+	AddToCell(slot, CellIndex(position));
+	count_++;
+}
+
+void ScrapSpatialGrid::Relocate(uint32_t slot, const Vector2& position) {
+	if (!Contains(slot)) {
+		return;
+	}
+
+	slotPosition_[slot] = position;
+	const int cell = CellIndex(position);
+	if (cell != slotCell_[slot]) {
+		RemoveFromCell(slot);
+		AddToCell(slot, cell);
+	}
+}
+
+void ScrapSpatialGrid::Erase(uint32_t slot) {
+	if (!Contains(slot)) {
+		return;
+	}
+	RemoveFromCell(slot);
+	count_--;
+}
+
+void ScrapSpatialGrid::Clear() {
+	for (auto& cell : cells_) {
+		for (uint32_t slot : cell) {
+			slotCell_[slot] = -1;
+		}
+		cell.clear();
+	}
+	count_ = 0;
+}
+
+void ScrapSpatialGrid::QueryCircle(const Vector2& center, float radius, std::vector<uint32_t>& outSlots) const {
+	if (count_ == 0 || radius < 0.0f) {
+		return;
+	}
+
+	const int x0 = CellX(center.x - radius), x1 = CellX(center.x + radius);
+	const int y0 = CellY(center.y - radius), y1 = CellY(center.y + radius);
+	const float radiusSq = radius * radius;
+
+	for (int y = y0; y <= y1; ++y) {
+		for (int x = x0; x <= x1; ++x) {
+			for (uint32_t slot : cells_[y * gridWidth_ + x]) {
+				const Vector2& p = slotPosition_[slot];
+				const float dx = p.x - center.x;
+				const float dy = p.y - center.y;
+				if (dx * dx + dy * dy <= radiusSq) {
+					outSlots.push_back(slot);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,56 @@
+﻿#pragma once
+#include "Vector2.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// スクラップのスロット番号を位置で引くための一様グリッド（範囲固定、範囲外は端のセルに入れる）
+/// 登録したまま位置を更新でき、セルが変わったときだけ入れ替える（同じセルなら位置を覚え直すだけ）。
+/// 止まっているスクラップは位置が変わらないので Relocate を呼ばなくてよい
+/// </summary>
+class ScrapSpatialGrid {
+public:
+	/// <summary>
+	/// 範囲とセルの一辺を決めて空にする
+	/// </summary>
+	/// <param name="min">範囲の最小の角</param>
+	/// <param name="max">範囲の最大の角</param>
+	/// <param name="cellSize">セルの一辺</param>
+	/// <param name="capacity">スロット番号の上限（ScrapPool の容量）</param>
+	void Initialize(const Vector2& min, const Vector2& max, float cellSize, int capacity);
+
+	void Insert(uint32_t slot, const Vector2& position);
+	// 位置を更新する（登録されていなければ何もしない）
+	void Relocate(uint32_t slot, const Vector2& position);
+	void Erase(uint32_t slot);
+	void Clear();
+
+	bool Contains(uint32_t slot) const { return slot < slotCell_.size() && slotCell_[slot] >= 0; }
+	int GetCount() const { return count_; }
+
+	/// <summary>
+	/// 覚えている位置が center から radius 以内のスロット番号を outSlots の末尾に足す
+	/// 調べるのは円にかかるセルだけ
+	/// </summary>
+	void QueryCircle(const Vector2& center, float radius, std::vector<uint32_t>& outSlots) const;
+
+private:
+	int CellX(float x) const;
+	int CellY(float y) const;
+	int CellIndex(const Vector2& position) const { return CellY(position.y) * gridWidth_ + CellX(position.x); }
+	void AddToCell(uint32_t slot, int cell);
+	void RemoveFromCell(uint32_t slot);
+
+	Vector2 min_{};
+	float cellSize_ = 1.0f;
+	float invCellSize_ = 1.0f;
+	int gridWidth_ = 0;
+	int gridHeight_ = 0;
+	int count_ = 0;
+
+	std::vector<std::vector<uint32_t>> cells_;
+	std::vector<int> slotCell_;            // スロットが入っているセル（-1 は未登録）
+	std::vector<uint32_t> slotIndexInCell_;
+	std::vector<Vector2> slotPosition_;    // 最後に登録・更新した位置
+};
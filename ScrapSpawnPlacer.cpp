@@ -0,0 +1,144 @@
+﻿#include "ScrapSpawnPlacer.h"
+#include "FastRandom.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef max
+#undef max
+#endif
+
+#ifdef min
+#undef min
+#endif
+
+void ScrapSpawnPlacer::Begin(const Vector2& center, float extent, float maxRadius, float gap, int expectedCount) {
+	gap_ = std::max(0.0f, gap);
+	entries_.clear();
+	active_.clear();
+	placedCount_ = 0;
+
+	// 重なりうる距離は「半径の和 + gap」まで。一番大きい組でも隣のセルまでに収まる大きさにする
+	const float minCellSize = std::max(1.0f, maxRadius * 2.0f + gap_);
+	// 数が多くて範囲に収まらないときは Bridson で外へ広がるので、全部を詰めたときの広さとセル数個ぶんを足しておく
+	const float packedHalfSize = std::sqrt(static_cast<float>(std::max(0, expectedCount))) * minCellSize * 0.5f;
+	const float halfSize = std::max(std::max(0.0f, extent), packedHalfSize) + minCellSize * 4.0f;
+	cellSize_ = std::max(minCellSize, halfSize * 2.0f / static_cast<float>(kMaxGridCells));
+	invCellSize_ = 1.0f / cellSize_;
+	gridMin_ = { center.x - halfSize, center.y - halfSize };
+	gridWidth_ = std::clamp(static_cast<int>(halfSize * 2.0f * invCellSize_) + 1, 1, kMaxGridCells);
+	gridHeight_ = gridWidth_;
+	cellHead_.assign(static_cast<size_t>(gridWidth_) * gridHeight_, -1);
+
+	// グリッドから1セル以上離れた障害物は、グリッド内のどの円とも重ならないので登録しない
+	ignoreMinX_ = gridMin_.x - cellSize_;
+	ignoreMinY_ = gridMin_.y - cellSize_;
+	ignoreMaxX_ = gridMin_.x + gridWidth_ * cellSize_ + cellSize_;
+	ignoreMaxY_ = gridMin_.y + gridHeight_ * cellSize_ + cellSize_;
+}
+
+int ScrapSpawnPlacer::CellX(float x) const {
+	return std::clamp(static_cast<int>((x - gridMin_.x) * invCellSize_), 0, gridWidth_ - 1);
+}
+
+int ScrapSpawnPlacer::CellY(float y) const {
+	return std::clamp(static_cast<int>((y - gridMin_.y) * invCellSize_), 0, gridHeight_ - 1);
+}
+
+void ScrapSpawnPlacer::Insert(const Vector2& position, float radius) {
+	const int cell = CellY(position.y) * gridWidth_ + CellX(position.x);
+	entries_.push_back({ position, radius, cellHead_[cell] });
+	cellHead_[cell] = static_cast<int>(entries_.size()) - 1;
+}
+
+void ScrapSpawnPlacer::AddObstacle(const Vector2& position, float radius) {
+	if (cellHead_.empty()) return;
+	if (position.x < ignoreMinX_ || position.x > ignoreMaxX_ ||
+		position.y < ignoreMinY_ || position.y > ignoreMaxY_) {
+		return;
+	}
+	Insert(position, radius);
+}
+
+bool ScrapSpawnPlacer::IsFree(const Vector2& position, float radius) const {
+	if (cellHead_.empty()) return true;
+
+	// 範囲外の点は端のセルに入っているので、端に寄せたセルの周囲を見れば取りこぼさない
+	const int cx = CellX(position.x);
+	const int cy = CellY(position.y);
+	const int x0 = std::max(cx - 1, 0), x1 = std::min(cx + 1, gridWidth_ - 1);
+	const int y0 = std::max(cy - 1, 0), y1 = std::min(cy + 1, gridHeight_ - 1);
+
+	for (int y = y0; y <= y1; ++y) {
+		for (int x = x0; x <= x1; ++x) {
+			for (int e = cellHead_[y * gridWidth_ + x]; e >= 0; e = entries_[e].next) {
+				const Entry& entry = entries_[e];
+				const float dx = position.x - entry.position.x;
+				const float dy = position.y - entry.position.y;
+				const float minDistance = radius + entry.radius + gap_;
+				if (dx * dx + dy * dy < minDistance * minDistance) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+Vector2 ScrapSpawnPlacer::Accept(const Vector2& position, float radius) {
+	Insert(position, radius);
+	active_.push_back(static_cast<int>(entries_.size()) - 1);
+	placedCount_++;
+	return position;
+}
+
+Vector2 ScrapSpawnPlacer::Place(const Vector2& desired, float radius, float searchRadius, FastRandom& random) {
+	constexpr float kTwoPi = 2.0f * 3.14159265f;
+
+	// 1. 希望の位置
+	if (IsFree(desired, radius)) {
+		return Accept(desired, radius);
+	}
+
+	// 2. 希望の位置のまわり（従来の FindNonOverlappingPosition と同じ探し方）
+	for (int attempt = 0; attempt < kCandidatesPerPoint; ++attempt) {
+		const float angle = random.RandomFloat(0.0f, kTwoPi);
+		const float distance = random.RandomFloat(0.0f, searchRadius);
+		const Vector2 candidate = { desired.x + std::cos(angle) * distance, desired.y + std::sin(angle) * distance };
+		if (IsFree(candidate, radius)) {
+			return Accept(candidate, radius);
+		}
+	}
+
+	// 3. Bridson: 置いた点のまわりの輪に候補を出し、全部だめならその点は候補の元から外す
+	while (!active_.empty()) {
+		const int activeIndex = random.RandomInt(0, static_cast<int>(active_.size()) - 1);
+		const Entry& origin = entries_[active_[activeIndex]];
+		const float innerRadius = origin.radius + radius + gap_;
+
+		for (int attempt = 0; attempt < kCandidatesPerPoint; ++attempt) {
+			const float angle = random.RandomFloat(0.0f, kTwoPi);
+			const float distance = random.RandomFloat(innerRadius, innerRadius * 2.0f);
+			const Vector2 candidate = { origin.position.x + std::cos(angle) * distance, origin.position.y + std::sin(angle) * distance };
+			if (IsFree(candidate, radius)) {
+				return Accept(candidate, radius);
+			}
+		}
+
+		active_[activeIndex] = active_.back();
+		active_.pop_back();
+	}
+
+	// 4. 渦巻き状に外へ（障害物は有限なので、いずれ空いた場所に出る）
+	const float step = std::max(1.0f, radius + gap_ * 0.5f);
+	for (int ring = 1; ; ++ring) {
+		const float distance = step * static_cast<float>(ring);
+		const int samples = std::max(6, static_cast<int>(kTwoPi * distance / step));
+		for (int i = 0; i < samples; ++i) {
+			const float angle = kTwoPi * static_cast<float>(i) / static_cast<float>(samples);
+			const Vector2 candidate = { desired.x + std::cos(angle) * distance, desired.y + std::sin(angle) * distance };
+			if (IsFree(candidate, radius)) {
+				return Accept(candidate, radius);
+			}
+		}
+	}
+}
@@ -0,0 +1,75 @@
+﻿#pragma once
+#include "Vector2.h"
+#include <cstdint>
+#include <vector>
+
+class FastRandom;
+
+/// <summary>
+/// スクラップを重ならないように置く場所を決める（半径がまちまちな Bridson 式のポアソンディスク配置）
+/// 置いた円と、先に登録した障害物（フィールドに出ているスクラップ）を一様グリッドに入れておき、
+/// 重なり判定は近くのセルだけで行う（1回の判定はほぼ定数時間なので、N 個置いてもほぼ N に比例）。
+/// 1回の生成（SpawnScrapCircle など）ごとに Begin からやり直す
+/// </summary>
+class ScrapSpawnPlacer {
+public:
+	// グリッドの1辺の最大セル数（広すぎる範囲はセルを大きくして収める）
+	static constexpr int kMaxGridCells = 128;
+	// 1つの点のまわりで試す候補の数（Bridson の k）
+	static constexpr int kCandidatesPerPoint = 30;
+
+	/// <summary>
+	/// 配置を始める（グリッドと置いた点を空にする）
+	/// </summary>
+	/// <param name="center">置く範囲の中心</param>
+	/// <param name="extent">中心から置く候補が出うる距離（これより外に置いてもよいが、判定が少し遅くなる）</param>
+	/// <param name="maxRadius">置く円・障害物の半径の最大値</param>
+	/// <param name="gap">円どうしの間に最低限空ける距離</param>
+	/// <param name="expectedCount">これから置く数（範囲に収まらないぶん Bridson で外へ広がるので、その広さもグリッドに含める）</param>
+	void Begin(const Vector2& center, float extent, float maxRadius, float gap, int expectedCount);
+
+	/// <summary>
+	/// 動かない障害物を登録する（範囲から十分離れたものは登録しない）
+	/// </summary>
+	void AddObstacle(const Vector2& position, float radius);
+
+	/// <summary>
+	/// desired の近くに、どの円とも重ならない位置を決めて登録する
+	/// 1. desired がそのまま空いていればそこ
+	/// 2. desired から searchRadius 以内をランダムに kCandidatesPerPoint 回試す
+	/// 3. だめなら、これまでに置いた点のまわりの輪（半径の和〜その2倍）に候補を出す Bridson の手順で探す
+	/// 4. それでも置けなければ desired から外側へ渦巻き状に探す（必ずどこかで空きが見つかる）
+	/// </summary>
+	Vector2 Place(const Vector2& desired, float radius, float searchRadius, FastRandom& random);
+
+	// 位置が空いているか（gap も含めて重ならないか）
+	bool IsFree(const Vector2& position, float radius) const;
+
+	int GetPlacedCount() const { return placedCount_; }
+	int GetObstacleCount() const { return static_cast<int>(entries_.size()) - placedCount_; }
+
+private:
+	struct Entry {
+		Vector2 position;
+		float radius;
+		int next;   // 同じセルの次の要素（-1 で終わり）
+	};
+
+	int CellX(float x) const;
+	int CellY(float y) const;
+	void Insert(const Vector2& position, float radius);
+	Vector2 Accept(const Vector2& position, float radius);
+
+	float gap_ = 0.0f;
+	float cellSize_ = 1.0f;
+	float invCellSize_ = 1.0f;
+	Vector2 gridMin_{};
+	int gridWidth_ = 0;
+	int gridHeight_ = 0;
+	float ignoreMinX_ = 0.0f, ignoreMinY_ = 0.0f, ignoreMaxX_ = 0.0f, ignoreMaxY_ = 0.0f;
+
+	std::vector<int> cellHead_;         // セルごとの先頭の要素（-1 で空）
+	std::vector<Entry> entries_;        // 障害物と置いた円
+	std::vector<int> active_;           // Bridson の候補を出す元になる、置いた円の番号
+	int placedCount_ = 0;
+};
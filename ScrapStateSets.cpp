@@ -0,0 +1,86 @@
+﻿#include "ScrapStateSets.h"
+#include "Scrap.h"
+
+int ScrapStateSets::ToSetIndex(ScrapState state) {
+	switch (state) {
+	case ScrapState::Free:        return 0;
+	case ScrapState::BeingSucked: return 1;
+	case ScrapState::Held:        return 2;
+	case ScrapState::Fired:       return 3;
+	case ScrapState::Hit:         return 4;
+	default:                      return -1;
+	}
+}
+
+void ScrapStateSets::Resize(int capacity) {
+	const size_t size = capacity > 0 ? static_cast<size_t>(capacity) : 0;
+	for (auto& set : sets_) {
+		set.clear();
+		set.reserve(size);
+	}
+	slotSet_.assign(size, -1);
+	slotPosition_.assign(size, 0);
+}
+
+void ScrapStateSets::Insert(uint32_t slot, ScrapState state) {
+	const int setIndex = ToSetIndex(state);
+	if (slot >= slotSet_.size() || slotSet_[slot] >= 0 || setIndex < 0) {
+		return;
+	}
+	InsertToSet(slot, setIndex);
+}
+
+void ScrapStateSets::InsertToSet(uint32_t slot, int setIndex) {
+	slotSet_[slot] = static_cast<int8_t>(setIndex);
+	slotPosition_[slot] = static_cast<uint32_t>(sets_[setIndex].size());
+	sets_[setIndex].push_back(slot);
+}
+
+void ScrapStateSets::SetSleeping(uint32_t slot, bool sleeping) {
+	const int freeSet = ToSetIndex(ScrapState::Free);
+	const int from = sleeping ? freeSet : kSleepingSet;
+	if (slot >= slotSet_.size() || slotSet_[slot] != from) {
+		return;
+	}
+	Erase(slot);
+	InsertToSet(slot, sleeping ? kSleepingSet : freeSet);
+}
+
+void ScrapStateSets::Move(uint32_t slot, ScrapState state) {
+	if (slot < slotSet_.size() && slotSet_[slot] == ToSetIndex(state)) {
+		return;
+	}
+	Erase(slot);
+	Insert(slot, state);
+}
+
+void ScrapStateSets::Erase(uint32_t slot) {
+	if (slot >= slotSet_.size() || slotSet_[slot] < 0) {
+		return;
+	}
+
+	// 末尾の番号を空いた位置へ入れて詰める
+	std::vector<uint32_t>& set = sets_[slotSet_[slot]];
+	const uint32_t position = slotPosition_[slot];
+	const uint32_t last = set.back();
+	set[position] = last;
+	slotPosition_[last] = position;
+	set.pop_back();
+
+	slotSet_[slot] = -1;
+}
+
+void ScrapStateSets::Clear() {
+	for (auto& set : sets_) {
+		for (uint32_t slot : set) {
+			slotSet_[slot] = -1;
+		}
+		set.clear();
+	}
+}
+
+const std::vector<uint32_t>& ScrapStateSets::Get(ScrapState state) const {
+	static const std::vector<uint32_t> kEmpty;
+	const int setIndex = ToSetIndex(state);
+	return setIndex >= 0 ? sets_[setIndex] : kEmpty;
+}
@@ -0,0 +1,51 @@
+﻿#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class ScrapState;
+
+/// <summary>
+/// スクラップのスロット番号を状態ごとに分けて持つ集合（Free / BeingSucked / Held / Fired / Hit）
+/// Free のうち眠っているものは別の集合に分けて持つ（Get(Free) は起きているものだけ）。
+/// 追加・削除・移動はどれも O(1)（削除は末尾と入れ替えるので、集合の中の並びは保証しない）。
+/// 状態を変えるときは ScrapManager がこれと Scrap の両方を同時に書き換える
+/// </summary>
+class ScrapStateSets {
+public:
+	static constexpr int kSetCount = 6;  // 5つの状態 + 眠っている Free
+
+	void Resize(int capacity);
+
+	// slot を state の集合に入れる（Idle ならどこにも入れない）
+	void Insert(uint32_t slot, ScrapState state);
+	// slot を今の集合から state の集合へ移す
+	void Move(uint32_t slot, ScrapState state);
+	// Free の slot を眠っている集合へ・起きている集合へ移す（Free 以外なら何もしない）
+	void SetSleeping(uint32_t slot, bool sleeping);
+	// slot をどの集合からも外す
+	void Erase(uint32_t slot);
+	void Clear();
+
+	/// <summary>
+	/// state の集合のスロット番号
+	/// 回しながら Move / Erase するときは末尾から回すこと（外した場所には末尾の番号が入る）
+	/// </summary>
+	const std::vector<uint32_t>& Get(ScrapState state) const;
+	int GetCount(ScrapState state) const { return static_cast<int>(Get(state).size()); }
+
+	// 眠っている Free のスロット番号
+	const std::vector<uint32_t>& GetSleeping() const { return sets_[kSleepingSet]; }
+	int GetSleepingCount() const { return static_cast<int>(sets_[kSleepingSet].size()); }
+
+private:
+	static constexpr int kSleepingSet = 5;
+
+	static int ToSetIndex(ScrapState state);
+	void InsertToSet(uint32_t slot, int setIndex);
+
+	std::array<std::vector<uint32_t>, kSetCount> sets_;
+	std::vector<int8_t> slotSet_;          // スロットが入っている集合（-1 はどこにもない）
+	std::vector<uint32_t> slotPosition_;   // 集合の中での位置
+};
@@ -0,0 +1,109 @@
+﻿#include "SpriteSheet.h"
+#include <Novice.h>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+#ifdef min
+#undef min
+#endif
+
+#ifdef max
+#undef max
+#endif
+
+namespace {
+
+struct SheetKey {
+	int textureHandle;
+	int frameWidth;
+	int frameHeight;
+	int divX;
+	int divY;
+
+	bool operator==(const SheetKey& other) const {
+		return textureHandle == other.textureHandle && frameWidth == other.frameWidth &&
+			frameHeight == other.frameHeight && divX == other.divX && divY == other.divY;
+	}
+};
+
+struct SheetKeyHash {
+	size_t operator()(const SheetKey& k) const {
+		size_t h = static_cast<size_t>(static_cast<unsigned int>(k.textureHandle));
+		h = h * 31 + static_cast<size_t>(k.frameWidth);
+		h = h * 31 + static_cast<size_t>(k.frameHeight);
+		h = h * 31 + static_cast<size_t>(k.divX);
+		h = h * 31 + static_cast<size_t>(k.divY);
+		return h;
+	}
+};
+
+// 作ったシートは unique_ptr で持ち、要素が増えてもポインタが変わらないようにする
+std::unordered_map<SheetKey, std::unique_ptr<SpriteSheet>, SheetKeyHash>& Sheets() {
+	static std::unordered_map<SheetKey, std::unique_ptr<SpriteSheet>, SheetKeyHash> sheets;
+	return sheets;
+}
+
+// (テクスチャ, divX, divY) → シート（テクスチャサイズの問い合わせを2回目以降省く）
+std::unordered_map<SheetKey, const SpriteSheet*, SheetKeyHash>& DivLookup() {
+	static std::unordered_map<SheetKey, const SpriteSheet*, SheetKeyHash> lookup;
+	return lookup;
+}
+
+} // namespace
+
+SpriteSheet::SpriteSheet(int textureHandle, int frameWidth, int frameHeight, int divX, int divY)
+	: textureHandle_(textureHandle)
+	, divX_(std::max(1, divX))
+	, divY_(std::max(1, divY))
+	, frameWidth_(std::max(0, frameWidth))
+	, frameHeight_(std::max(0, frameHeight)) {
+
+	frameCount_ = divX_ * divY_;
+	frames_.resize(frameCount_);
+	for (int i = 0; i < frameCount_; ++i) {
+		SpriteFrameRect& r = frames_[i];
+		r.x = (i % divX_) * frameWidth_;
+		r.y = (i / divX_) * frameHeight_;
+		r.w = frameWidth_;
+		r.h = frameHeight_;
+	}
+}
+
+const SpriteSheet* SpriteSheet::GetWithFrameSize(int textureHandle, int frameWidth, int frameHeight, int divX, int divY) {
+	const SheetKey key{ textureHandle, std::max(0, frameWidth), std::max(0, frameHeight), std::max(1, divX), std::max(1, divY) };
+
+	auto& sheets = Sheets();
+	auto it = sheets.find(key);
+	if (it == sheets.end()) {
+		it = sheets.emplace(key, std::make_unique<SpriteSheet>(
+			key.textureHandle, key.frameWidth, key.frameHeight, key.divX, key.divY)).first;
+	}
+	return it->second.get();
+}
+
+const SpriteSheet* SpriteSheet::Get(int textureHandle, int divX, int divY) {
+	divX = std::max(1, divX);
+	divY = std::max(1, divY);
+
+	const SheetKey divKey{ textureHandle, 0, 0, divX, divY };
+	auto& lookup = DivLookup();
+	auto it = lookup.find(divKey);
+	if (it != lookup.end()) {
+		return it->second;
+	}
+
+	int texWidth = 0;
+	int texHeight = 0;
+	if (textureHandle >= 0) {
+		Novice::GetTextureSize(textureHandle, &texWidth, &texHeight);
+	}
+
+	const SpriteSheet* sheet = GetWithFrameSize(textureHandle, texWidth / divX, texHeight / divY, divX, divY);
+	lookup.emplace(divKey, sheet);
+	return sheet;
+}
+
+int SpriteSheet::GetSheetCount() {
+	return static_cast<int>(Sheets().size());
+}
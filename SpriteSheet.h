@@ -0,0 +1,67 @@
+﻿#pragma once
+#include <vector>
+
+/// <summary>
+/// スプライトシートの1フレーム分のソース矩形（ピクセル）
+/// </summary>
+struct SpriteFrameRect {
+	int x = 0;
+	int y = 0;
+	int w = 0;
+	int h = 0;
+};
+
+/// <summary>
+/// テクスチャを divX × divY に分割したスプライトシートの共有データ
+/// 全フレームのソース矩形を生成時に1回だけ計算しておき、描画側は番号で引くだけにする。
+/// (テクスチャ, divX, divY) ごとに1つだけ作って使い回す（Get で取得）。
+/// パーティクル（ParticleStorage::AnimState）と Animation の両方がこれを参照する。
+/// 一度作ったものは解放しない（生きているパーティクルがポインタを持っているため）
+/// </summary>
+class SpriteSheet {
+public:
+	/// <summary>
+	/// (テクスチャ, divX, divY) のシートを取得する（無ければ作る）
+	/// 1フレームのサイズはテクスチャサイズ / 分割数
+	/// </summary>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	/// <param name="divX">横分割数（1未満は1として扱う）</param>
+	/// <param name="divY">縦分割数（1未満は1として扱う）</param>
+	static const SpriteSheet* Get(int textureHandle, int divX, int divY);
+
+	/// <summary>
+	/// 1フレームのサイズを指定してシートを取得する（Animation 用）
+	/// テクスチャから割り出したサイズと同じなら Get(textureHandle, divX, divY) と同じものを返す
+	/// </summary>
+	static const SpriteSheet* GetWithFrameSize(int textureHandle, int frameWidth, int frameHeight, int divX, int divY);
+
+	// 作成済みのシートの数（デバッグ表示用）
+	static int GetSheetCount();
+
+	// フレーム番号からソース矩形を引く（範囲外は端のフレームに丸める）
+	const SpriteFrameRect& GetFrame(int index) const {
+		if (index < 0) index = 0;
+		if (index >= frameCount_) index = frameCount_ - 1;
+		return frames_[index];
+	}
+
+	int GetTextureHandle() const { return textureHandle_; }
+	int GetDivX() const { return divX_; }
+	int GetDivY() const { return divY_; }
+	int GetFrameCount() const { return frameCount_; }
+	int GetFrameWidth() const { return frameWidth_; }
+	int GetFrameHeight() const { return frameHeight_; }
+
+	SpriteSheet(int textureHandle, int frameWidth, int frameHeight, int divX, int divY);
+	SpriteSheet(const SpriteSheet&) = delete;
+	SpriteSheet& operator=(const SpriteSheet&) = delete;
+
+private:
+	int textureHandle_ = -1;
+	int divX_ = 1;
+	int divY_ = 1;
+	int frameCount_ = 1;
+	int frameWidth_ = 0;
+	int frameHeight_ = 0;
+	std::vector<SpriteFrameRect> frames_;  // 左上から行優先で divX * divY 個
+};